@@ -0,0 +1,78 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+Arena::Arena(Arena&& other) noexcept
+    : blocks(move(other.blocks)), cur(other.cur), end(other.end), reserved(other.reserved),
+      lastBlock(other.lastBlock) {
+  other.blocks.clear();
+  other.cur = other.end = nullptr;
+  other.reserved = other.lastBlock = 0;
+}
+
+Arena& Arena::operator=(Arena&& other) noexcept {
+  if (this != &other) {
+    release();
+    blocks = move(other.blocks);
+    cur = other.cur;
+    end = other.end;
+    reserved = other.reserved;
+    lastBlock = other.lastBlock;
+    other.blocks.clear();
+    other.cur = other.end = nullptr;
+    other.reserved = other.lastBlock = 0;
+  }
+  return *this;
+}
+
+// ======================================================================================================================= //
+
+void Arena::newBlock(size_t bytes) {
+  blocks.emplace_back(new char[bytes]);
+  cur = blocks.back().get();
+  end = cur + bytes;
+  reserved += bytes;
+  lastBlock = bytes;
+}
+
+// ======================================================================================================================= //
+
+void Arena::reserve(size_t bytes) {
+  if (bytes > 0 && static_cast<size_t>(end - cur) < bytes) {
+    newBlock(bytes);
+  }
+}
+
+// ======================================================================================================================= //
+
+void* Arena::allocate(size_t bytes, size_t align) {
+  uintptr_t p = (reinterpret_cast<uintptr_t>(cur) + align - 1) & ~(uintptr_t(align) - 1);
+  if (!cur || p + bytes > reinterpret_cast<uintptr_t>(end)) {
+    // Blocos crescem geometricamente quando a reserva inicial não bastou
+    newBlock(max({bytes + align, lastBlock * 2, MIN_BLOCK}));
+    p = (reinterpret_cast<uintptr_t>(cur) + align - 1) & ~(uintptr_t(align) - 1);
+  }
+  cur = reinterpret_cast<char*>(p + bytes);
+  return reinterpret_cast<void*>(p);
+}
+
+// ======================================================================================================================= //
+
+void Arena::release() {
+  blocks.clear();
+  cur = end = nullptr;
+  reserved = lastBlock = 0;
+}
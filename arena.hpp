@@ -0,0 +1,85 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// ---------- Classe Arena ----------
+// Alocador monotônico: os objetos são recortados em sequência de blocos
+// grandes e nunca liberados um a um; release (ou o destrutor) devolve todos
+// os blocos de uma vez. Com reserve feito a partir das contagens da entrada,
+// uma construção inteira cabe num único bloco.
+class Arena {
+public:
+  Arena() = default;
+  ~Arena() { release(); }
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+  Arena(Arena&& other) noexcept;
+  Arena& operator=(Arena&& other) noexcept;
+
+  /**
+   * Garante um bloco com pelo menos bytes livres contíguos
+   * @param bytes Espaço necessário
+   */
+  void reserve(size_t bytes);
+
+  /**
+   * Recorta um trecho alinhado do bloco corrente (abre outro se não couber)
+   * @param bytes Tamanho do trecho
+   * @param align Alinhamento (potência de 2)
+   * @return Ponteiro para memória não inicializada
+   */
+  void* allocate(size_t bytes, size_t align);
+
+  /**
+   * Constrói um objeto na arena; como não há destruição individual,
+   * só tipos com destrutor trivial são aceitos
+   */
+  template <class T, class... Args>
+  T* create(Args&&... args) {
+    static_assert(is_trivially_destructible<T>::value, "a arena não chama destrutores");
+    return new (allocate(sizeof(T), alignof(T))) T(forward<Args>(args)...);
+  }
+
+  /**
+   * Libera todos os blocos de uma vez
+   */
+  void release();
+
+  /**
+   * Bytes reservados em blocos (usados ou não)
+   */
+  size_t capacity() const { return reserved; }
+
+private:
+  // Tamanho mínimo de um bloco aberto sem reserve
+  static constexpr size_t MIN_BLOCK = 64 << 10;
+
+  vector<unique_ptr<char[]>> blocks;
+  char* cur = nullptr;
+  char* end = nullptr;
+  size_t reserved = 0;
+  size_t lastBlock = 0;
+
+  void newBlock(size_t bytes);
+};
+
+#endif // ARENA_HPP
@@ -0,0 +1,302 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "batch.hpp"
+#include "dcel.hpp"
+#include "dcel_soa.hpp"
+#include "mesh_io.hpp"
+#include "output_writer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
+#include <dirent.h>
+#include <fcntl.h>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace std;
+
+// Buffer de formatação de cada malha (as malhas do lote costumam ser pequenas)
+static const size_t ITEM_BUFFER = 1 << 16;
+
+// Uma malha no pipeline: lida pela leitora, processada por um worker, escrita em ordem
+struct BatchItem {
+  size_t seq = 0;
+  string name;       // cabeçalho no fluxo delimitado e nome do .out
+  string readError;  // a malha não pôde ser lida e não é processada
+  Mesh mesh;
+  string output;     // saída completa, como no modo de uma malha
+  string error;      // exceção na validação ou na construção da DCEL
+  bool valid = false;
+};
+
+// ---------- Classe BatchPipeline ----------
+// Filas entre os três estágios. A leitora bloqueia quando há `window` malhas
+// em voo (na fila, em processamento ou à espera da escrita); as prontas fora
+// de ordem esperam num mapa até que as anteriores sejam escritas.
+class BatchPipeline {
+public:
+  explicit BatchPipeline(size_t window) : window(max<size_t>(window, 1)) {}
+
+  void push(unique_ptr<BatchItem> item) {
+    unique_lock<mutex> lock(m);
+    spaceFree.wait(lock, [&] { return inFlight < window; });
+    item->seq = total++;
+    inFlight++;
+    pending.push_back(move(item));
+    workReady.notify_one();
+  }
+
+  // Fim da leitura: workers e escritora terminam quando esvaziarem as filas
+  void closeInput() {
+    lock_guard<mutex> lock(m);
+    inputClosed = true;
+    workReady.notify_all();
+    doneReady.notify_all();
+  }
+
+  // Próxima malha a processar; nulo quando a leitura acabou e a fila esvaziou
+  unique_ptr<BatchItem> nextToProcess() {
+    unique_lock<mutex> lock(m);
+    workReady.wait(lock, [&] { return !pending.empty() || inputClosed; });
+    if (pending.empty()) return nullptr;
+    unique_ptr<BatchItem> item = move(pending.front());
+    pending.pop_front();
+    return item;
+  }
+
+  void finished(unique_ptr<BatchItem> item) {
+    lock_guard<mutex> lock(m);
+    bool next = item->seq == nextSeq;
+    done.emplace(item->seq, move(item));
+    if (next) doneReady.notify_one();
+  }
+
+  // Próxima malha na ordem de leitura; nulo quando todas foram escritas
+  unique_ptr<BatchItem> nextToWrite() {
+    unique_lock<mutex> lock(m);
+    doneReady.wait(lock, [&] { return done.count(nextSeq) || (inputClosed && nextSeq == total); });
+    auto it = done.find(nextSeq);
+    if (it == done.end()) return nullptr;
+    unique_ptr<BatchItem> item = move(it->second);
+    done.erase(it);
+    nextSeq++;
+    inFlight--;
+    spaceFree.notify_one();
+    return item;
+  }
+
+private:
+  mutex m;
+  condition_variable spaceFree, workReady, doneReady;
+  deque<unique_ptr<BatchItem>> pending;
+  map<size_t, unique_ptr<BatchItem>> done;
+  size_t window;
+  size_t inFlight = 0, total = 0, nextSeq = 0;
+  bool inputClosed = false;
+};
+
+// ======================================================================================================================= //
+
+// Nome da malha: o do arquivo, sem diretório nem extensão .in
+static string meshName(const string &path) {
+  string name = path.substr(path.find_last_of('/') + 1);
+  if (name.size() > 3 && name.compare(name.size() - 3, 3, ".in") == 0) {
+    name.resize(name.size() - 3);
+  }
+  return name;
+}
+
+// Expande a entrada: um diretório vira os seus *.in em ordem de nome
+static vector<string> expandInput(const string &path) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) return {path};
+
+  vector<string> files;
+  if (DIR *dir = opendir(path.c_str())) {
+    while (dirent *entry = readdir(dir)) {
+      string name = entry->d_name;
+      if (name.size() > 3 && name.compare(name.size() - 3, 3, ".in") == 0) {
+        files.push_back(path + "/" + name);
+      }
+    }
+    closedir(dir);
+  }
+  sort(files.begin(), files.end());
+  return files;
+}
+
+// Índices das faces dentro de [0, n): num fluxo concatenado, uma malha com
+// linhas a mais ou a menos desalinha as seguintes, que não podem ser validadas
+static bool indicesInRange(const Mesh &mesh) {
+  int n = static_cast<int>(mesh.vertices.size());
+  return all_of(mesh.faces.indices.begin(), mesh.faces.indices.end(), [n](int v) { return v >= 0 && v < n; });
+}
+
+// ======================================================================================================================= //
+
+// Estágio 1: lê as malhas na ordem das entradas
+static void readInputs(const vector<string> &inputs, BatchPipeline &pipeline) {
+  for (const string &input : inputs) {
+    if (input == "-") {
+      // Malhas concatenadas na entrada padrão, numeradas a partir de 1
+      InputScanner in(STDIN_FILENO);
+      for (size_t k = 1; in.skipWhitespace(); k++) {
+        auto item = make_unique<BatchItem>();
+        item->name = "stdin." + to_string(k);
+        if (!readMesh(in, item->mesh)) {
+          item->readError = "cabeçalho inválido; o restante da entrada padrão foi ignorado";
+          pipeline.push(move(item));
+          break;
+        }
+        if (!indicesInRange(item->mesh)) item->readError = "índice de vértice fora do intervalo";
+        pipeline.push(move(item));
+      }
+      continue;
+    }
+
+    for (const string &path : expandInput(input)) {
+      auto item = make_unique<BatchItem>();
+      item->name = meshName(path);
+      int fd = open(path.c_str(), O_RDONLY);
+      if (fd < 0) {
+        item->readError = "não foi possível abrir " + path;
+      } else {
+        InputScanner in(fd);
+        readMesh(in, item->mesh);
+        close(fd);
+        if (!indicesInRange(item->mesh)) item->readError = "índice de vértice fora do intervalo";
+      }
+      pipeline.push(move(item));
+    }
+  }
+  pipeline.closeInput();
+}
+
+// ======================================================================================================================= //
+
+// Estágio 2: valida e formata a saída em memória (uma thread por malha)
+static void processItem(BatchItem &item) {
+  OutputWriter out(&item.output, ITEM_BUFFER);
+  try {
+    string errorMessage;
+    if (!checkMesh(item.mesh.vertices, item.mesh.faces, errorMessage)) {
+      out.append(errorMessage);
+      out.put('\n');
+    } else {
+      selectCompactDCEL(item.mesh.vertices, item.mesh.faces, [&](const auto &dcel) { dcel.printDCELOutput(out); });
+      item.valid = true;
+    }
+  } catch (const exception &e) {
+    // Faces degeneradas na validação ou falha na construção: sem saída, como no modo de uma malha
+    item.error = e.what();
+  }
+  out.flush();
+  if (!item.error.empty()) item.output.clear();
+  // A malha não é mais necessária enquanto a saída espera a vez de ser escrita
+  item.mesh = Mesh();
+}
+
+static void processItems(BatchPipeline &pipeline) {
+  while (unique_ptr<BatchItem> item = pipeline.nextToProcess()) {
+    if (item->readError.empty()) processItem(*item);
+    pipeline.finished(move(item));
+  }
+}
+
+// ======================================================================================================================= //
+
+// Grava a saída de uma malha em dir/nome.out
+static bool writeOutputFile(const string &path, const string &text) {
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) return false;
+  bool ok = true;
+  try {
+    OutputWriter out(fd, ITEM_BUFFER);
+    out.append(text);
+    out.flush();
+  } catch (const exception &) {
+    ok = false;
+  }
+  return close(fd) == 0 && ok;
+}
+
+// ======================================================================================================================= //
+
+size_t runBatch(const vector<string> &inputs, const BatchOptions &options) {
+  unsigned threads = max(1u, options.threads);
+  BatchPipeline pipeline(options.window ? options.window : 4 * threads);
+
+  if (!options.outDir.empty() && mkdir(options.outDir.c_str(), 0755) != 0 && errno != EEXIST) {
+    cerr << "Não foi possível criar " << options.outDir << endl;
+    return 1;
+  }
+
+  thread reader(readInputs, cref(inputs), ref(pipeline));
+  vector<thread> workers;
+  for (unsigned t = 0; t < threads; t++) {
+    workers.emplace_back(processItems, ref(pipeline));
+  }
+
+  // Estágio 3, nesta thread: escreve na ordem de leitura. Se o fluxo de saída
+  // falhar, as malhas restantes ainda são consumidas para que a leitora e os
+  // workers terminem.
+  size_t failures = 0;
+  unique_ptr<OutputWriter> stream;
+  bool streamFailed = false;
+  if (options.outDir.empty()) stream = make_unique<OutputWriter>(STDOUT_FILENO);
+
+  while (unique_ptr<BatchItem> item = pipeline.nextToWrite()) {
+    if (!item->readError.empty()) {
+      cerr << item->name << ": " << item->readError << endl;
+      failures++;
+      continue;
+    }
+    if (!item->error.empty()) {
+      cerr << item->name << ": Erro ao processar a malha: " << item->error << endl;
+    }
+    failures += !item->valid;
+
+    if (!stream) {
+      if (!writeOutputFile(options.outDir + "/" + item->name + ".out", item->output)) {
+        cerr << item->name << ": não foi possível escrever a saída em " << options.outDir << endl;
+        failures++;
+      }
+    } else if (!streamFailed) {
+      try {
+        stream->append("==> " + item->name + " <==\n");
+        stream->append(item->output);
+      } catch (const exception &e) {
+        cerr << "Erro na saída do lote: " << e.what() << endl;
+        streamFailed = true;
+      }
+    }
+  }
+  if (stream && !streamFailed) {
+    try {
+      stream->flush();
+    } catch (const exception &e) {
+      cerr << "Erro na saída do lote: " << e.what() << endl;
+      streamFailed = true;
+    }
+  }
+  failures += streamFailed;
+
+  reader.join();
+  for (thread &worker : workers) worker.join();
+  return failures;
+}
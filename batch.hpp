@@ -0,0 +1,48 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Processamento em lote (--batch): muitas malhas num único processo, sem o
+// custo de iniciar um ./malha por arquivo. Um pipeline limitado em três
+// estágios:
+//  - uma thread leitora percorre as entradas e lê as malhas;
+//  - workers validam cada malha e montam a saída (DCEL ou mensagem de erro)
+//    em memória, uma malha por worker por vez;
+//  - a thread principal escreve as saídas na ordem de leitura.
+// No máximo `window` malhas ficam em voo entre a leitura e a escrita, o que
+// limita a memória mesmo com milhões de entradas.
+
+struct BatchOptions {
+  unsigned threads = 1; // workers de validação
+  string outDir;        // um .out por malha neste diretório; vazio = fluxo delimitado no stdout
+  size_t window = 0;    // malhas em voo (0 = 4 por worker)
+};
+
+/**
+ * Valida e constrói a DCEL de todas as malhas das entradas
+ * Cada entrada é um arquivo .in (uma malha), um diretório (todos os *.in dele,
+ * em ordem de nome) ou "-" (entrada padrão com malhas concatenadas). A saída
+ * de cada malha é a mesma do modo de uma malha; no fluxo delimitado, cada uma
+ * é precedida pela linha "==> nome <==".
+ * @param inputs Entradas, na ordem em que as saídas devem sair
+ * @param options Threads, destino e janela do pipeline
+ * @return Número de malhas inválidas ou que não puderam ser lidas ou escritas
+ */
+size_t runBatch(const vector<string> &inputs, const BatchOptions &options);
+
+#endif // BATCH_HPP
@@ -0,0 +1,116 @@
+/***********************************************************************
+ *
+ * Comparação de memória e tempo entre a DCEL de ponteiros (DCEL) e a
+ * DCEL compacta em SoA (CompactDCEL), sobre malhas em grade sintéticas,
+ * em várias instanciações de coordenada e índice.
+ *
+ * Uso: ./bench_layout [lado_max]
+ *
+ ************************************************************************/
+#include "../dcel.hpp"
+#include "../dcel_soa.hpp"
+#include "mesh_generators.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+using namespace std;
+
+// Contabiliza bytes alocados no heap para medir a DCEL de ponteiros
+static size_t liveBytes = 0;
+
+void* operator new(size_t size) {
+  void* p = malloc(size);
+  if (!p) throw bad_alloc();
+  liveBytes += malloc_usable_size(p);
+  return p;
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) noexcept {
+  if (!ptr) return;
+  liveBytes -= malloc_usable_size(ptr);
+  free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+
+static double secondsSince(chrono::steady_clock::time_point t0) {
+  return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+// Constrói a DCEL de ponteiros da instanciação D e percorre as faces
+template <class D>
+static void measurePointers(const Mesh& mesh, const char* layout) {
+  size_t before = liveBytes;
+  auto t0 = chrono::steady_clock::now();
+  auto* dcel = new D();
+  dcel->buildFromMesh(mesh.vertices, mesh.faces);
+  double build = secondsSince(t0);
+  size_t bytes = liveBytes - before;
+
+  t0 = chrono::steady_clock::now();
+  long long sum = 0;
+  for (const auto& f : dcel->faces) {
+    auto he = f->outerComponent;
+    do {
+      sum += static_cast<long long>(he->twin->origin->x);
+      he = he->next;
+    } while (he != f->outerComponent);
+  }
+  double walk = secondsSince(t0);
+  size_t nh = dcel->halfEdges.size();
+  printf("%10zu %16s %14zu %14.1f %12.4f %12.4f %12.1f %12.1f  (%lld)\n", nh, layout, bytes,
+         double(bytes) / nh, build, walk, nh / build / 1e6, nh / walk / 1e6, sum);
+  delete dcel;
+}
+
+// Mesmo para a DCEL compacta da instanciação D
+template <class D>
+static void measureCompact(const Mesh& mesh, const char* layout) {
+  size_t before = liveBytes;
+  auto t0 = chrono::steady_clock::now();
+  auto* dcel = new D();
+  dcel->buildFromMesh(mesh.vertices, mesh.faces);
+  double build = secondsSince(t0);
+  size_t bytes = liveBytes - before;
+
+  t0 = chrono::steady_clock::now();
+  long long sum = 0;
+  for (size_t f = 0; f < dcel->numFaces(); f++) {
+    typename D::index_t start = dcel->faceEdge[f], he = start;
+    do {
+      sum += static_cast<long long>(dcel->vx[dcel->origin[dcel->twin[he]]]);
+      he = dcel->next[he];
+    } while (he != start);
+  }
+  double walk = secondsSince(t0);
+  size_t nh = dcel->numHalfEdges();
+  printf("%10zu %16s %14zu %14.1f %12.4f %12.4f %12.1f %12.1f  (%lld)\n", nh, layout, bytes,
+         double(bytes) / nh, build, walk, nh / build / 1e6, nh / walk / 1e6, sum);
+  delete dcel;
+}
+
+int main(int argc, char* argv[]) {
+  int maxSide = argc > 1 ? atoi(argv[1]) : 640;
+
+  printf("%10s %16s %14s %14s %12s %12s %12s %12s\n", "semi-arest", "layout", "bytes", "bytes/semi",
+         "build(s)", "walk(s)", "Mhe/s build", "Mhe/s walk");
+
+  for (int side = 10; side <= maxSide; side *= 2) {
+    Mesh mesh;
+    gridMesh(side, mesh);
+
+    // DCEL de ponteiros: geral (double, size_t) e a mais estreita (int32, uint32)
+    measurePointers<DCEL>(mesh, "ponteiros");
+    measurePointers<BasicDCEL<int32_t, uint32_t>>(mesh, "ponteiros-i32");
+
+    // DCEL compacta: índices de 32 e de 64 bits, coordenadas inteiras e double
+    measureCompact<CompactDCEL>(mesh, "soa");
+    measureCompact<WideCompactDCEL>(mesh, "soa-idx64");
+    measureCompact<BasicCompactDCEL<double, uint64_t>>(mesh, "soa-f64-idx64");
+  }
+  return 0;
+}
@@ -0,0 +1,275 @@
+/***********************************************************************
+ *
+ * Benchmark das fases do programa sobre malhas sintéticas grandes:
+ * leitura, ValidateEdges, isOverlapping, checkInside, buildFromMesh e
+ * printDCELOutput, de 10³ até 10⁷ arestas (potências de 10).
+ *
+ * Uso: ./bench_mesh [--min-edges N] [--max-edges N] [--cap s] [--only gerador]
+ *
+ * Imprime JSON em stdout: tempo e vazão (arestas/s) de cada fase por tamanho
+ * e o expoente de escala de cada fase (inclinação de log t x log arestas).
+ * Fases curtas são repetidas até somar MIN_TIMED_SECONDS e o tempo é a média,
+ * para que também tenham expoente.
+ * Uma fase cujo tempo projetado para o próximo tamanho passa de --cap
+ * segundos deixa de ser executada nos tamanhos maiores (fica null), para
+ * que os caminhos quadráticos não travem o resto.
+ *
+ ************************************************************************/
+#include "../dcel.hpp"
+#include "../mesh_io.hpp"
+#include "../output_writer.hpp"
+#include "mesh_generators.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <map>
+#include <unistd.h>
+
+using namespace std;
+
+static const char *PHASES[] = {"parse", "validate_edges", "is_overlapping", "check_inside", "build_from_mesh",
+                               "print_dcel_output"};
+static const int NUM_PHASES = 6;
+
+struct Generator {
+  const char *name;
+  bool valid;
+  double edgesPerSide2; // arestas ≈ fator · lado²
+  void (*make)(int side, Mesh &mesh);
+};
+
+static const Generator GENERATORS[] = {
+    {"grid", true, 2.0, [](int side, Mesh &m) { gridMesh(side, m); }},
+    {"random_subdivision", true, 2.67, [](int side, Mesh &m) { randomSubdivisionMesh(side, 42, m); }},
+    {"long_boundary", true, 2.0, [](int side, Mesh &m) { longBoundaryMesh(side, m); }},
+    {"invalid_crossing", false, 2.67, [](int side, Mesh &m) { crossingMesh(side, 42, m); }},
+    {"invalid_open", false, 2.0, [](int side, Mesh &m) { openMesh(side, m); }},
+};
+
+// Medição de uma fase em um tamanho
+struct Sample {
+  double edges, seconds;
+};
+
+static const double MIN_TIMED_SECONDS = 0.02;
+
+static double secondsSince(chrono::steady_clock::time_point t0) {
+  return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+// Repete fn (que devolve o tempo de uma execução) até somar MIN_TIMED_SECONDS;
+// devolve o tempo médio por execução
+template <class Fn>
+static double averageSeconds(Fn fn) {
+  double total = 0;
+  long runs = 0;
+  do {
+    total += fn();
+    runs++;
+  } while (total < MIN_TIMED_SECONDS && runs < 1000000);
+  return total / runs;
+}
+
+// Inclinação por mínimos quadrados de log t x log arestas
+static bool scalingExponent(const vector<Sample> &samples, double &slope) {
+  double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+  for (const Sample &s : samples) {
+    if (s.seconds <= 0) continue;
+    double x = log(s.edges), y = log(s.seconds);
+    n++;
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    sxy += x * y;
+  }
+  if (n < 2 || n * sxx - sx * sx <= 0) return false;
+  slope = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+  return true;
+}
+
+// Tempo projetado da fase no próximo tamanho (pelo menos linear)
+static double projectedSeconds(const vector<Sample> &samples, double edges) {
+  if (samples.empty()) return 0;
+  double slope = 1;
+  scalingExponent(samples, slope);
+  const Sample &last = samples.back();
+  return last.seconds * pow(edges / last.edges, max(1.0, slope));
+}
+
+// Grava a malha num arquivo temporário e mede só a leitura (mapeada, como no programa)
+static double timeParse(const Mesh &mesh, Mesh &parsed) {
+  const char *tmp = getenv("TMPDIR");
+  string path = string(tmp ? tmp : "/tmp") + "/bench_meshXXXXXX";
+  int fd = mkstemp(&path[0]);
+  if (fd < 0) {
+    perror("mkstemp");
+    exit(1);
+  }
+  unlink(path.c_str());
+  {
+    OutputWriter out(fd);
+    writeMesh(mesh, out);
+  }
+
+  double seconds = averageSeconds([&] {
+    parsed = Mesh();
+    lseek(fd, 0, SEEK_SET);
+    auto t0 = chrono::steady_clock::now();
+    {
+      InputScanner in(fd);
+      readMesh(in, parsed);
+    }
+    return secondsSince(t0);
+  });
+  close(fd);
+  return seconds;
+}
+
+int main(int argc, char *argv[]) {
+  double minEdges = 1e3, maxEdges = 1e7, cap = 10;
+  string only;
+  for (int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if (arg == "--min-edges" && i + 1 < argc) {
+      minEdges = atof(argv[++i]);
+    } else if (arg == "--max-edges" && i + 1 < argc) {
+      maxEdges = atof(argv[++i]);
+    } else if (arg == "--cap" && i + 1 < argc) {
+      cap = atof(argv[++i]);
+    } else if (arg == "--only" && i + 1 < argc) {
+      only = argv[++i];
+    }
+  }
+
+  int devNull = open("/dev/null", O_WRONLY);
+  map<string, vector<Sample>> history[NUM_PHASES];
+
+  printf("{\n  \"cap_seconds\": %g,\n  \"runs\": [", cap);
+  bool firstRun = true;
+
+  for (const Generator &gen : GENERATORS) {
+    if (!only.empty() && only != gen.name) continue;
+    vector<bool> skipped(NUM_PHASES, false);
+
+    for (double target = minEdges; target <= maxEdges * 1.0001; target *= 10) {
+      int side = max(3, static_cast<int>(lround(sqrt(target / gen.edgesPerSide2))));
+      Mesh generated, mesh;
+      gen.make(side, generated);
+
+      double edges = generated.faces.totalIndices() / 2.0;
+      double seconds[NUM_PHASES];
+      bool ran[NUM_PHASES] = {};
+      string errorMessage;
+      int edgeCode = 0;
+      bool overlapping = false, inside = false;
+
+      // Decide antes de medir: uma fase pulada continua pulada nos tamanhos maiores
+      for (int p = 0; p < NUM_PHASES; p++) {
+        if (!skipped[p] && projectedSeconds(history[p][gen.name], edges) > cap) skipped[p] = true;
+      }
+      if (!gen.valid) skipped[4] = skipped[5] = true; // sem DCEL para malha inválida
+      if (skipped[4]) skipped[5] = true;
+
+      // A leitura sempre roda: as outras fases usam a malha lida
+      seconds[0] = timeParse(generated, mesh);
+      ran[0] = true;
+      generated = Mesh();
+
+      if (!skipped[1]) {
+        seconds[1] = averageSeconds([&] {
+          auto t0 = chrono::steady_clock::now();
+          edgeCode = ValidateEdges(mesh.faces, errorMessage);
+          return secondsSince(t0);
+        });
+        ran[1] = true;
+      }
+      if (!skipped[2]) {
+        seconds[2] = averageSeconds([&] {
+          auto t0 = chrono::steady_clock::now();
+          overlapping = isOverlapping(mesh.vertices, mesh.faces, errorMessage);
+          return secondsSince(t0);
+        });
+        ran[2] = true;
+      }
+      if (!skipped[3]) {
+        seconds[3] = averageSeconds([&] {
+          auto t0 = chrono::steady_clock::now();
+          inside = checkInside(mesh.vertices, mesh.faces, errorMessage);
+          return secondsSince(t0);
+        });
+        ran[3] = true;
+      }
+      if (!skipped[4]) {
+        // A última DCEL construída fica para a impressão
+        DCEL dcel;
+        seconds[4] = averageSeconds([&] {
+          dcel = DCEL();
+          auto t0 = chrono::steady_clock::now();
+          dcel.buildFromMesh(mesh.vertices, mesh.faces);
+          return secondsSince(t0);
+        });
+        ran[4] = true;
+        if (!skipped[5]) {
+          seconds[5] = averageSeconds([&] {
+            OutputWriter out(devNull);
+            auto t0 = chrono::steady_clock::now();
+            dcel.printDCELOutput(out, nullptr);
+            out.flush();
+            return secondsSince(t0);
+          });
+          ran[5] = true;
+        }
+      }
+
+      printf("%s\n    {\"generator\": \"%s\", \"target_edges\": %.0f, \"edges\": %.0f, \"vertices\": %zu, "
+             "\"faces\": %zu, \"valid\": %s,\n     \"results\": {\"validate_edges\": %d, \"is_overlapping\": %s, "
+             "\"check_inside\": %s},\n     \"phases\": {",
+             firstRun ? "" : ",", gen.name, target, edges, mesh.vertices.size(), mesh.faces.size(),
+             gen.valid ? "true" : "false", edgeCode, overlapping ? "true" : "false", inside ? "true" : "false");
+      firstRun = false;
+      for (int p = 0; p < NUM_PHASES; p++) {
+        printf("%s\"%s\": ", p ? ", " : "", PHASES[p]);
+        if (ran[p]) {
+          printf("{\"seconds\": %.6g, \"edges_per_second\": %.4g}", seconds[p], edges / max(seconds[p], 1e-9));
+          history[p][gen.name].push_back({edges, seconds[p]});
+        } else {
+          printf("null");
+        }
+      }
+      printf("}}");
+      fflush(stdout);
+
+      fprintf(stderr, "%-20s %10.0f arestas:", gen.name, edges);
+      for (int p = 0; p < NUM_PHASES; p++) {
+        if (ran[p]) fprintf(stderr, " %s=%.3fs", PHASES[p], seconds[p]);
+      }
+      fprintf(stderr, "\n");
+    }
+  }
+
+  // Expoentes de escala por gerador e fase
+  printf("\n  ],\n  \"scaling\": {");
+  bool firstGen = true;
+  for (const Generator &gen : GENERATORS) {
+    if (!only.empty() && only != gen.name) continue;
+    printf("%s\n    \"%s\": {", firstGen ? "" : ",", gen.name);
+    firstGen = false;
+    for (int p = 0; p < NUM_PHASES; p++) {
+      double slope;
+      printf("%s\"%s\": ", p ? ", " : "", PHASES[p]);
+      if (scalingExponent(history[p][gen.name], slope)) {
+        printf("%.3f", slope);
+      } else {
+        printf("null");
+      }
+    }
+    printf("}");
+  }
+  printf("\n  }\n}\n");
+
+  close(devNull);
+  return 0;
+}
@@ -0,0 +1,148 @@
+/***********************************************************************
+ *
+ * Efeito da ordem dos elementos na memória sobre a validação, a construção
+ * e o percurso da CompactDCEL, sobre uma malha em grade sintética.
+ *
+ * Uso: ./bench_reorder [lado] [repetições]
+ *
+ * Quatro ordens da mesma malha: a da geração (linha a linha, já coerente
+ * com o plano), embaralhada (vértices e faces permutados ao acaso, como em
+ * malhas exportadas por outras ferramentas) e a embaralhada reordenada
+ * pelas curvas de Hilbert e de Morton (reorder.hpp). Para cada ordem:
+ * custo da reordenação, checkMesh, construção, três percursos e a
+ * distância média |h - twin(h)| entre semi-arestas gêmeas.
+ *
+ ************************************************************************/
+#include "../dcel.hpp"
+#include "../dcel_ranges.hpp"
+#include "../dcel_soa.hpp"
+#include "../reorder.hpp"
+#include "mesh_generators.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+
+using namespace std;
+
+static int reps = 10;
+
+static double seconds(chrono::steady_clock::time_point t0) {
+  return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+// Melhor de 3 medições de reps execuções de walk; devolve segundos por execução
+template <class Walk>
+static double timeWalk(long long &sum, Walk walk) {
+  double best = 1e30;
+  for (int trial = 0; trial < 3; trial++) {
+    auto t0 = chrono::steady_clock::now();
+    sum = 0;
+    for (int r = 0; r < reps; r++) sum += walk();
+    best = min(best, seconds(t0) / reps);
+  }
+  return best;
+}
+
+// ======================================================================================================================= //
+
+struct Result {
+  double reorder, check, build, faceWalk, vertexWalk, adjacentWalk, twinGap;
+  long long sum;
+  bool valid;
+};
+
+static Result measure(const Mesh &input, const SpaceFillingCurve *curve) {
+  using index_t = CompactDCEL::index_t;
+  Result r{};
+
+  auto t0 = chrono::steady_clock::now();
+  Mesh ordered;
+  if (curve) {
+    MeshOrder order;
+    spatialOrder(input.vertices, input.faces, *curve, order);
+    reorderMesh(input.vertices, input.faces, order, ordered);
+  } else {
+    ordered = input;
+  }
+  r.reorder = curve ? seconds(t0) : 0;
+
+  string message;
+  t0 = chrono::steady_clock::now();
+  r.valid = checkMesh(ordered.vertices, ordered.faces, message);
+  r.check = seconds(t0);
+
+  CompactDCEL dcel;
+  t0 = chrono::steady_clock::now();
+  dcel.buildFromMesh(ordered.vertices, ordered.faces);
+  r.build = seconds(t0);
+
+  // As somas independem da ordem: as três têm de coincidir entre as ordens
+  long long a, b, c;
+  r.faceWalk = timeWalk(a, [&] {
+    long long sum = 0;
+    for (size_t f = 0; f < dcel.numFaces(); f++) {
+      for (index_t v : faceVertices(dcel, f)) sum += dcel.vx[v];
+    }
+    return sum;
+  });
+  r.vertexWalk = timeWalk(b, [&] {
+    long long sum = 0;
+    for (size_t v = 0; v < dcel.numVertices(); v++) {
+      for (index_t w : vertexNeighbors(dcel, v)) sum += dcel.vy[w];
+    }
+    return sum;
+  });
+  r.adjacentWalk = timeWalk(c, [&] {
+    long long sum = 0;
+    for (size_t f = 0; f < dcel.numFaces(); f++) {
+      for (index_t g : adjacentFaces(dcel, f)) sum += dcel.vx[dcel.origin[dcel.faceEdge[g]]];
+    }
+    return sum;
+  });
+  r.sum = a + b + c;
+
+  double gap = 0;
+  for (size_t h = 0; h < dcel.numHalfEdges(); h++) gap += fabs(double(h) - double(dcel.twin[h]));
+  r.twinGap = gap / max<size_t>(1, dcel.numHalfEdges());
+  return r;
+}
+
+static void report(const char *name, const Result &r) {
+  printf("%-12s %10.4f %10.4f %10.4f %10.5f %10.5f %10.5f %14.1f  %s\n", name, r.reorder, r.check, r.build,
+         r.faceWalk, r.vertexWalk, r.adjacentWalk, r.twinGap, r.valid ? "ok" : "INVÁLIDA");
+}
+
+// ======================================================================================================================= //
+
+int main(int argc, char *argv[]) {
+  int side = argc > 1 ? atoi(argv[1]) : 500;
+  reps = argc > 2 ? max(1, atoi(argv[2])) : 10;
+
+  Mesh grid;
+  gridMesh(side, grid);
+  Mesh shuffled = grid;
+  shuffleMesh(42, shuffled);
+
+  printf("malha: grade %dx%d, %zu vértices, %zu faces\n", side, side, grid.vertices.size(), grid.faces.size());
+  printf("%-12s %10s %10s %10s %10s %10s %10s %14s\n", "ordem", "reord(s)", "check(s)", "build(s)", "face(s)",
+         "vértice(s)", "vizinha(s)", "|h-twin| médio");
+
+  SpaceFillingCurve hilbert = CURVE_HILBERT, morton = CURVE_MORTON;
+  Result natural = measure(grid, nullptr);
+  Result random = measure(shuffled, nullptr);
+  Result byHilbert = measure(shuffled, &hilbert);
+  Result byMorton = measure(shuffled, &morton);
+  report("geração", natural);
+  report("embaralhada", random);
+  report("hilbert", byHilbert);
+  report("morton", byMorton);
+
+  bool ok = natural.valid && random.valid && byHilbert.valid && byMorton.valid;
+  ok &= random.sum == natural.sum && byHilbert.sum == natural.sum && byMorton.sum == natural.sum;
+  if (!ok) printf("DIVERGE\n");
+  return ok ? 0 : 1;
+}
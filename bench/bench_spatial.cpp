@@ -0,0 +1,174 @@
+/***********************************************************************
+ *
+ * Latência das consultas espaciais (spatial_index.hpp) sobre subdivisões
+ * aleatórias de 10^4 a 10^7 arestas.
+ *
+ * Uso: ./bench_spatial [--min-edges N] [--max-edges N] [--queries N] [--threads N]
+ *
+ * Para cada tamanho: construção da CompactDCEL, da BVH de arestas e da
+ * árvore k-d de vértices; tempo médio por consulta de janela pequena
+ * (8x8 células), de janela de faces, de k arestas e de k vértices mais
+ * próximos (k = 1 e 8), e do lote de janelas dividido entre threads. Até
+ * 10^6 arestas, a varredura linear de todas as arestas entra como
+ * referência para a aresta mais próxima e confere o resultado da BVH.
+ *
+ ************************************************************************/
+#include "../dcel_soa.hpp"
+#include "../point_location.hpp"
+#include "../spatial_index.hpp"
+#include "../thread_pool.hpp"
+#include "mesh_generators.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+static const int SPACING = 16; // espaçamento da grade de mesh_generators.cpp
+static const int WINDOW_CELLS = 8;
+static const double LINEAR_MAX_EDGES = 2e6;
+
+static double seconds(chrono::steady_clock::time_point t0) {
+  return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+// Tempo médio por consulta, em microssegundos, de fn(i) para i em [0, n)
+template <class Fn>
+static double perQuery(size_t n, Fn fn) {
+  auto t0 = chrono::steady_clock::now();
+  for (size_t i = 0; i < n; i++) fn(i);
+  return seconds(t0) * 1e6 / max<size_t>(1, n);
+}
+
+// Distância ao quadrado do ponto ao segmento, pela varredura linear
+static double segmentDist2(double px, double py, double ax, double ay, double bx, double by) {
+  double dx = bx - ax, dy = by - ay, len2 = dx * dx + dy * dy;
+  double t = len2 > 0 ? ((px - ax) * dx + (py - ay) * dy) / len2 : 0;
+  t = min(1.0, max(0.0, t));
+  double qx = ax + t * dx - px, qy = ay + t * dy - py;
+  return qx * qx + qy * qy;
+}
+
+// Aresta mais próxima por varredura de todas as semi-arestas representantes
+static Neighbor linearNearest(const CompactDCEL &dcel, const pair<int, int> &pt) {
+  Neighbor best{-1, 1e300};
+  for (size_t h = 0; h < dcel.numHalfEdges(); h++) {
+    CompactDCEL::index_t t = dcel.twin[h];
+    if (t != CompactDCEL::NIL && t < h) continue;
+    CompactDCEL::index_t a = dcel.origin[h], b = dcel.origin[dcel.next[h]];
+    double d = segmentDist2(pt.first, pt.second, dcel.vx[a], dcel.vy[a], dcel.vx[b], dcel.vy[b]);
+    if (d < best.dist2) best = {static_cast<int>(h), d};
+  }
+  return best;
+}
+
+// ======================================================================================================================= //
+
+int main(int argc, char *argv[]) {
+  double minEdges = 1e4, maxEdges = 1e7;
+  size_t queries = 20000;
+  unsigned threads = max(1u, thread::hardware_concurrency());
+  for (int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if (arg == "--min-edges" && i + 1 < argc) {
+      minEdges = atof(argv[++i]);
+    } else if (arg == "--max-edges" && i + 1 < argc) {
+      maxEdges = atof(argv[++i]);
+    } else if (arg == "--queries" && i + 1 < argc) {
+      queries = max(1, atoi(argv[++i]));
+    } else if (arg == "--threads" && i + 1 < argc) {
+      threads = max(1, atoi(argv[++i]));
+    }
+  }
+  ThreadPool pool(threads);
+
+  printf("tempos de construção em s; consultas em µs por consulta (%zu consultas, %u threads no lote)\n", queries,
+         threads);
+  printf("%10s %8s %8s %8s %8s %8s %9s %9s %8s %8s %8s %8s %9s %9s\n", "arestas", "dcel", "bvh", "kd", "janela",
+         "faces", "arestas/j", "faces/j", "aresta1", "aresta8", "vért1", "vért8", "lote/j", "linear1");
+
+  bool ok = true;
+  for (double target = minEdges; target <= maxEdges * 1.0001; target *= 10) {
+    int side = max(3, static_cast<int>(lround(sqrt(target / 2.67))));
+    Mesh mesh;
+    randomSubdivisionMesh(side, 7, mesh);
+
+    CompactDCEL dcel;
+    auto t0 = chrono::steady_clock::now();
+    dcel.buildFromMesh(mesh.vertices, mesh.faces);
+    double buildDcel = seconds(t0);
+    mesh = Mesh();
+
+    t0 = chrono::steady_clock::now();
+    EdgeBVH bvh(dcel);
+    double buildBvh = seconds(t0);
+    t0 = chrono::steady_clock::now();
+    VertexKdTree kd(dcel);
+    double buildKd = seconds(t0);
+    PointLocator locator(dcel);
+
+    // Janelas de WINDOW_CELLS x WINDOW_CELLS células e pontos uniformes na extensão da malha
+    mt19937_64 rng(11);
+    int extent = side * SPACING;
+    uniform_int_distribution<int> coord(0, extent);
+    vector<BoundingBox> boxes(queries);
+    vector<pair<int, int>> points(queries);
+    for (size_t i = 0; i < queries; i++) {
+      long long x = coord(rng), y = coord(rng);
+      boxes[i] = {x, y, x + WINDOW_CELLS * SPACING, y + WINDOW_CELLS * SPACING};
+      points[i] = {coord(rng), coord(rng)};
+    }
+
+    vector<int> found;
+    vector<Neighbor> near;
+    size_t edgesHit = 0, facesHit = 0;
+    double window = perQuery(queries, [&](size_t i) {
+      bvh.window(boxes[i], found);
+      edgesHit += found.size();
+    });
+    double windowFaces = perQuery(queries, [&](size_t i) {
+      bvh.windowFaces(boxes[i], locator, found);
+      facesHit += found.size();
+    });
+    double edge1 = perQuery(queries, [&](size_t i) { bvh.nearest(points[i], 1, near); });
+    double edge8 = perQuery(queries, [&](size_t i) { bvh.nearest(points[i], 8, near); });
+    double vertex1 = perQuery(queries, [&](size_t i) { kd.nearest(points[i], 1, near); });
+    double vertex8 = perQuery(queries, [&](size_t i) { kd.nearest(points[i], 8, near); });
+
+    vector<vector<int>> batch;
+    t0 = chrono::steady_clock::now();
+    bvh.window(boxes, batch, &pool);
+    double batched = seconds(t0) * 1e6 / queries;
+
+    // Referência linear só nos tamanhos em que ela termina em tempo razoável
+    double linear = -1;
+    if (bvh.size() <= LINEAR_MAX_EDGES) {
+      size_t n = min<size_t>(queries, 200);
+      vector<Neighbor> expected(n);
+      linear = perQuery(n, [&](size_t i) { expected[i] = linearNearest(dcel, points[i]); });
+      for (size_t i = 0; i < n; i++) {
+        bvh.nearest(points[i], 1, near);
+        if (near.empty() || near[0].dist2 != expected[i].dist2) ok = false;
+      }
+    }
+
+    printf("%10zu %8.3f %8.3f %8.3f %8.2f %8.2f %9.1f %9.1f %8.2f %8.2f %8.2f %8.2f %9.2f ", bvh.size(), buildDcel,
+           buildBvh, buildKd, window, windowFaces, double(edgesHit) / queries, double(facesHit) / queries, edge1,
+           edge8, vertex1, vertex8, batched);
+    if (linear >= 0) {
+      printf("%9.1f\n", linear);
+    } else {
+      printf("%9s\n", "-");
+    }
+    fflush(stdout);
+  }
+
+  if (!ok) printf("DIVERGE\n");
+  return ok ? 0 : 1;
+}
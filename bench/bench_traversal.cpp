@@ -0,0 +1,211 @@
+/***********************************************************************
+ *
+ * Percurso completo da malha com os circuladores de dcel_ranges.hpp contra
+ * os laços escritos à mão (do/while sobre next e twin->next), na DCEL de
+ * ponteiros e na CompactDCEL, sobre malhas em grade sintéticas.
+ *
+ * Uso: ./bench_traversal [lado] [repetições]
+ *
+ * Três percursos: arestas de cada face, semi-arestas que saem de cada
+ * vértice e faces vizinhas de cada face. Cada um soma uma grandeza dos
+ * elementos visitados; as somas das duas versões têm de ser iguais.
+ *
+ ************************************************************************/
+#include "../dcel.hpp"
+#include "../dcel_ranges.hpp"
+#include "../dcel_soa.hpp"
+#include "mesh_generators.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+
+using namespace std;
+
+static int reps = 20;
+
+// Melhor de 3 medições de reps execuções de walk; devolve segundos por execução
+template <class Walk>
+static double timeWalk(long long &sum, Walk walk) {
+  double best = 1e30;
+  for (int trial = 0; trial < 3; trial++) {
+    auto t0 = chrono::steady_clock::now();
+    sum = 0;
+    for (int r = 0; r < reps; r++) sum += walk();
+    best = min(best, chrono::duration<double>(chrono::steady_clock::now() - t0).count() / reps);
+  }
+  return best;
+}
+
+static bool report(const char *layout, const char *walk, size_t halfEdges, double hand, long long handSum,
+                   double range, long long rangeSum) {
+  printf("%-10s %-16s %12.6f %12.6f %8.2f %10.1f %10.1f  %s\n", layout, walk, hand, range, range / hand,
+         halfEdges / hand / 1e6, halfEdges / range / 1e6, handSum == rangeSum ? "ok" : "DIVERGE");
+  return handSum == rangeSum;
+}
+
+// ======================================================================================================================= //
+
+static bool pointerWalks(const DCEL &dcel) {
+  size_t nh = dcel.halfEdges.size();
+  long long a, b;
+  bool ok = true;
+
+  double hand = timeWalk(a, [&] {
+    long long sum = 0;
+    for (const Face *f : dcel.faces) {
+      const HalfEdge *he = f->outerComponent;
+      do {
+        sum += static_cast<long long>(he->origin->x);
+        he = he->next;
+      } while (he != f->outerComponent);
+    }
+    return sum;
+  });
+  double range = timeWalk(b, [&] {
+    long long sum = 0;
+    for (const Face *f : dcel.faces) {
+      for (const Vertex *v : faceVertices(f)) sum += static_cast<long long>(v->x);
+    }
+    return sum;
+  });
+  ok &= report("ponteiros", "face->vértices", nh, hand, a, range, b);
+
+  hand = timeWalk(a, [&] {
+    long long sum = 0;
+    for (const Vertex *v : dcel.vertices) {
+      const HalfEdge *he = v->incidentEdge;
+      do {
+        sum += static_cast<long long>(he->next->origin->y);
+        he = he->twin->next;
+      } while (he != v->incidentEdge);
+    }
+    return sum;
+  });
+  range = timeWalk(b, [&] {
+    long long sum = 0;
+    for (const Vertex *v : dcel.vertices) {
+      for (const HalfEdge *he : outgoingEdges(v)) sum += static_cast<long long>(he->next->origin->y);
+    }
+    return sum;
+  });
+  ok &= report("ponteiros", "vértice->saídas", nh, hand, a, range, b);
+
+  hand = timeWalk(a, [&] {
+    long long sum = 0;
+    for (const Face *f : dcel.faces) {
+      const HalfEdge *he = f->outerComponent;
+      do {
+        sum += he->twin->incidentFace->id;
+        he = he->next;
+      } while (he != f->outerComponent);
+    }
+    return sum;
+  });
+  range = timeWalk(b, [&] {
+    long long sum = 0;
+    for (const Face *f : dcel.faces) {
+      auto around = adjacentFaces(f);
+      sum += accumulate(around.begin(), around.end(), 0LL, [](long long s, const Face *g) { return s + g->id; });
+    }
+    return sum;
+  });
+  ok &= report("ponteiros", "face->vizinhas", nh, hand, a, range, b);
+  return ok;
+}
+
+// ======================================================================================================================= //
+
+static bool compactWalks(const CompactDCEL &dcel) {
+  using index_t = CompactDCEL::index_t;
+  size_t nh = dcel.numHalfEdges();
+  long long a, b;
+  bool ok = true;
+
+  double hand = timeWalk(a, [&] {
+    long long sum = 0;
+    for (size_t f = 0; f < dcel.numFaces(); f++) {
+      index_t start = dcel.faceEdge[f], he = start;
+      do {
+        sum += dcel.vx[dcel.origin[he]];
+        he = dcel.next[he];
+      } while (he != start);
+    }
+    return sum;
+  });
+  double range = timeWalk(b, [&] {
+    long long sum = 0;
+    for (size_t f = 0; f < dcel.numFaces(); f++) {
+      for (index_t v : faceVertices(dcel, f)) sum += dcel.vx[v];
+    }
+    return sum;
+  });
+  ok &= report("soa", "face->vértices", nh, hand, a, range, b);
+
+  hand = timeWalk(a, [&] {
+    long long sum = 0;
+    for (size_t v = 0; v < dcel.numVertices(); v++) {
+      index_t start = dcel.vertexEdge[v], he = start;
+      do {
+        sum += dcel.vy[dcel.origin[dcel.next[he]]];
+        he = dcel.next[dcel.twin[he]];
+      } while (he != start);
+    }
+    return sum;
+  });
+  range = timeWalk(b, [&] {
+    long long sum = 0;
+    for (size_t v = 0; v < dcel.numVertices(); v++) {
+      for (index_t w : vertexNeighbors(dcel, v)) sum += dcel.vy[w];
+    }
+    return sum;
+  });
+  ok &= report("soa", "vértice->saídas", nh, hand, a, range, b);
+
+  hand = timeWalk(a, [&] {
+    long long sum = 0;
+    for (size_t f = 0; f < dcel.numFaces(); f++) {
+      index_t start = dcel.faceEdge[f], he = start;
+      do {
+        sum += dcel.face[dcel.twin[he]];
+        he = dcel.next[he];
+      } while (he != start);
+    }
+    return sum;
+  });
+  range = timeWalk(b, [&] {
+    long long sum = 0;
+    for (size_t f = 0; f < dcel.numFaces(); f++) {
+      auto around = adjacentFaces(dcel, f);
+      sum += accumulate(around.begin(), around.end(), 0LL);
+    }
+    return sum;
+  });
+  ok &= report("soa", "face->vizinhas", nh, hand, a, range, b);
+  return ok;
+}
+
+// ======================================================================================================================= //
+
+int main(int argc, char *argv[]) {
+  int side = argc > 1 ? atoi(argv[1]) : 300;
+  reps = argc > 2 ? max(1, atoi(argv[2])) : 20;
+
+  Mesh mesh;
+  gridMesh(side, mesh);
+
+  printf("%-10s %-16s %12s %12s %8s %10s %10s\n", "layout", "percurso", "à mão(s)", "ranges(s)", "razão",
+         "Mhe/s mão", "Mhe/s rng");
+
+  DCEL dcel;
+  dcel.buildFromMesh(mesh.vertices, mesh.faces);
+  bool ok = pointerWalks(dcel);
+
+  CompactDCEL compact;
+  compact.buildFromMesh(mesh.vertices, mesh.faces);
+  ok &= compactWalks(compact);
+
+  return ok ? 0 : 1;
+}
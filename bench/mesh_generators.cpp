@@ -0,0 +1,200 @@
+/***********************************************************************
+ *
+ * Geradores de malhas sintéticas para os benchmarks.
+ *
+ ************************************************************************/
+#include "mesh_generators.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+// Espaçamento da grade perturbada; com perturbação de até 3 unidades as
+// células continuam quadriláteros estritamente convexos
+static const int SPACING = 16;
+static const int JITTER = 3;
+
+// Ciclo da borda da grade (side+1)x(side+1) em sentido horário
+static vector<int> outerBoundary(int side) {
+  int n = side + 1;
+  vector<int> outer;
+  for (int x = 0; x <= side; x++) outer.push_back(x);
+  for (int y = 1; y <= side; y++) outer.push_back(y * n + side);
+  for (int x = side - 1; x >= 0; x--) outer.push_back(side * n + x);
+  for (int y = side - 1; y >= 1; y--) outer.push_back(y * n);
+  reverse(outer.begin(), outer.end());
+  return outer;
+}
+
+// ======================================================================================================================= //
+
+static void gridVertices(int side, int spacing, mt19937_64 *rng, Mesh &mesh) {
+  int n = side + 1;
+  mesh.vertices.clear();
+  mesh.vertices.reserve(size_t(n) * n);
+  uniform_int_distribution<int> jitter(-JITTER, JITTER);
+  for (int y = 0; y < n; y++) {
+    for (int x = 0; x < n; x++) {
+      int dx = rng ? jitter(*rng) : 0, dy = rng ? jitter(*rng) : 0;
+      mesh.vertices.push_back({x * spacing + dx, y * spacing + dy});
+    }
+  }
+}
+
+// ======================================================================================================================= //
+
+void gridMesh(int side, Mesh &mesh) {
+  int n = side + 1;
+  gridVertices(side, 1, nullptr, mesh);
+  mesh.faces = FaceList();
+  mesh.faces.reserve(size_t(side) * side + 1, size_t(side) * side * 4 + 4 * side);
+  for (int y = 0; y < side; y++) {
+    for (int x = 0; x < side; x++) {
+      int v = y * n + x;
+      int cell[] = {v, v + 1, v + 1 + n, v + n};
+      mesh.faces.addFace(cell, cell + 4);
+    }
+  }
+  vector<int> outer = outerBoundary(side);
+  mesh.faces.addFace(outer.begin(), outer.end());
+}
+
+// ======================================================================================================================= //
+
+void randomSubdivisionMesh(int side, uint64_t seed, Mesh &mesh) {
+  int n = side + 1;
+  mt19937_64 rng(seed);
+  gridVertices(side, SPACING, &rng, mesh);
+  mesh.faces = FaceList();
+  mesh.faces.reserve(size_t(side) * side * 2 + 1, size_t(side) * side * 6 + 4 * side);
+  uniform_int_distribution<int> kind(0, 2);
+  for (int y = 0; y < side; y++) {
+    for (int x = 0; x < side; x++) {
+      int a = y * n + x, b = a + 1, c = a + 1 + n, d = a + n;
+      switch (kind(rng)) {
+      case 0: {
+        int t1[] = {a, b, c}, t2[] = {a, c, d};
+        mesh.faces.addFace(t1, t1 + 3);
+        mesh.faces.addFace(t2, t2 + 3);
+        break;
+      }
+      case 1: {
+        int t1[] = {a, b, d}, t2[] = {b, c, d};
+        mesh.faces.addFace(t1, t1 + 3);
+        mesh.faces.addFace(t2, t2 + 3);
+        break;
+      }
+      default: {
+        int quad[] = {a, b, c, d};
+        mesh.faces.addFace(quad, quad + 4);
+      }
+      }
+    }
+  }
+  vector<int> outer = outerBoundary(side);
+  mesh.faces.addFace(outer.begin(), outer.end());
+}
+
+// ======================================================================================================================= //
+
+void longBoundaryMesh(int side, Mesh &mesh) {
+  side = max(side, 3);
+  int n = side + 1;
+  auto at = [n](int x, int y) { return y * n + x; };
+  gridVertices(side, 1, nullptr, mesh);
+  mesh.faces = FaceList();
+
+  // Face em U (anti-horária): desce a borda esquerda, percorre a de baixo, sobe
+  // a direita e volta pelo contorno interno
+  vector<int> u;
+  for (int y = side; y >= 0; y--) u.push_back(at(0, y));
+  for (int x = 1; x <= side; x++) u.push_back(at(x, 0));
+  for (int y = 1; y <= side; y++) u.push_back(at(side, y));
+  u.push_back(at(side - 1, side));
+  for (int y = side - 1; y >= 1; y--) u.push_back(at(side - 1, y));
+  for (int x = side - 2; x >= 1; x--) u.push_back(at(x, 1));
+  for (int y = 2; y <= side; y++) u.push_back(at(1, y));
+  mesh.faces.addFace(u.begin(), u.end());
+
+  // Células internas: colunas 1..side-2, linhas 1..side-1
+  for (int y = 1; y < side; y++) {
+    for (int x = 1; x < side - 1; x++) {
+      int cell[] = {at(x, y), at(x + 1, y), at(x + 1, y + 1), at(x, y + 1)};
+      mesh.faces.addFace(cell, cell + 4);
+    }
+  }
+  vector<int> outer = outerBoundary(side);
+  mesh.faces.addFace(outer.begin(), outer.end());
+}
+
+// ======================================================================================================================= //
+
+void crossingMesh(int side, uint64_t seed, Mesh &mesh) {
+  randomSubdivisionMesh(max(side, 4), seed, mesh);
+  // Vértice interno no meio da grade, empurrado duas células para a direita
+  int n = max(side, 4) + 1;
+  auto &v = mesh.vertices[size_t(n / 2) * n + n / 2];
+  v.first += 2 * SPACING;
+}
+
+// ======================================================================================================================= //
+
+void openMesh(int side, Mesh &mesh) {
+  gridMesh(side, mesh);
+  Mesh open;
+  open.vertices = move(mesh.vertices);
+  for (size_t f = 0; f + 1 < mesh.faces.size(); f++) {
+    open.faces.addFace(mesh.faces[f].begin(), mesh.faces[f].end());
+  }
+  mesh = move(open);
+}
+
+// ======================================================================================================================= //
+
+void shuffleMesh(uint64_t seed, Mesh &mesh) {
+  mt19937_64 rng(seed);
+  vector<int> vertexOrder(mesh.vertices.size()), faceOrder(mesh.faces.size());
+  for (size_t i = 0; i < vertexOrder.size(); i++) vertexOrder[i] = int(i);
+  for (size_t f = 0; f < faceOrder.size(); f++) faceOrder[f] = int(f);
+  shuffle(vertexOrder.begin(), vertexOrder.end(), rng);
+  shuffle(faceOrder.begin(), faceOrder.end(), rng);
+
+  // vertexOrder[i]: vértice antigo que vai para a posição i
+  Mesh shuffled;
+  vector<int> position(mesh.vertices.size());
+  shuffled.vertices.resize(mesh.vertices.size());
+  for (size_t i = 0; i < vertexOrder.size(); i++) {
+    position[vertexOrder[i]] = int(i);
+    shuffled.vertices[i] = mesh.vertices[vertexOrder[i]];
+  }
+  shuffled.faces.reserve(mesh.faces.size(), mesh.faces.totalIndices());
+  for (int f : faceOrder) {
+    for (int v : mesh.faces[f]) shuffled.faces.push(position[v]);
+    shuffled.faces.closeFace();
+  }
+  mesh = move(shuffled);
+}
+
+// ======================================================================================================================= //
+
+void writeMesh(const Mesh &mesh, OutputWriter &out) {
+  out.putUInt(mesh.vertices.size());
+  out.put(' ');
+  out.putUInt(mesh.faces.size());
+  out.put('\n');
+  for (const auto &v : mesh.vertices) {
+    out.putInt(v.first);
+    out.put(' ');
+    out.putInt(v.second);
+    out.put('\n');
+  }
+  for (const auto &face : mesh.faces) {
+    for (size_t i = 0; i < face.size(); i++) {
+      if (i) out.put(' ');
+      out.putUInt(face[i] + 1);
+    }
+    out.put('\n');
+  }
+}
@@ -0,0 +1,61 @@
+/***********************************************************************
+ *
+ * Geradores de malhas sintéticas para os benchmarks. Todos produzem a
+ * malha no formato de entrada (faces anti-horárias + face externa horária),
+ * com tamanho controlado pelo lado de uma grade.
+ *
+ ************************************************************************/
+#ifndef MESH_GENERATORS_HPP
+#define MESH_GENERATORS_HPP
+
+#include <cstdint>
+
+#include "../mesh.hpp"
+#include "../output_writer.hpp"
+
+using namespace std;
+
+/**
+ * Grade de lado x lado células quadradas mais a face externa
+ * Arestas: 2·lado·(lado+1)
+ */
+void gridMesh(int side, Mesh &mesh);
+
+/**
+ * Subdivisão aleatória: grade com vértices perturbados em que cada célula vira
+ * dois triângulos (diagonal sorteada) ou continua quadrilátero
+ * Arestas: aproximadamente 2.67·lado²
+ */
+void randomSubdivisionMesh(int side, uint64_t seed, Mesh &mesh);
+
+/**
+ * Grade cuja coluna esquerda, linha de baixo e coluna direita formam uma única
+ * face em U com ~6·lado vértices; o retângulo dessa face cobre todos os vértices
+ * internos, o pior caso de checkInside
+ * Arestas: aproximadamente 2·lado²
+ */
+void longBoundaryMesh(int side, Mesh &mesh);
+
+/**
+ * Subdivisão aleatória com um vértice interno deslocado por cima dos vizinhos
+ * (inválida: superposta)
+ */
+void crossingMesh(int side, uint64_t seed, Mesh &mesh);
+
+/**
+ * Grade sem a face externa (inválida: aberta)
+ */
+void openMesh(int side, Mesh &mesh);
+
+/**
+ * Permuta vértices e faces ao acaso (cada face mantém o ciclo), como nas
+ * malhas exportadas cuja ordem não tem relação com a posição no plano
+ */
+void shuffleMesh(uint64_t seed, Mesh &mesh);
+
+/**
+ * Escreve a malha no formato de entrada do programa
+ */
+void writeMesh(const Mesh &mesh, OutputWriter &out);
+
+#endif // MESH_GENERATORS_HPP
@@ -9,24 +9,80 @@
  *
  ************************************************************************/
 #include "dcel.hpp"
+#include "edge_table.hpp"
+#include "predicates.hpp"
+#include "spatial_grid.hpp"
+#include "stats.hpp"
+#include "sweep.hpp"
 
 using namespace std;
 
 // ======================================================================================================================= //
 
 // Verifica a validade da malha conforme os critérios especificados
-bool checkMesh(const vector<pair<int, int>> &verticesCoords, const vector<vector<int>> &faces, string &errorMessage) {
+bool checkMesh(const vector<pair<int, int>> &verticesCoords, const FaceList &faces, string &errorMessage, unsigned threads) {
   // Verificar se a malha é aberta (alguma aresta é fronteira de somente uma face)
-  if (ValidateEdges(faces, errorMessage) == -1) {
+  // Uma única passada classifica as arestas (-1: aberta, -2: não subdivisão planar)
+  int edges = ValidateEdges(faces, errorMessage);
+  if (edges == -1) {
     errorMessage = "aberta";
     return false;
-  } else if (ValidateEdges(faces, errorMessage) == -2) {
+  } else if (edges == -2) {
     errorMessage = "não subdivisão planar";
     return false;
   }
 
   // Verificar se há sobreposições (auto-intersecções ou pontos internos inválidos)
-  if (isOverlapping(verticesCoords, faces, errorMessage) || checkInside(verticesCoords, faces, errorMessage)) {
+  bool overlapping = false;
+  vector<FaceAttributes<int>> attributes;
+  MeshComponents components;
+  if (threads <= 1) {
+    overlapping = isOverlapping(verticesCoords, faces, errorMessage);
+    if (!overlapping) {
+      computeFaceAttributes(verticesCoords, faces, attributes);
+      findComponents(verticesCoords.size(), faces, components);
+      overlapping = checkInside(verticesCoords, faces, errorMessage, nullptr, nullptr, &attributes, &components);
+    }
+  } else {
+    // Os atributos das faces são uma passada paralela própria, antes da varredura:
+    // parallelFor espera o pool inteiro e esperaria a varredura junto
+    ThreadPool pool(threads);
+    computeFaceAttributes(verticesCoords, faces, attributes, &pool);
+    findComponents(verticesCoords.size(), faces, components);
+
+    // A varredura é global e roda como uma tarefa enquanto as faces de checkInside
+    // são divididas entre os workers; se ela encontrar interseção, cancela o resto
+    atomic<bool> cancel{false};
+    string overlapMessage, insideMessage;
+    bool intersects = false;
+
+    pool.submit([&] {
+      intersects = isOverlapping(verticesCoords, faces, overlapMessage);
+      if (intersects) cancel.store(true);
+    });
+    // Uma face degenerada faz checkInside lançar; na versão sequencial a varredura
+    // vem antes e a interseção tem prioridade sobre a exceção
+    bool inside = false;
+    exception_ptr insideError;
+    try {
+      inside = checkInside(verticesCoords, faces, insideMessage, &pool, &cancel, &attributes, &components);
+    } catch (...) {
+      insideError = current_exception();
+    }
+    pool.wait();
+
+    // Mesma prioridade da versão sequencial
+    if (intersects) {
+      errorMessage = overlapMessage;
+    } else if (insideError) {
+      rethrow_exception(insideError);
+    } else if (inside) {
+      errorMessage = insideMessage;
+    }
+    overlapping = intersects || inside;
+  }
+
+  if (overlapping) {
     errorMessage = "superposta";
     return false;
   }
@@ -37,69 +93,154 @@ bool checkMesh(const vector<pair<int, int>> &verticesCoords, const vector<vector
 
 // ======================================================================================================================= //
 
-// Verifica se um ponto está de um polígono válido a partir das faces
-bool checkInside(const vector<pair<int, int>> &verticesCoords, const vector<vector<int>> &faces, string &errorMessage) {
-    
-    // Para cada face 
-    for (size_t f = 0; f < faces.size(); ++f) {
-        const auto &face = faces[f];
-        
-        // Construir o polígono da face atual
-        vector<pair<int, int>> polygon;
-        for (int idx : face) {
-            polygon.push_back(verticesCoords[idx]);
+// Testa os vértices candidatos contra a face f; para na primeira violação, em ordem crescente de vértice
+// attributes traz a orientação e o retângulo envolvente da face (sem montar o polígono)
+// inFace marca a última face que usou cada vértice (pertinência em O(1))
+// soa recebe a face em SoA para os testes em lote de predicates.hpp (borda e interior numa passada)
+// component traz o componente conexo de cada vértice: os de outro componente são ignorados
+static bool faceHasForeignVertex(size_t f, const vector<pair<int, int>> &verticesCoords, const FaceList &faces,
+                                 const FaceAttributes<int> &attributes, const PointGrid &grid,
+                                 const vector<int> &component, vector<size_t> &inFace, vector<int> &candidates,
+                                 PolygonSoA &soa, string &errorMessage) {
+    const auto &face = faces[f];
+
+    // Verificar orientação: faces horárias não delimitam região
+    if (!isCounterClockwise(attributes)) {
+        return false;
+    }
+
+    for (int idx : face) {
+        inFace[idx] = f;
+    }
+
+    // Só os vértices dentro do retângulo envolvente podem estar na borda ou no interior
+    grid.query(attributes.bbox(), candidates);
+    STATS_ADD(STATS_GRID_CANDIDATES, candidates.size());
+    soa.assign(verticesCoords, face);
+
+    for (int i : candidates) {
+        // Ignora apenas se o ponto é vértice DESTA face específica
+        if (inFace[i] == f) {
+            continue;
         }
 
-        // Verificar orientação e printar se for CW
-        if (!isCounterClockwise(polygon)) {
+        // Vértice de outro componente conexo: se estiver dentro, o componente é
+        // um buraco da face (as arestas dos dois não se cruzam nem se tocam).
+        // Vértices soltos (fora de todas as faces) continuam sendo sobreposição
+        if (component[i] >= 0 && component[i] != component[face[0]]) {
             continue;
         }
 
-        // Para todos os vértices do modelo
-        for (size_t i = 0; i < verticesCoords.size(); ++i) {
-            // Ignora apenas se o ponto é vértice DESTA face específica
-            if (find(face.begin(), face.end(), i) != face.end()) {
-                continue;
-            }
+        // Borda tem prioridade sobre interior, como em isPointOnPolygonBorder + isPointInsidePolygon
+        PointClass where = classifyPoint(verticesCoords[i], soa);
+        if (where == POINT_ON_BORDER) {
+            errorMessage = "Ponto " + to_string(i + 1) +
+                          " está na borda da face " + to_string(f + 1);
+            return true;
+        }
+        if (where == POINT_INSIDE) {
+            errorMessage = "Ponto " + to_string(i + 1) +
+                          " está dentro da face " + to_string(f + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Verifica se um ponto está de um polígono válido a partir das faces
+// Uma grade uniforme sobre os vértices limita o teste aos pontos no retângulo envolvente da face
+bool checkInside(const vector<pair<int, int>> &verticesCoords, const FaceList &faces, string &errorMessage,
+                 ThreadPool *pool, const atomic<bool> *cancel, const vector<FaceAttributes<int>> *attributes,
+                 const MeshComponents *components) {
+    vector<FaceAttributes<int>> computed;
+    if (!attributes) {
+        computeFaceAttributes(verticesCoords, faces, computed, pool);
+        attributes = &computed;
+    }
+    MeshComponents computedComponents;
+    if (!components) {
+        findComponents(verticesCoords.size(), faces, computedComponents);
+        components = &computedComponents;
+    }
+    const vector<int> &component = components->vertexComponent;
+    STATS_TIMER(STATS_CHECK_INSIDE);
 
-            // Verificação de borda (mais rápida)
-            if (isPointOnPolygonBorder(verticesCoords[i], polygon)) {
-                errorMessage = "Ponto " + to_string(i + 1) +
-                              " está na borda da face " + to_string(f + 1);
+    // Índice espacial construído uma vez para a malha
+    PointGrid grid(verticesCoords);
+
+    if (!pool) {
+        vector<size_t> inFace(verticesCoords.size(), faces.size());
+        vector<int> candidates;
+        PolygonSoA soa;
+
+        // Para cada face 
+        for (size_t f = 0; f < faces.size(); ++f) {
+            if (faceHasForeignVertex(f, verticesCoords, faces, (*attributes)[f], grid, component, inFace,
+                                     candidates, soa, errorMessage)) {
                 return true;
             }
+        }
+        return false;
+    }
 
-            // Verificação de interior
-            if (isPointInsidePolygon(verticesCoords[i], polygon)) {
-                errorMessage = "Ponto " + to_string(i + 1) +
-                              " está dentro da face " + to_string(f + 1);
-                return true;
+    // Versão paralela: blocos de faces entre os workers, com área de trabalho por worker.
+    // Vence a violação de menor índice de face, como na versão sequencial; faces acima
+    // da melhor violação já encontrada são descartadas (cancelamento cooperativo)
+    struct Scratch {
+        vector<size_t> inFace;
+        vector<int> candidates;
+        PolygonSoA soa;
+    };
+    vector<Scratch> scratch(pool->size() + 1); // +1 para a thread chamadora (blocos pequenos)
+    atomic<size_t> bestFace{faces.size()};
+    mutex bestMutex;
+    string bestMessage;
+
+    size_t grain = max<size_t>(16, faces.size() / (8 * pool->size()));
+    parallelFor(pool, 0, faces.size(), grain, [&](size_t lo, size_t hi) {
+        Scratch &local = scratch[ThreadPool::workerIndex() + 1];
+        if (local.inFace.empty()) {
+            local.inFace.assign(verticesCoords.size(), faces.size());
+        }
+
+        string message;
+        for (size_t f = lo; f < hi; ++f) {
+            if ((cancel && cancel->load(memory_order_relaxed)) || f > bestFace.load(memory_order_relaxed)) {
+                return;
+            }
+            if (faceHasForeignVertex(f, verticesCoords, faces, (*attributes)[f], grid, component, local.inFace,
+                                     local.candidates, local.soa, message)) {
+                lock_guard<mutex> lock(bestMutex);
+                if (f < bestFace.load()) {
+                    bestFace.store(f);
+                    bestMessage = message;
+                }
+                return;
             }
         }
+    });
+
+    if (bestFace.load() < faces.size()) {
+        errorMessage = bestMessage;
+        return true;
     }
-    
     return false;
 }
 
 // ======================================================================================================================= //
 
 // Função auxiliar para verificar se ponto está na borda do polígono
-bool isPointOnPolygonBorder(const pair<int, int> &pt, const vector<pair<int, int>> &polygon) {
-    int x = pt.first, y = pt.second;
+template <class Coord>
+bool isPointOnPolygonBorder(const pair<Coord, Coord> &pt, const vector<pair<Coord, Coord>> &polygon) {
+    STATS_COUNT(STATS_BORDER_TESTS);
     size_t n = polygon.size();
 
     for (size_t i = 0; i < n; ++i) {
         const auto &a = polygon[i];
         const auto &b = polygon[(i + 1) % n];
 
-        // Verifica se o ponto está sobre a aresta
-        int minX = min(a.first, b.first), maxX = max(a.first, b.first);
-        int minY = min(a.second, b.second), maxY = max(a.second, b.second);
-
-        // Checa colinearidade e se está dentro dos limites da aresta
-        int det = (b.first - a.first) * (y - a.second) - (x - a.first) * (b.second - a.second);
-        
-        if (det == 0 && x >= minX && x <= maxX && y >= minY && y <= maxY) {
+        // Ponto colinear com a aresta (orientação exata) e dentro dos seus limites
+        if (pointOnSegment(a, b, pt)) {
             // Ponto está na borda
             return true;
         }
@@ -110,8 +251,10 @@ bool isPointOnPolygonBorder(const pair<int, int> &pt, const vector<pair<int, int
 // ======================================================================================================================= //
 
 // Verifica se o ponto está estritamente dentro do polígono, sem contar borda, usando ray casting
-bool isPointInsidePolygon(const pair<int, int> &pt, const vector<pair<int, int>> &polygon) {
-    int x = pt.first, y = pt.second;
+template <class Coord>
+bool isPointInsidePolygon(const pair<Coord, Coord> &pt, const vector<pair<Coord, Coord>> &polygon) {
+    STATS_COUNT(STATS_POLYGON_TESTS);
+    Coord y = pt.second;
     int crossings = 0;
     size_t n = polygon.size();
 
@@ -120,11 +263,13 @@ bool isPointInsidePolygon(const pair<int, int> &pt, const vector<pair<int, int>>
         const auto &b = polygon[(i + 1) % n];
 
         // Ray Casting: conta interseções com a borda do polígono
+        // x < xinters equivale a orient2d(a, b, pt) ter o sinal de dy (sem divisão nem arredondamento)
         bool cond1 = (a.second > y) != (b.second > y);
-        double xinters = (double)(b.first - a.first) * (y - a.second) /
-                        (b.second - a.second + 1e-10) + a.first;
-        if (cond1 && x < xinters) {
-            crossings++;
+        if (cond1) {
+            int side = orient2d(a, b, pt);
+            if (b.second > a.second ? side > 0 : side < 0) {
+                crossings++;
+            }
         }
     }
 
@@ -136,80 +281,90 @@ bool isPointInsidePolygon(const pair<int, int> &pt, const vector<pair<int, int>>
 
 // Função que valida se toda aresta passada na entrada possui uma "gêmea" para garantir malha fechada
 // Também verifica se não há mais de uma aresta sobre a outra, fazendo uma possível não subdivisão planar
-int ValidateEdges(const vector<vector<int>> &faces, string &errorMessage) {
-  // Contador de arestas direcionadas (incluindo múltiplas ocorrências)
-  map<pair<int, int>, vector<int>> edgeMap; // {aresta: [faces]}
-  
+int ValidateEdges(const FaceList &faces, string &errorMessage) {
+  STATS_TIMER(STATS_VALIDATE_EDGES);
+  // Por aresta direcionada: ocorrências e a última face em que apareceu. As
+  // semi-arestas de uma face são vistas em sequência, então uma repetição na
+  // mesma face é detectada na própria inserção.
+  // (16 bytes por slot com a chave: as faces cabem em 32 bits, pois F é lido como int)
+  struct EdgeUse {
+    uint32_t count;
+    uint32_t lastFace;
+  };
+  EdgeTable<EdgeUse> edges(faces.totalIndices());
+
+  // Repetição na mesma face: vale a de menor aresta, na primeira face em que ocorre
+  bool repeated = false;
+  uint64_t repeatedKey = 0;
+  size_t repeatedFace = 0;
+
   for (size_t face_idx = 0; face_idx < faces.size(); ++face_idx) {
       const auto &face = faces[face_idx];
-      
+
       for (size_t i = 0; i < face.size(); ++i) {
           size_t j = (i + 1) % face.size();
-          int v1 = face[i];
-          int v2 = face[j];
-          auto edge = make_pair(v1, v2);
-          
-          // Cria arestas a partir da entrada (ida)
-          edgeMap[edge].push_back(face_idx);
+          uint64_t key = EdgeTable<EdgeUse>::key(face[i], face[j]);
+
+          bool inserted;
+          EdgeUse &use = edges.findOrInsert(key, inserted);
+          if (inserted) {
+              use = {1, uint32_t(face_idx)};
+              continue;
+          }
+          if (use.lastFace == face_idx && (!repeated || key < repeatedKey)) {
+              repeated = true;
+              repeatedKey = key;
+              repeatedFace = face_idx;
+          }
+          use.count++;
+          use.lastFace = uint32_t(face_idx);
       }
   }
 
-  set<pair<int, int>> processedEdges;
-  bool openMesh = false;
-  bool nonPlanar = false;
-
-  for (const auto &entry : edgeMap) {
-      auto edge = entry.first;
+  auto edgeName = [](uint64_t key) {
+      return "Aresta (" + to_string(EdgeTable<EdgeUse>::first(key) + 1) + "," +
+             to_string(EdgeTable<EdgeUse>::second(key) + 1) + ")";
+  };
 
-      // Cria o vetor esperado de arestas invertidas (volta)
-      auto reverseEdge = make_pair(edge.second, edge.first);
+  if (repeated) {
+      errorMessage = edgeName(repeatedKey) + " aparece 2 vezes na face " + to_string(repeatedFace + 1);
+      return -2; // Código para não-subdivisão planar
+  }
 
-      // Pular se já processamos esse par
-      if (processedEdges.count(edge) || processedEdges.count(reverseEdge)) continue;
-      
-      // Verificar aresta inversa
-      if (!edgeMap.count(reverseEdge)) {
-          errorMessage = "Aresta (" + to_string(edge.first+1) + "," +
-                        to_string(edge.second+1) + ") não tem correspondente inversa";
+  // Cada aresta não direcionada é julgada pela menor das suas duas chaves; a
+  // mensagem que fica é a da maior chave com problema, como ao percorrer as
+  // arestas em ordem e sobrescrever a mensagem a cada erro
+  bool openMesh = false;
+  bool nonPlanar = false;
+  bool found = false;
+  uint64_t messageKey = 0;
+  size_t messageCount = 0;
+
+  edges.forEach([&](uint64_t key, EdgeUse &use) {
+      uint64_t reverseKey = EdgeTable<EdgeUse>::reverse(key);
+      const EdgeUse *back = edges.find(reverseKey);
+      size_t totalCount = 0;
+      if (!back) {
           openMesh = true; // Aresta de ida não possui aresta de volta
-          continue;
-      }
-
-      // Contar ocorrências totais (direta + inversa)
-      // entry.second.size() retorna o número de faces que contêm a aresta direcionada entry.first
-      int totalCount = entry.second.size() + edgeMap[reverseEdge].size();
-
-      if (totalCount != 2) {
-          errorMessage = "Aresta (" + to_string(edge.first+1) + "," +
-                      to_string(edge.second+1) + ") e sua inversa aparecem " +
-                      to_string(totalCount) + " vezes";
+      } else if (key <= reverseKey) {
+          // Contar ocorrências totais (direta + inversa; um laço (v,v) é a própria inversa)
+          totalCount = size_t(use.count) + back->count;
+          if (totalCount == 2) return;
           nonPlanar = true; // Aresta de ida tem mais de um correspondente de volta
+      } else {
+          return;
       }
-
-      // Processadas
-      processedEdges.insert(edge);
-      processedEdges.insert(reverseEdge);
-  }
-
-  // Verificar duplicatas na mesma face
-  for (const auto &entry : edgeMap) {
-      const auto &edge = entry.first;
-      const auto &face_indices = entry.second;
-      
-      if (face_indices.size() > 1) {
-          // Verificar se aparece mais de uma vez na mesma face
-          map<int, int> faceCount;
-          for (int face_idx : face_indices) {
-              faceCount[face_idx]++;
-              if (faceCount[face_idx] > 1) {
-                  errorMessage = "Aresta (" + to_string(edge.first+1) + "," +
-                              to_string(edge.second+1) + ") aparece " +
-                              to_string(faceCount[face_idx]) + " vezes na face " +
-                              to_string(face_idx+1);
-                  return -2; // Código para não-subdivisão planar
-              }
-          }
+      if (!found || key > messageKey) {
+          found = true;
+          messageKey = key;
+          messageCount = totalCount;
       }
+  });
+
+  if (found) {
+      errorMessage = messageCount == 0 ? edgeName(messageKey) + " não tem correspondente inversa"
+                                       : edgeName(messageKey) + " e sua inversa aparecem " +
+                                             to_string(messageCount) + " vezes";
   }
 
   if (nonPlanar) return -2; // Código para não-subdivisão planar
@@ -221,28 +376,27 @@ int ValidateEdges(const vector<vector<int>> &faces, string &errorMessage) {
 // ======================================================================================================================= //
 
 // Função que retorna a orientação entre duas arestas
-int orientation(const pair<int, int> &p, const pair<int, int> &q, const pair<int, int> &r) {
-  long long val = 1LL * (q.second - p.second) * (r.first - q.first) -
-                  1LL * (q.first - p.first) * (r.second - q.second);
-  return (val == 0) ? 0 : (val > 0 ? 1 : 2); // 0: colinear, 1: horário, 2: anti-horário
+template <class Coord>
+int orientation(const pair<Coord, Coord> &p, const pair<Coord, Coord> &q, const pair<Coord, Coord> &r) {
+  int sign = orient2d(p, q, r); // exato, com filtro em double
+  return (sign == 0) ? 0 : (sign < 0 ? 1 : 2); // 0: colinear, 1: horário, 2: anti-horário
 }
 
 // ======================================================================================================================= //
 
 // Verifica se ponto q está no segmento pr
-bool onSegment(const pair<int, int> &a, const pair<int, int> &b, const pair<int, int> &p) {
-  return (min(a.first, b.first) <= p.first &&
-          p.first <= max(a.first, b.first)) &&
-         (min(a.second, b.second) <= p.second &&
-          p.second <= max(a.second, b.second)) &&
-         ((b.first - a.first) * (p.second - a.second) ==
-          (p.first - a.first) * (b.second - a.second)); // Produto vetorial == 0
+template <class Coord>
+bool onSegment(const pair<Coord, Coord> &a, const pair<Coord, Coord> &b, const pair<Coord, Coord> &p) {
+  return pointOnSegment(a, b, p); // Produto vetorial == 0 (exato) e dentro do retângulo
 }
 
 // ======================================================================================================================= //
 
 // Verifica se os segmentos p1q1 e p2q2 se intersectam
-bool doSegmentsIntersect(const pair<int, int>& p1, const pair<int, int>& q1, const pair<int, int>& p2, const pair<int, int>& q2) {
+template <class Coord>
+bool doSegmentsIntersect(const pair<Coord, Coord>& p1, const pair<Coord, Coord>& q1, const pair<Coord, Coord>& p2,
+                         const pair<Coord, Coord>& q2) {
+    STATS_COUNT(STATS_SEGMENT_TESTS);
     int o1 = orientation(p1, q1, p2);
     int o2 = orientation(p1, q1, q2);
     int o3 = orientation(p2, q2, p1);
@@ -262,66 +416,86 @@ bool doSegmentsIntersect(const pair<int, int>& p1, const pair<int, int>& q1, con
 
 // ======================================================================================================================= //
 
-// Verifica se há faces que se sobrepõe com base nas arestas de cada face
-bool isOverlapping(const vector<pair<int, int>> &verticesCoords, const vector<vector<int>> &faces, string &errorMessage) {
-
-  // Verificar auto-intersecção em cada face
-for (size_t faceIdx = 0; faceIdx < faces.size(); ++faceIdx) {
-  const auto &face = faces[faceIdx];
-  size_t n = face.size();
-
-  for (size_t i = 0; i < n; ++i) {
-    size_t i_next = (i + 1) % n;
-    const auto &v1 = verticesCoords[face[i]];
-    const auto &v2 = verticesCoords[face[i_next]];
-
-    for (size_t j = 0; j < n; ++j) {
-      size_t j_next = (j + 1) % n;
+// Verifica se há arestas da malha que se intersectam, dentro de uma face ou entre faces diferentes
+// Usa uma varredura de Shamos–Hoey sobre todas as arestas em vez de testar cada par de arestas da face
+bool isOverlapping(const vector<pair<int, int>> &verticesCoords, const FaceList &faces, string &errorMessage) {
+  STATS_TIMER(STATS_IS_OVERLAPPING);
+
+  // Face que passa duas vezes pelo mesmo vértice se auto-intersecta nele
+  vector<size_t> lastFace(verticesCoords.size(), faces.size());
+  for (size_t faceIdx = 0; faceIdx < faces.size(); ++faceIdx) {
+    for (int v : faces[faceIdx]) {
+      if (lastFace[v] == faceIdx) {
+        errorMessage = "Face " + to_string(faceIdx + 1) + " passa mais de uma vez pelo vértice " +
+                       to_string(v + 1);
+        return true;
+      }
+      lastFace[v] = faceIdx;
+    }
+  }
 
-      // Pular arestas adjacentes ou superpostas
-      if (i == j || i == j_next || i_next == j || i_next == j_next)
-        continue;
+  // Vértices distintos na mesma posição se sobrepõem (e a varredura não os distingue)
+  vector<int> used;
+  for (const auto &face : faces) {
+    used.insert(used.end(), face.begin(), face.end());
+  }
+  sort(used.begin(), used.end());
+  used.erase(unique(used.begin(), used.end()), used.end());
+  sort(used.begin(), used.end(), [&verticesCoords](int a, int b) {
+    return make_pair(verticesCoords[a], a) < make_pair(verticesCoords[b], b);
+  });
+  for (size_t i = 1; i < used.size(); ++i) {
+    if (verticesCoords[used[i]] == verticesCoords[used[i - 1]]) {
+      errorMessage = "Vértices " + to_string(used[i - 1] + 1) + " e " + to_string(used[i] + 1) +
+                     " ocupam a mesma posição";
+      return true;
+    }
+  }
 
-      const auto &v3 = verticesCoords[face[j]];
-      const auto &v4 = verticesCoords[face[j_next]];
+  EdgeIntersection hit;
+  if (!findIntersectingSegments(collectSegments(verticesCoords, faces), hit)) {
+    return false;
+  }
 
-      if (doSegmentsIntersect(v1, v2, v3, v4)) {
-        errorMessage = "Face " + to_string(faceIdx + 1) +
-                       " tem auto-intersecção entre arestas (" +
-                       to_string(face[i] + 1) + "," + to_string(face[i_next] + 1) +
-                       ") e (" + to_string(face[j] + 1) + "," + to_string(face[j_next] + 1) + ")";
-        return true;
-      }
+  // Aresta no sentido em que aparece na face f
+  auto edgeIn = [](const SweepSegment &s, int f) {
+    int a = (f == s.face) ? s.from : s.to;
+    int b = (f == s.face) ? s.to : s.from;
+    return "(" + to_string(a + 1) + "," + to_string(b + 1) + ")";
+  };
+
+  const SweepSegment &a = hit.first, &b = hit.second;
+  for (int f : {a.face, a.twinFace}) {
+    if (f != -1 && (f == b.face || f == b.twinFace)) {
+      errorMessage = "Face " + to_string(f + 1) + " tem auto-intersecção entre arestas " +
+                     edgeIn(a, f) + " e " + edgeIn(b, f);
+      return true;
     }
   }
-}
-  return false;
+  errorMessage = "Arestas " + edgeIn(a, a.face) + " da face " + to_string(a.face + 1) + " e " +
+                 edgeIn(b, b.face) + " da face " + to_string(b.face + 1) + " se intersectam";
+  return true;
 }
 
 // ======================================================================================================================= //
 
 // Verifica se a face está no sentido horário ou anti-horário
 // Usa o algoritmo de shoelace para determinar o sentido a partir da área (https://en.wikipedia.org/wiki/Shoelace_formula)
-bool isCounterClockwise(const vector<pair<int, int>>& face) {
+template <class Coord>
+bool isCounterClockwise(const vector<pair<Coord, Coord>>& face) {
     if (face.size() < 3) throw invalid_argument("Face inválida: menos de 3 vértices");
     
-    double area = 0.0;
-    int n = face.size();
+    // Soma exata em __int128 para coordenadas de 32 bits; mais largas usam o vértice extremo
+    int sign = polygonOrientation(face);
     
-    for (int i = 0; i < n; i++) {
-        const pair<int, int>& atual = face[i];
-        const pair<int, int>& proximo = face[(i + 1) % n];
-        area += (proximo.first - atual.first) * (proximo.second + atual.second);
-    }
-    
-    if (area == 0.0) throw invalid_argument("Face degenerada: área zero");
-    return area < 0; // Área negativa = CCW (anti-horário)
+    if (sign == 0) throw invalid_argument("Face degenerada: área zero");
+    return sign > 0; // Área positiva = CCW (anti-horário)
 }
 
 // ======================================================================================================================= //
 
 // Implementação da função debugPrintMesh para depuração da malha
-void debugPrintMesh(const vector<pair<int, int>> &verticesCoords, const vector<vector<int>> &faces) {
+void debugPrintMesh(const vector<pair<int, int>> &verticesCoords, const FaceList &faces) {
   cout << "\n===== DEBUG: DETALHES DA MALHA =====\n";
 
   // Mostra informações sobre os vértices
@@ -396,3 +570,21 @@ void debugPrintMesh(const vector<pair<int, int>> &verticesCoords, const vector<v
 
   cout << "====================================\n\n";
 }
+
+// ======================================================================================================================= //
+
+// Instanciações dos predicados para os tipos de coordenada da DCEL
+#define DCEL_INSTANTIATE_PREDICATES(Coord)                                                                     \
+  template bool isPointOnPolygonBorder(const pair<Coord, Coord> &, const vector<pair<Coord, Coord>> &);       \
+  template bool isPointInsidePolygon(const pair<Coord, Coord> &, const vector<pair<Coord, Coord>> &);         \
+  template int orientation(const pair<Coord, Coord> &, const pair<Coord, Coord> &, const pair<Coord, Coord> &); \
+  template bool onSegment(const pair<Coord, Coord> &, const pair<Coord, Coord> &, const pair<Coord, Coord> &);  \
+  template bool doSegmentsIntersect(const pair<Coord, Coord> &, const pair<Coord, Coord> &,                   \
+                                    const pair<Coord, Coord> &, const pair<Coord, Coord> &);                  \
+  template bool isCounterClockwise(const vector<pair<Coord, Coord>> &);
+
+DCEL_INSTANTIATE_PREDICATES(int32_t)
+DCEL_INSTANTIATE_PREDICATES(int64_t)
+DCEL_INSTANTIATE_PREDICATES(double)
+
+#undef DCEL_INSTANTIATE_PREDICATES
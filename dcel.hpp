@@ -13,6 +13,7 @@
 
 #include <iostream>
 #include <memory>
+#include <cstddef>
 #include <vector>
 #include <map>
 #include <algorithm>
@@ -22,21 +23,49 @@
 #include <stdexcept>
 #include <string>
 #include <sstream>
-#include <unordered_map>
+#include <atomic>
+#include <limits>
+
+#include "arena.hpp"
+#include "edge_table.hpp"
+#include "face_attributes.hpp"
+#include "holes.hpp"
+#include "mesh.hpp"
+#include "output_writer.hpp"
+#include "stats.hpp"
+#include "thread_pool.hpp"
 
 using namespace std;
 
-class Vertex;
-class HalfEdge;
-class Face;
-
-// ---------- Classe Vertex ----------
-class Vertex {
+// Os elementos da DCEL são parametrizados pelo tipo da coordenada (Coord:
+// int32_t, int64_t ou double) e pelo tipo dos ids (Index: uint32_t ou
+// uint64_t). Vertex, HalfEdge, Face e DCEL são a instanciação geral
+// (double, size_t), usada pela sobreposição, que cria vértices fracionários
+// nas interseções. A edição só cria vértices inteiros e usa (int64_t, size_t)
+// (mesh_editor.hpp); para só construir e imprimir uma malha lida da entrada,
+// BasicDCEL<int32_t, uint32_t> basta e ocupa menos por vértice.
+template <class Coord, class Index> class BasicVertex;
+template <class Coord, class Index> class BasicHalfEdge;
+template <class Coord, class Index> class BasicFace;
+template <class Coord, class Index> class BasicDCEL;
+
+using Vertex = BasicVertex<double, size_t>;
+using HalfEdge = BasicHalfEdge<double, size_t>;
+using Face = BasicFace<double, size_t>;
+using DCEL = BasicDCEL<double, size_t>;
+
+// ---------- Classe BasicVertex ----------
+template <class Coord, class Index>
+class BasicVertex {
 public:
-  double x, y;
-  shared_ptr<HalfEdge> incidentEdge;
+  using coord_type = Coord;
+  using index_type = Index;
+
+  Coord x, y;
+  BasicHalfEdge<Coord, Index>* incidentEdge = nullptr;
+  Index id = 0; // posição em DCEL::vertices
 
-  Vertex(double x = 0, double y = 0) : x(x), y(y) {}
+  BasicVertex(Coord x = 0, Coord y = 0) : x(x), y(y) {}
 
   void print() const {
     cout << "Vertex(" << x << ", " << y << ")";
@@ -48,14 +77,16 @@ public:
   }
 };
 
-// ---------- Classe HalfEdge ----------
-class HalfEdge {
+// ---------- Classe BasicHalfEdge ----------
+template <class Coord, class Index>
+class BasicHalfEdge {
 public:
-  shared_ptr<Vertex> origin;
-  shared_ptr<HalfEdge> twin;
-  shared_ptr<HalfEdge> next;
-  shared_ptr<HalfEdge> prev;
-  shared_ptr<Face> incidentFace;
+  BasicVertex<Coord, Index>* origin = nullptr;
+  BasicHalfEdge* twin = nullptr;
+  BasicHalfEdge* next = nullptr;
+  BasicHalfEdge* prev = nullptr;
+  BasicFace<Coord, Index>* incidentFace = nullptr;
+  Index id = 0; // posição em DCEL::halfEdges
 
   void print() const {
     cout << "HalfEdge from ";
@@ -72,10 +103,40 @@ public:
   }
 };
 
-// ---------- Classe Face ----------
-class Face {
+// ---------- Classe BasicFace ----------
+// Os atributos geométricos (área, orientação, retângulo envolvente, centróide
+// e número de vértices) são calculados no primeiro acesso, percorrendo o
+// ciclo de outerComponent, e ficam guardados até invalidateAttributes().
+// Quem altera o ciclo ou move um vértice dele tem de invalidar a face.
+// O cálculo sob demanda não é sincronizado: antes de ler as faces em
+// paralelo, BasicDCEL::computeFaceAttributes preenche todas numa passada.
+// Os componentes internos (buracos: ciclos externos de componentes conexos
+// contidos na face) ficam num vetor recortado da arena, uma semi-aresta por
+// ciclo; os atributos são só os do ciclo externo.
+template <class Coord, class Index>
+class BasicFace {
 public:
-  shared_ptr<HalfEdge> outerComponent;
+  BasicHalfEdge<Coord, Index>* outerComponent = nullptr;
+  BasicHalfEdge<Coord, Index>** innerComponents = nullptr;
+  Index innerCount = 0;
+  Index id = 0; // posição em DCEL::faces
+
+  const FaceAttributes<Coord>& attributes() const {
+    if (!attributesValid) {
+      FaceAttributesBuilder<Coord> builder;
+      if (const BasicHalfEdge<Coord, Index>* he = outerComponent) {
+        do {
+          builder.add(he->origin->x, he->origin->y);
+          he = he->next;
+        } while (he != outerComponent);
+      }
+      cachedAttributes = builder.finish();
+      attributesValid = true;
+    }
+    return cachedAttributes;
+  }
+
+  void invalidateAttributes() { attributesValid = false; }
 
   void print() const {
     cout << "Face: outerComponent starts at ";
@@ -85,51 +146,223 @@ public:
     else
       cout << "NULL";
   }
+
+private:
+  mutable FaceAttributes<Coord> cachedAttributes;
+  mutable bool attributesValid = false;
 };
 
-// ---------- Classe DCEL ----------
-class DCEL {
+// ---------- Classe BasicDCEL ----------
+// Os elementos são recortados de uma arena própria, dimensionada pelas
+// contagens da entrada; os ponteiros entre eles são crus e a destruição
+// devolve a arena inteira de uma vez (sem ciclos de contagem de referência).
+template <class Coord, class Index>
+class BasicDCEL {
 public:
-  vector<shared_ptr<Vertex>> vertices;
-  vector<shared_ptr<HalfEdge>> halfEdges;
-  vector<shared_ptr<Face>> faces;
+  using coord_type = Coord;
+  using index_type = Index;
+  using Vertex = BasicVertex<Coord, Index>;
+  using HalfEdge = BasicHalfEdge<Coord, Index>;
+  using Face = BasicFace<Coord, Index>;
+
+  vector<Vertex*> vertices;
+  vector<HalfEdge*> halfEdges;
+  vector<Face*> faces;
+
+  BasicDCEL() = default;
+
+  // A arena é dona dos elementos: a DCEL pode ser movida, mas não copiada
+  BasicDCEL(const BasicDCEL&) = delete;
+  BasicDCEL& operator=(const BasicDCEL&) = delete;
+  BasicDCEL(BasicDCEL&&) = default;
+  BasicDCEL& operator=(BasicDCEL&&) = default;
+
+  /**
+   * Verifica se as contagens da malha cabem nos ids desta instanciação
+   * @param numVertices Número de vértices
+   * @param numHalfEdges Número de semi-arestas (soma dos tamanhos das faces)
+   * @param numFaces Número de faces
+   * @return true se todos os ids são representáveis em Index
+   */
+  static bool fits(size_t numVertices, size_t numHalfEdges, size_t numFaces) {
+    size_t limit = static_cast<size_t>(numeric_limits<Index>::max());
+    return numVertices <= limit && numHalfEdges <= limit && numFaces <= limit;
+  }
+
+  /**
+   * Constrói a DCEL a partir de uma malha válida
+   * @param vertexCoords Coordenadas dos vértices
+   * @param faceVertices Ciclos da entrada (CSR)
+   * @param holes Buracos já atribuídos (ver assignHoles); nulo = calcular aqui
+   * @param pool Pool para construir em paralelo (nulo = sequencial); a
+   *             numeração e a saída são as mesmas da construção sequencial
+   */
+  void buildFromMesh(const vector<pair<int, int>>& vertexCoords, const FaceList& faceVertices,
+                     const HoleAssignment* holes = nullptr, ThreadPool* pool = nullptr) {
+    if (!fits(vertexCoords.size(), faceVertices.totalIndices(), faceVertices.size())) {
+      throw length_error("Malha grande demais para ids de " + to_string(8 * sizeof(Index)) + " bits");
+    }
+
+    // Os buracos têm fase própria nas estatísticas, fora da construção
+    HoleAssignment computed;
+    if (!holes) {
+      assignHoles(vertexCoords, faceVertices, computed);
+      holes = &computed;
+    }
+    STATS_TIMER(STATS_BUILD);
 
-  DCEL() = default;
+    // 0. Reservar arena e vetores a partir das contagens (V, soma dos tamanhos das faces, F, buracos)
+    reserveFor(vertexCoords.size(), faceVertices.totalIndices(), faceVertices.size(), holes->holes);
+
+    // NONE e DUPLICATE da tabela de gêmeas não podem ser índices de semi-aresta
+    if (pool && faceVertices.totalIndices() < ConcurrentEdgeTable<Index>::DUPLICATE) {
+      buildParallel(vertexCoords, faceVertices, *holes, pool);
+      return;
+    }
 
-  void buildFromMesh(const vector<pair<int, int>>& vertexCoords, const vector<vector<int>>& faceVertices) {
     // 1. Criar vértices a partir das coordenadas
     createVertices(vertexCoords);
     
-    // 2. Criar semi-arestas e faces a partir da lista de vértices das faces
-    createHalfEdgesAndFaces(faceVertices);
-    
-    // 3. Configurar arestas incidentes para os vértices
-    setupVertexIncidentEdges();
+    // 2. Criar semi-arestas e faces a partir da lista de vértices das faces, ligando
+    //    as gêmeas e as arestas incidentes dos vértices na mesma passada (O(E))
+    createHalfEdgesAndFaces(faceVertices, *holes);
+  }
+
+  /**
+   * Memória reservada pela arena dos elementos
+   * @return Total em bytes
+   */
+  size_t arenaBytes() const { return arena.capacity(); }
+
+  /**
+   * Calcula os atributos de todas as faces que ainda não os têm, numa passada
+   * paralela pelos ciclos (cada face é percorrida por uma única thread)
+   * @param pool Pool para dividir as faces entre threads (nulo = sequencial)
+   */
+  void computeFaceAttributes(ThreadPool* pool = nullptr) const {
+    STATS_TIMER(STATS_FACE_ATTRIBUTES);
+    size_t grain = pool ? max<size_t>(1024, faces.size() / (8 * pool->size())) : faces.size();
+    parallelFor(pool, 0, faces.size(), grain, [&](size_t lo, size_t hi) {
+      for (size_t f = lo; f < hi; ++f) faces[f]->attributes();
+    });
+  }
+
+// ======================================================================================================================= //
+
+  // Criação e remoção de elementos isolados (usadas na edição incremental).
+  // Os novos elementos vão para o fim do vetor; a remoção troca o elemento
+  // com o último e atualiza o id, em O(1). A memória removida só volta
+  // com a arena, na destruição da DCEL.
+
+  Vertex* addVertex(Coord x, Coord y) {
+    Vertex* v = arena.create<Vertex>(x, y);
+    v->id = vertices.size();
+    vertices.push_back(v);
+    return v;
+  }
+
+  HalfEdge* addHalfEdge() {
+    HalfEdge* he = arena.create<HalfEdge>();
+    he->id = halfEdges.size();
+    halfEdges.push_back(he);
+    return he;
   }
 
+  Face* addFace() {
+    Face* f = arena.create<Face>();
+    f->id = faces.size();
+    faces.push_back(f);
+    return f;
+  }
+
+  // Componentes internos de uma face criada por addFace, copiados para um vetor da arena
+  void setInnerComponents(Face* f, const vector<HalfEdge*>& inner) {
+    f->innerComponents = nullptr;
+    f->innerCount = static_cast<Index>(inner.size());
+    if (inner.empty()) return;
+    void* memory = arena.allocate(inner.size() * sizeof(HalfEdge*), alignof(HalfEdge*));
+    f->innerComponents = static_cast<HalfEdge**>(memory);
+    copy(inner.begin(), inner.end(), f->innerComponents);
+  }
+
+  void removeVertex(Vertex* v) { swapAndPop(vertices, v); }
+  void removeHalfEdge(HalfEdge* he) { swapAndPop(halfEdges, he); }
+  void removeFace(Face* f) { swapAndPop(faces, f); }
+
 private:
+  Arena arena;
+
+  template <class T>
+  static void swapAndPop(vector<T*>& items, T* item) {
+    size_t i = item->id;
+    items[i] = items.back();
+    items[i]->id = i;
+    items.pop_back();
+  }
+
+// ======================================================================================================================= //
+
+  void reserveFor(size_t numVertices, size_t numHalfEdges, size_t numFaces, size_t numHoles) {
+    arena.reserve(numVertices * sizeof(Vertex) + numHalfEdges * sizeof(HalfEdge) + numFaces * sizeof(Face) +
+                  numHoles * (sizeof(HalfEdge*) + alignof(HalfEdge*)) + 3 * alignof(max_align_t));
+    vertices.reserve(vertices.size() + numVertices);
+    halfEdges.reserve(halfEdges.size() + numHalfEdges);
+    faces.reserve(faces.size() + numFaces);
+  }
+
 // ======================================================================================================================= //
 
   void createVertices(const vector<pair<int, int>>& vertexCoords) {
     // Cria objetos vértice a partir dos pares de coordenadas
     for (const auto& coord : vertexCoords) {
-      auto vertex = make_shared<Vertex>(coord.first, coord.second);
+      Vertex* vertex = arena.create<Vertex>(coord.first, coord.second);
+      vertex->id = vertices.size();
       vertices.push_back(vertex);
     }
   }
 
 // ======================================================================================================================= //
 
-  void createHalfEdgesAndFaces(const vector<vector<int>>& faceVertices) {
-    // Mapa para controlar arestas e encontrar gêmeas (v1,v2) -> semi-aresta
-    map<pair<int, int>, shared_ptr<HalfEdge>> edgeMap;
+  void createHalfEdgesAndFaces(const FaceList& faceVertices, const HoleAssignment& holes) {
+    // Tabela para encontrar gêmeas (v1,v2) -> semi-aresta ainda sem par (nulo depois de pareada)
+    EdgeTable<HalfEdge*> edgeTable(faceVertices.totalIndices());
+
+    // As faces são os ciclos que não são buracos, na ordem da entrada; cada
+    // buraco vai para a face que o contém. Sem buracos, cada face é criada
+    // junto das suas semi-arestas, como antes
+    vector<size_t> cycleFace;
+    size_t first = faces.size();
+    if (holes.holes > 0) {
+      size_t numFaces = numberFaces(holes, faceVertices.size(), cycleFace);
+      vector<Index> innerTotal(numFaces, 0);
+      for (size_t c = 0; c < faceVertices.size(); c++) {
+        if (holes.isHole(c)) innerTotal[cycleFace[c]]++;
+      }
+      for (size_t f = 0; f < numFaces; f++) {
+        Face* face = arena.create<Face>();
+        face->id = faces.size();
+        faces.push_back(face);
+        if (innerTotal[f] > 0) {
+          void* memory = arena.allocate(innerTotal[f] * sizeof(HalfEdge*), alignof(HalfEdge*));
+          face->innerComponents = static_cast<HalfEdge**>(memory);
+        }
+      }
+    }
     
-    // Processa cada face da entrada
-    for (const auto& faceVerts : faceVertices) {
-      auto face = make_shared<Face>();
-      faces.push_back(face);
+    // Processa cada ciclo da entrada
+    for (size_t c = 0; c < faceVertices.size(); c++) {
+      FaceView faceVerts = faceVertices[c];
+      Face* face;
+      if (holes.holes > 0) {
+        face = faces[first + cycleFace[c]];
+      } else {
+        face = arena.create<Face>();
+        face->id = faces.size();
+        faces.push_back(face);
+      }
       
-      vector<shared_ptr<HalfEdge>> faceEdges;
+      // As semi-arestas da face ficam contíguas em halfEdges a partir de base
+      size_t base = halfEdges.size();
       int n = faceVerts.size();
       
       // Cria semi-arestas para cada aresta da face
@@ -138,96 +371,234 @@ private:
         int v2 = faceVerts[(i + 1) % n]; // Índice do vértice final
         
         // Cria nova semi-aresta
-        auto he = make_shared<HalfEdge>();
+        HalfEdge* he = arena.create<HalfEdge>();
         he->origin = vertices[v1];  // Define vértice de origem
         he->incidentFace = face;    // Define face incidente
+        he->id = halfEdges.size();
         
         halfEdges.push_back(he);
-        faceEdges.push_back(he);
+
+        // A aresta incidente do vértice é a primeira semi-aresta criada com origem nele
+        if (!he->origin->incidentEdge) {
+          he->origin->incidentEdge = he;
+        }
         
-        // Verifica se existe aresta gêmea no mapa
-        auto twinKey = make_pair(v2, v1);
-        if (edgeMap.count(twinKey)) {
+        // Verifica se existe aresta gêmea ainda sem par
+        HalfEdge** pending = edgeTable.find(EdgeTable<HalfEdge*>::key(v2, v1));
+        if (pending && *pending) {
           // Conecta as gêmeas se encontrada
-          he->twin = edgeMap[twinKey];
-          edgeMap[twinKey]->twin = he;
-          edgeMap.erase(twinKey);
+          he->twin = *pending;
+          (*pending)->twin = he;
+          *pending = nullptr;
         } else {
-          // Armazena no mapa se não encontrou gêmea ainda
-          edgeMap[make_pair(v1, v2)] = he;
+          // Armazena na tabela se não encontrou gêmea ainda
+          bool inserted;
+          edgeTable.findOrInsert(EdgeTable<HalfEdge*>::key(v1, v2), inserted) = he;
         }
       }
         
       // Conecta ponteiros next e prev para as semi-arestas da face
       for (int i = 0; i < n; i++) {
-        faceEdges[i]->next = faceEdges[(i + 1) % n];
-        faceEdges[i]->prev = faceEdges[(i - 1 + n) % n];
+        halfEdges[base + i]->next = halfEdges[base + (i + 1) % n];
+        halfEdges[base + i]->prev = halfEdges[base + (i - 1 + n) % n];
       }
       
-      // Define componente externa da face como a primeira semi-aresta
-      face->outerComponent = faceEdges[0];
+      // A primeira semi-aresta do ciclo é o componente externo da face ou, num
+      // buraco, o próximo componente interno da face que o contém
+      HalfEdge* start = n > 0 ? halfEdges[base] : nullptr;
+      if (holes.isHole(c)) {
+        face->innerComponents[face->innerCount++] = start;
+      } else {
+        face->outerComponent = start;
+      }
     }
     
     // Verifica arestas não pareadas (não deve acontecer em malha válida)
-    if (!edgeMap.empty()) {
-        cerr << "Aviso: " << edgeMap.size() << " arestas não pareadas!" << endl;
+    size_t unmatched = 0;
+    edgeTable.forEach([&](uint64_t, HalfEdge* he) { unmatched += he != nullptr; });
+    if (unmatched > 0) {
+        cerr << "Aviso: " << unmatched << " arestas não pareadas!" << endl;
     }
   }
 
-  void setupVertexIncidentEdges() {
-    // Define aresta incidente para cada vértice (primeira semi-aresta onde o vértice é origem)
-    for (const auto& v : vertices) {
-      for (const auto& he : halfEdges) {
-        if (he->origin == v) {
-          v->incidentEdge = he;
-          break;
+// ======================================================================================================================= //
+
+  // Construção paralela. As faces são divididas entre as threads; os
+  // elementos de cada tipo são recortados da arena num bloco só e
+  // construídos no lugar, e as semi-arestas do ciclo c ocupam as posições
+  // offsets[c].. do CSR da entrada (a soma de prefixos dos tamanhos), de modo
+  // que next, prev, origem e face são escritos sem sincronização. As gêmeas
+  // saem de uma ConcurrentEdgeTable, e a aresta incidente de cada vértice é
+  // a semi-aresta de menor índice que sai dele (mínimo atômico), a mesma que
+  // a construção sequencial cria primeiro. Numa malha com arestas repetidas
+  // o pareamento sequencial depende da ordem, e as gêmeas são refeitas por
+  // ele.
+  void buildParallel(const vector<pair<int, int>>& vertexCoords, const FaceList& faceVertices,
+                     const HoleAssignment& holes, ThreadPool* pool) {
+    size_t numVertices = vertexCoords.size(), numHalfEdges = faceVertices.totalIndices();
+    size_t numCycles = faceVertices.size();
+    vector<size_t> cycleFace;
+    size_t numFaces = holes.holes > 0 ? numberFaces(holes, numCycles, cycleFace) : numCycles;
+
+    size_t vertexBase = vertices.size(), edgeBase = halfEdges.size(), faceBase = faces.size();
+    Vertex* vertexBlock = static_cast<Vertex*>(arena.allocate(numVertices * sizeof(Vertex), alignof(Vertex)));
+    HalfEdge* edgeBlock = static_cast<HalfEdge*>(arena.allocate(numHalfEdges * sizeof(HalfEdge), alignof(HalfEdge)));
+    Face* faceBlock = static_cast<Face*>(arena.allocate(numFaces * sizeof(Face), alignof(Face)));
+    vertices.resize(vertexBase + numVertices);
+    halfEdges.resize(edgeBase + numHalfEdges);
+    faces.resize(faceBase + numFaces);
+
+    // Vértices e faces, com a menor semi-aresta de cada vértice ainda por achar
+    unique_ptr<atomic<Index>[]> firstEdge(new atomic<Index>[numVertices]);
+    size_t vertexGrain = max<size_t>(4096, numVertices / (8 * pool->size()));
+    parallelFor(pool, 0, numVertices, vertexGrain, [&](size_t lo, size_t hi) {
+      for (size_t v = lo; v < hi; v++) {
+        Vertex* vertex = new (vertexBlock + v) Vertex(vertexCoords[v].first, vertexCoords[v].second);
+        vertex->id = vertexBase + v;
+        vertices[vertexBase + v] = vertex;
+        firstEdge[v].store(ConcurrentEdgeTable<Index>::NONE, memory_order_relaxed);
+      }
+    });
+    size_t faceGrain = max<size_t>(4096, numFaces / (8 * pool->size()));
+    parallelFor(pool, 0, numFaces, faceGrain, [&](size_t lo, size_t hi) {
+      for (size_t f = lo; f < hi; f++) {
+        Face* face = new (faceBlock + f) Face();
+        face->id = faceBase + f;
+        faces[faceBase + f] = face;
+      }
+    });
+
+    // Semi-arestas, ciclo a ciclo: cada thread escreve só as do seu bloco de ciclos
+    ConcurrentEdgeTable<Index> edgeTable(numHalfEdges, pool);
+    atomic<bool> repeated{false};
+    size_t cycleGrain = max<size_t>(1024, numCycles / (8 * pool->size()));
+    parallelFor(pool, 0, numCycles, cycleGrain, [&](size_t lo, size_t hi) {
+      bool localRepeated = false;
+      for (size_t c = lo; c < hi; c++) {
+        FaceView faceVerts = faceVertices[c];
+        size_t base = faceVertices.offsets[c];
+        size_t n = faceVerts.size();
+        Face* face = faceBlock + (holes.holes > 0 ? cycleFace[c] : c);
+        for (size_t i = 0; i < n; i++) {
+          HalfEdge* he = new (edgeBlock + base + i) HalfEdge();
+          he->origin = vertexBlock + faceVerts[i];
+          he->incidentFace = face;
+          he->next = edgeBlock + base + (i + 1) % n;
+          he->prev = edgeBlock + base + (i + n - 1) % n;
+          he->id = edgeBase + base + i;
+          halfEdges[edgeBase + base + i] = he;
+          atomicMin(firstEdge[faceVerts[i]], Index(base + i));
+          localRepeated |= !edgeTable.insert(faceVerts[i], faceVerts[(i + 1) % n], base + i);
+        }
+        if (n > 0 && !holes.isHole(c)) face->outerComponent = edgeBlock + base;
+      }
+      if (localRepeated) repeated.store(true, memory_order_relaxed);
+    });
+
+    parallelFor(pool, 0, numVertices, vertexGrain, [&](size_t lo, size_t hi) {
+      for (size_t v = lo; v < hi; v++) {
+        Index h = firstEdge[v].load(memory_order_relaxed);
+        if (h != ConcurrentEdgeTable<Index>::NONE) vertexBlock[v].incidentEdge = edgeBlock + h;
+      }
+    });
+
+    // Componentes internos na ordem dos ciclos, como na construção sequencial
+    if (holes.holes > 0) {
+      vector<Index> innerTotal(numFaces, 0);
+      for (size_t c = 0; c < numCycles; c++) {
+        if (holes.isHole(c)) innerTotal[cycleFace[c]]++;
+      }
+      for (size_t f = 0; f < numFaces; f++) {
+        if (innerTotal[f] == 0) continue;
+        void* memory = arena.allocate(innerTotal[f] * sizeof(HalfEdge*), alignof(HalfEdge*));
+        faceBlock[f].innerComponents = static_cast<HalfEdge**>(memory);
+      }
+      for (size_t c = 0; c < numCycles; c++) {
+        if (!holes.isHole(c)) continue;
+        Face* face = faceBlock + cycleFace[c];
+        HalfEdge* start = faceVertices[c].size() > 0 ? edgeBlock + faceVertices.offsets[c] : nullptr;
+        face->innerComponents[face->innerCount++] = start;
+      }
+    }
+
+    size_t unmatched = 0;
+    if (!repeated.load(memory_order_relaxed)) {
+      // Sem repetição, cada aresta tem no máximo uma semi-aresta por sentido
+      atomic<size_t> lonely{0};
+      edgeTable.forEach(pool, [&](Index forward, Index backward) {
+        if (forward != ConcurrentEdgeTable<Index>::NONE && backward != ConcurrentEdgeTable<Index>::NONE) {
+          edgeBlock[forward].twin = edgeBlock + backward;
+          edgeBlock[backward].twin = edgeBlock + forward;
+        } else {
+          lonely.fetch_add(1, memory_order_relaxed);
+        }
+      });
+      unmatched = lonely.load(memory_order_relaxed);
+    } else {
+      // Mesmo pareamento da passada sequencial, na ordem das semi-arestas
+      EdgeTable<HalfEdge*> pending(numHalfEdges);
+      for (size_t h = 0; h < numHalfEdges; h++) {
+        HalfEdge* he = edgeBlock + h;
+        int v1 = he->origin - vertexBlock, v2 = he->next->origin - vertexBlock;
+        HalfEdge** other = pending.find(EdgeTable<HalfEdge*>::key(v2, v1));
+        if (other && *other) {
+          he->twin = *other;
+          (*other)->twin = he;
+          *other = nullptr;
+        } else {
+          bool inserted;
+          pending.findOrInsert(EdgeTable<HalfEdge*>::key(v1, v2), inserted) = he;
         }
       }
+      pending.forEach([&](uint64_t, HalfEdge* he) { unmatched += he != nullptr; });
+    }
+
+    // Verifica arestas não pareadas (não deve acontecer em malha válida)
+    if (unmatched > 0) {
+      cerr << "Aviso: " << unmatched << " arestas não pareadas!" << endl;
     }
   }
 
 // ======================================================================================================================= //
 
 public:
-  void printDCELOutput() const {
-    // Cria mapeamentos de índices baseados em 1 para todos os elementos
-    unordered_map<shared_ptr<Vertex>, size_t> vertexIndices;
-    unordered_map<shared_ptr<HalfEdge>, size_t> halfEdgeIndices;
-    unordered_map<shared_ptr<Face>, size_t> faceIndices;
-    
-    // Preenche os mapeamentos de índices na ordem de armazenamento
-    for (size_t i = 0; i < vertices.size(); i++) {
-      vertexIndices[vertices[i]] = i + 1;
-    }
-    for (size_t i = 0; i < faces.size(); i++) {
-      faceIndices[faces[i]] = i + 1;
-    }
-    for (size_t i = 0; i < halfEdges.size(); i++) {
-      halfEdgeIndices[halfEdges[i]] = i + 1;
-    }
-    
-    // 1. Primeira linha: contagem de vértices, arestas (semi-arestas/2), faces
-    cout << vertices.size() << " " << (halfEdges.size() / 2) << " " << faces.size() << endl;
-    
-    // 2. Seção de vértices: x y índice_da_semi-aresta_incidente
-    for (const auto& v : vertices) {
-      cout << static_cast<int>(v->x) << " " << static_cast<int>(v->y) << " ";
-      cout << (v->incidentEdge ? halfEdgeIndices.at(v->incidentEdge) : 0) << endl;
-    }
-    
-    // 3. Seção de faces: índice_da_semi-aresta_do_componente_externo
-    for (const auto& f : faces) {
-      cout << (f->outerComponent ? halfEdgeIndices.at(f->outerComponent) : 0) << endl;
-    }
-    
-    // 4. Seção de semi-arestas: origem gêmea face_esquerda próxima anterior
-    for (const auto& he : halfEdges) {
-      cout << vertexIndices.at(he->origin) << " ";
-      cout << (he->twin ? halfEdgeIndices.at(he->twin) : 0) << " ";
-      cout << faceIndices.at(he->incidentFace) << " ";
-      cout << (he->next ? halfEdgeIndices.at(he->next) : 0) << " ";
-      cout << (he->prev ? halfEdgeIndices.at(he->prev) : 0) << endl;
-    }
+  /**
+   * Imprime a DCEL na saída padrão no formato requerido
+   * @param pool Pool para formatar a seção de semi-arestas em paralelo (pode ser nulo)
+   */
+  void printDCELOutput(ThreadPool* pool = nullptr) const {
+    OutputWriter out(1);
+    printDCELOutput(out, pool);
+    out.flush();
+  }
+
+  /**
+   * Escreve a DCEL no formato requerido; os índices vêm do campo id de cada
+   * elemento (base 1 na saída, 0 para ponteiro nulo)
+   * @param out Destino
+   * @param pool Pool para formatar a seção de semi-arestas em paralelo (pode ser nulo)
+   */
+  void printDCELOutput(OutputWriter& out, ThreadPool* pool = nullptr) const {
+    auto edgeOut = [](const HalfEdge* he) -> uint64_t { return he ? uint64_t(he->id) + 1 : 0; };
+
+    writeDCELText(
+        out, vertices.size(), halfEdges.size(), faces.size(),
+        [&](size_t v) {
+          const Vertex& vertex = *vertices[v];
+          return VertexLine{static_cast<long long>(vertex.x), static_cast<long long>(vertex.y),
+                            edgeOut(vertex.incidentEdge)};
+        },
+        [&](size_t f) { return edgeOut(faces[f]->outerComponent); },
+        [&](size_t f, const auto& emit) {
+          const Face& face = *faces[f];
+          for (Index i = 0; i < face.innerCount; i++) emit(edgeOut(face.innerComponents[i]));
+        },
+        [&](size_t h) {
+          const HalfEdge& he = *halfEdges[h];
+          return array<uint64_t, 5>{uint64_t(he.origin->id) + 1, edgeOut(he.twin),
+                                    uint64_t(he.incidentFace->id) + 1, edgeOut(he.next), edgeOut(he.prev)};
+        },
+        pool);
   }
 };
 
@@ -236,20 +607,40 @@ public:
 /**
  * Verifica se a malha é topologicamente válida (bem formada)
  * @param verticesCoords Vetor de coordenadas (x,y) dos vértices
- * @param faces Vetor de faces, cada face é um vetor de índices de vértices
+ * @param faces Faces (CSR), cada face é uma lista de índices de vértices
  * @param errorMessage Mensagem de erro de saída caso a malha seja inválida
+ * @param threads Número de threads da validação geométrica (1 = sequencial)
  * @return true se a malha for válida, false caso contrário
  */
-bool checkMesh(const vector<pair<int, int>> &verticesCoords, const vector<vector<int>> &faces, string &errorMessage);
+bool checkMesh(const vector<pair<int, int>> &verticesCoords, const FaceList &faces, string &errorMessage, unsigned threads = 1);
 
 /**
  * Verifica se há faces contidas dentro de outras faces
  * @param verticesCoords Vetor de coordenadas (x,y) dos vértices
- * @param faces Vetor de faces, cada face é um vetor de índices de vértices
+ * @param faces Faces (CSR), cada face é uma lista de índices de vértices
  * @param errorMessage Mensagem de erro de saída caso encontre sobreposição
- * @return true se não houver faces contidas em outras, false caso contrário
+ * @param pool Pool para dividir as faces entre threads (nulo = sequencial)
+ * @param cancel Sinal de cancelamento externo, consultado entre faces (pode ser nulo)
+ * @param attributes Atributos das faces já calculados (computeFaceAttributes); se nulo, são
+ *                   calculados aqui, o que espera o pool inteiro antes do teste das faces
+ * @param components Componentes conexos (findComponents); se nulo, são calculados aqui.
+ *                   Vértices de outro componente dentro de uma face anti-horária são um
+ *                   componente interno dela, não sobreposição; toques na borda entre
+ *                   componentes são interseções de arestas, achadas por isOverlapping
+ * @return true se houver ponto na borda ou no interior de outra face, false caso contrário
  */
-bool checkInside(const vector<pair<int, int>> &verticesCoords, const vector<vector<int>> &faces, string &errorMessage);
+bool checkInside(const vector<pair<int, int>> &verticesCoords, const FaceList &faces, string &errorMessage,
+                 ThreadPool *pool = nullptr, const atomic<bool> *cancel = nullptr,
+                 const vector<FaceAttributes<int>> *attributes = nullptr,
+                 const MeshComponents *components = nullptr);
+
+// Os predicados de ponto, segmento e polígono (isPointOnPolygonBorder,
+// isPointInsidePolygon, orientation, onSegment, doSegmentsIntersect e
+// isCounterClockwise) são modelos sobre o tipo da coordenada, instanciados em
+// dcel.cpp para int32_t, int64_t e double; a orientação exata de cada tipo é
+// escolhida em tempo de compilação (ver orient2d em predicates.hpp). As
+// validações da malha inteira trabalham sobre as coordenadas lidas da
+// entrada, que são de 32 bits.
 
 /**
  * Verifica se um ponto está exatamente na borda de um polígono
@@ -257,7 +648,8 @@ bool checkInside(const vector<pair<int, int>> &verticesCoords, const vector<vect
  * @param polygon Vetor de pontos que formam o polígono
  * @return true se o ponto está na borda, false caso contrário
  */
-bool isPointOnPolygonBorder(const pair<int, int> &pt, const vector<pair<int, int>> &polygon);
+template <class Coord>
+bool isPointOnPolygonBorder(const pair<Coord, Coord> &pt, const vector<pair<Coord, Coord>> &polygon);
 
 /**
  * Verifica se um ponto está dentro de um polígono (usando ray casting)
@@ -265,15 +657,16 @@ bool isPointOnPolygonBorder(const pair<int, int> &pt, const vector<pair<int, int
  * @param polygon Vetor de pontos que formam o polígono
  * @return true se o ponto está dentro, false caso contrário
  */
-bool isPointInsidePolygon(const pair<int, int> &pt, const vector<pair<int, int>> &polygon);
+template <class Coord>
+bool isPointInsidePolygon(const pair<Coord, Coord> &pt, const vector<pair<Coord, Coord>> &polygon);
 
 /**
  * Valida as arestas da malha verificando consistência topológica
- * @param faces Vetor de faces da malha
+ * @param faces Faces da malha (CSR)
  * @param errorMessage Mensagem de erro de saída caso encontre problemas
  * @return 1 se válido, -1 para malha aberta, -2 para não-subdivisão planar
  */
-int ValidateEdges(const vector<vector<int>> &faces, string &errorMessage);
+int ValidateEdges(const FaceList &faces, string &errorMessage);
 
 /**
  * Calcula a orientação de três pontos (clockwise/counter-clockwise/collinear)
@@ -282,7 +675,8 @@ int ValidateEdges(const vector<vector<int>> &faces, string &errorMessage);
  * @param r Terceiro ponto
  * @return 0 para colineares, 1 para clockwise, 2 para counter-clockwise
  */
-int orientation(const pair<int, int> &p, const pair<int, int> &q, const pair<int, int> &r);
+template <class Coord>
+int orientation(const pair<Coord, Coord> &p, const pair<Coord, Coord> &q, const pair<Coord, Coord> &r);
 
 /**
  * Verifica se um ponto está em um segmento de reta
@@ -291,29 +685,43 @@ int orientation(const pair<int, int> &p, const pair<int, int> &q, const pair<int
  * @param p Ponto a ser verificado
  * @return true se o ponto está no segmento, false caso contrário
  */
-bool onSegment(const pair<int, int> &a, const pair<int, int> &b, const pair<int, int> &p);
+template <class Coord>
+bool onSegment(const pair<Coord, Coord> &a, const pair<Coord, Coord> &b, const pair<Coord, Coord> &p);
+
+/**
+ * Verifica se os segmentos p1q1 e p2q2 se intersectam (incluindo toque e sobreposição colinear)
+ * @param p1 Ponto inicial do primeiro segmento
+ * @param q1 Ponto final do primeiro segmento
+ * @param p2 Ponto inicial do segundo segmento
+ * @param q2 Ponto final do segundo segmento
+ * @return true se os segmentos se intersectam, false caso contrário
+ */
+template <class Coord>
+bool doSegmentsIntersect(const pair<Coord, Coord>& p1, const pair<Coord, Coord>& q1, const pair<Coord, Coord>& p2,
+                         const pair<Coord, Coord>& q2);
 
 /**
- * Verifica se há sobreposição entre faces da malha
+ * Verifica se há sobreposição entre arestas da malha (varredura sobre todas as arestas)
  * @param verticesCoords Vetor de coordenadas dos vértices
- * @param faces Vetor de faces da malha
+ * @param faces Faces da malha (CSR)
  * @param errorMessage Mensagem de erro de saída caso encontre sobreposição
  * @return true se houver sobreposição, false caso contrário
  */
-bool isOverlapping(const vector<pair<int, int>> &verticesCoords, const vector<vector<int>> &faces, string &errorMessage);
+bool isOverlapping(const vector<pair<int, int>> &verticesCoords, const FaceList &faces, string &errorMessage);
 
 /**
  * Verifica se os vértices de uma face estão em ordem counter-clockwise
  * @param face Vetor de coordenadas dos vértices da face
  * @return true se estiver em CCW, false caso contrário
  */
-bool isCounterClockwise(const vector<pair<int, int>>& face);
+template <class Coord>
+bool isCounterClockwise(const vector<pair<Coord, Coord>>& face);
 
 /**
  * Imprime a malha para fins de depuração
  * @param verticesCoords Vetor de coordenadas dos vértices
- * @param faces Vetor de faces da malha
+ * @param faces Faces da malha (CSR)
  */
-void debugPrintMesh(const vector<pair<int, int>> &verticesCoords, const vector<vector<int>> &faces);
+void debugPrintMesh(const vector<pair<int, int>> &verticesCoords, const FaceList &faces);
 
 #endif // DCEL_HPP
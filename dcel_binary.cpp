@@ -0,0 +1,322 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "dcel_binary.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+static const char DCEL_BINARY_MAGIC[8] = {'D', 'C', 'E', 'L', 'B', 'I', 'N', '\0'};
+static const uint32_t BINARY_NIL = 0xFFFFFFFFu;
+
+static const uint64_t FNV_OFFSET = 14695981039346656037ull;
+static const uint64_t FNV_PRIME = 1099511628211ull;
+
+// Tamanho do buffer de escrita
+static const size_t WRITE_BUFFER = 1 << 20;
+
+static inline bool hostIsLittleEndian() {
+  const uint32_t probe = 1;
+  unsigned char first;
+  memcpy(&first, &probe, 1);
+  return first == 1;
+}
+
+// Converte entre a ordem do host e little-endian (a operação é a própria inversa)
+static inline uint32_t toLE32(uint32_t v) {
+  return hostIsLittleEndian() ? v : __builtin_bswap32(v);
+}
+
+static inline uint64_t toLE64(uint64_t v) {
+  return hostIsLittleEndian() ? v : __builtin_bswap64(v);
+}
+
+// FNV-1a 64 sobre os bytes, acumulado em `hash`
+static uint64_t fnv1a(uint64_t hash, const unsigned char* data, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    hash ^= data[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+// ======================================================================================================================= //
+
+// Escritor com buffer que acumula o checksum do que passa por ele
+namespace {
+class ChecksumWriter {
+public:
+  explicit ChecksumWriter(FILE* file) : file(file) { buffer.reserve(WRITE_BUFFER); }
+
+  void put32(uint32_t v) {
+    v = toLE32(v);
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(&v);
+    buffer.insert(buffer.end(), p, p + sizeof(v));
+    if (buffer.size() >= WRITE_BUFFER) flush();
+  }
+
+  void flush() {
+    hash = fnv1a(hash, buffer.data(), buffer.size());
+    if (!buffer.empty() && fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+      throw runtime_error("falha ao gravar o arquivo binário");
+    }
+    buffer.clear();
+  }
+
+  uint64_t checksum() const { return hash; }
+
+private:
+  FILE* file;
+  vector<unsigned char> buffer;
+  uint64_t hash = FNV_OFFSET;
+};
+} // namespace
+
+// ======================================================================================================================= //
+
+void saveBinaryDCEL(const CompactDCEL& dcel, const string& path, bool validated) {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file) {
+    throw runtime_error("não foi possível criar " + path);
+  }
+
+  DCELBinaryHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, DCEL_BINARY_MAGIC, sizeof(header.magic));
+  header.version = toLE32(DCEL_BINARY_VERSION);
+  header.endianTag = toLE32(DCEL_BINARY_ENDIAN_TAG);
+  header.numVertices = toLE64(dcel.numVertices());
+  header.numHalfEdges = toLE64(dcel.numHalfEdges());
+  header.numFaces = toLE64(dcel.numFaces());
+  header.flags = toLE32(validated ? DCEL_BINARY_VALIDATED : 0);
+  header.numInner = toLE32(dcel.innerEdges.size());
+
+  try {
+    // O cabeçalho é regravado no fim, já com o checksum
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+      throw runtime_error("falha ao gravar o arquivo binário");
+    }
+
+    ChecksumWriter out(file);
+    for (size_t v = 0; v < dcel.numVertices(); v++) {
+      out.put32(static_cast<uint32_t>(dcel.vx[v]));
+      out.put32(static_cast<uint32_t>(dcel.vy[v]));
+      out.put32(dcel.vertexEdge[v]);
+    }
+    for (size_t f = 0; f < dcel.numFaces(); f++) {
+      out.put32(dcel.faceEdge[f]);
+    }
+    for (size_t h = 0; h < dcel.numHalfEdges(); h++) {
+      out.put32(dcel.origin[h]);
+      out.put32(dcel.twin[h]);
+      out.put32(dcel.face[h]);
+      out.put32(dcel.next[h]);
+      out.put32(dcel.prev[h]);
+    }
+    for (size_t f = 0; f < dcel.numFaces(); f++) {
+      for (size_t i = 0; i < dcel.numInner(f); i++) {
+        out.put32(f);
+        out.put32(dcel.innerEdges[dcel.innerOffsets[f] + i]);
+      }
+    }
+    out.flush();
+
+    header.checksum = toLE64(out.checksum());
+    if (fseek(file, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, file) != 1) {
+      throw runtime_error("falha ao gravar o arquivo binário");
+    }
+  } catch (...) {
+    fclose(file);
+    throw;
+  }
+
+  if (fclose(file) != 0) {
+    throw runtime_error("falha ao gravar o arquivo binário");
+  }
+}
+
+// ======================================================================================================================= //
+
+MappedDCEL::MappedDCEL(const string& path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw runtime_error("não foi possível abrir " + path);
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(DCELBinaryHeader)) {
+    close(fd);
+    throw runtime_error("arquivo binário truncado");
+  }
+
+  mappedSize = st.st_size;
+  base = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    base = nullptr;
+    throw runtime_error("falha ao mapear " + path);
+  }
+
+  try {
+    DCELBinaryHeader header;
+    memcpy(&header, base, sizeof(header));
+
+    if (memcmp(header.magic, DCEL_BINARY_MAGIC, sizeof(header.magic)) != 0) {
+      throw runtime_error("arquivo não é uma DCEL binária");
+    }
+    if (toLE32(header.endianTag) != DCEL_BINARY_ENDIAN_TAG) {
+      throw runtime_error("ordem de bytes do arquivo binário não reconhecida");
+    }
+    uint32_t version = toLE32(header.version);
+    if (version < DCEL_BINARY_MIN_VERSION || version > DCEL_BINARY_VERSION) {
+      throw runtime_error("versão do arquivo binário não suportada");
+    }
+
+    uint64_t v = toLE64(header.numVertices);
+    uint64_t h = toLE64(header.numHalfEdges);
+    uint64_t f = toLE64(header.numFaces);
+    uint64_t i = version >= 2 ? toLE32(header.numInner) : 0;
+    if (v >= BINARY_NIL || h >= BINARY_NIL || f >= BINARY_NIL) {
+      throw runtime_error("contagens inválidas no arquivo binário");
+    }
+
+    size_t payload = v * sizeof(VertexRecord) + f * sizeof(FaceRecord) + h * sizeof(HalfEdgeRecord) +
+                     i * sizeof(InnerRecord);
+    if (mappedSize != sizeof(DCELBinaryHeader) + payload) {
+      throw runtime_error("tamanho do arquivo binário não confere com o cabeçalho");
+    }
+
+    const unsigned char* data = static_cast<const unsigned char*>(base) + sizeof(DCELBinaryHeader);
+    madvise(base, mappedSize, MADV_SEQUENTIAL);
+    if (fnv1a(FNV_OFFSET, data, payload) != toLE64(header.checksum)) {
+      throw runtime_error("checksum do arquivo binário inválido");
+    }
+
+    nv = v;
+    nh = h;
+    nf = f;
+    ni = i;
+    flags = toLE32(header.flags);
+    vertices = reinterpret_cast<const VertexRecord*>(data);
+    faces = reinterpret_cast<const FaceRecord*>(data + nv * sizeof(VertexRecord));
+    halfEdges = reinterpret_cast<const HalfEdgeRecord*>(data + nv * sizeof(VertexRecord) +
+                                                        nf * sizeof(FaceRecord));
+    inner = reinterpret_cast<const InnerRecord*>(data + nv * sizeof(VertexRecord) + nf * sizeof(FaceRecord) +
+                                                 nh * sizeof(HalfEdgeRecord));
+
+    // innerRange faz busca binária pela face: os registros têm de estar em ordem
+    for (size_t k = 0; k < ni; k++) {
+      if (innerFace(k) >= nf || innerEdge(k) >= nh || (k > 0 && innerFace(k) < innerFace(k - 1))) {
+        throw runtime_error("componentes internos inválidos no arquivo binário");
+      }
+    }
+  } catch (...) {
+    munmap(base, mappedSize);
+    base = nullptr;
+    throw;
+  }
+}
+
+MappedDCEL::~MappedDCEL() {
+  if (base) {
+    munmap(base, mappedSize);
+  }
+}
+
+// ======================================================================================================================= //
+
+int32_t MappedDCEL::vertexX(size_t v) const { return static_cast<int32_t>(toLE32(vertices[v].x)); }
+int32_t MappedDCEL::vertexY(size_t v) const { return static_cast<int32_t>(toLE32(vertices[v].y)); }
+uint32_t MappedDCEL::vertexEdge(size_t v) const { return toLE32(vertices[v].edge); }
+uint32_t MappedDCEL::faceEdge(size_t f) const { return toLE32(faces[f].outer); }
+uint32_t MappedDCEL::origin(size_t h) const { return toLE32(halfEdges[h].origin); }
+uint32_t MappedDCEL::twin(size_t h) const { return toLE32(halfEdges[h].twin); }
+uint32_t MappedDCEL::face(size_t h) const { return toLE32(halfEdges[h].face); }
+uint32_t MappedDCEL::next(size_t h) const { return toLE32(halfEdges[h].next); }
+uint32_t MappedDCEL::prev(size_t h) const { return toLE32(halfEdges[h].prev); }
+uint32_t MappedDCEL::innerFace(size_t i) const { return toLE32(inner[i].face); }
+uint32_t MappedDCEL::innerEdge(size_t i) const { return toLE32(inner[i].edge); }
+
+pair<size_t, size_t> MappedDCEL::innerRange(size_t f) const {
+  size_t lo = 0, hi = ni;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (innerFace(mid) < f) lo = mid + 1; else hi = mid;
+  }
+  size_t last = lo;
+  while (last < ni && innerFace(last) == f) last++;
+  return {lo, last};
+}
+
+// ======================================================================================================================= //
+
+Mesh MappedDCEL::toMesh() const {
+  Mesh mesh;
+  mesh.vertices.resize(nv);
+  for (size_t v = 0; v < nv; v++) {
+    mesh.vertices[v] = {vertexX(v), vertexY(v)};
+  }
+
+  // Cada face é o ciclo de next a partir da semi-aresta externa; os buracos
+  // voltam a ser ciclos da malha, depois das faces
+  auto pushCycle = [&](uint32_t start) {
+    uint32_t e = start;
+    size_t steps = 0;
+    while (e < nh && steps++ < nh) {
+      mesh.faces.push(static_cast<int>(origin(e)));
+      e = next(e);
+      if (e == start) break;
+    }
+    mesh.faces.closeFace();
+  };
+  mesh.faces.reserve(nf + ni, nh);
+  for (size_t f = 0; f < nf; f++) {
+    pushCycle(faceEdge(f));
+  }
+  for (size_t i = 0; i < ni; i++) {
+    pushCycle(innerEdge(i));
+  }
+  return mesh;
+}
+
+// ======================================================================================================================= //
+
+void MappedDCEL::printDCELOutput(ThreadPool* pool) const {
+  OutputWriter out(1);
+  printDCELOutput(out, pool);
+  out.flush();
+}
+
+void MappedDCEL::printDCELOutput(OutputWriter& out, ThreadPool* pool) const {
+  // Índices de saída são base 1; ausência vira 0
+  auto idx = [](uint32_t i) -> uint64_t { return i == BINARY_NIL ? 0 : uint64_t(i) + 1; };
+
+  writeDCELText(
+      out, nv, nh, nf,
+      [&](size_t v) { return VertexLine{vertexX(v), vertexY(v), idx(vertexEdge(v))}; },
+      [&](size_t f) { return idx(faceEdge(f)); },
+      [&](size_t f, const auto& emit) {
+        if (ni == 0) return;
+        auto [first, last] = innerRange(f);
+        for (size_t i = first; i < last; i++) emit(idx(innerEdge(i)));
+      },
+      [&](size_t h) {
+        return array<uint64_t, 5>{idx(origin(h)), idx(twin(h)), idx(face(h)), idx(next(h)), idx(prev(h))};
+      },
+      pool);
+}
@@ -0,0 +1,164 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef DCEL_BINARY_HPP
+#define DCEL_BINARY_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "dcel_soa.hpp"
+#include "mesh.hpp"
+#include "output_writer.hpp"
+
+using namespace std;
+
+// ---------- Formato binário da DCEL ----------
+// Cabeçalho de 64 bytes seguido de quatro seções de registros de largura
+// fixa, todos em little-endian:
+//   vértices:      int32 x, int32 y, uint32 semi-aresta incidente   (12 bytes)
+//   faces:         uint32 semi-aresta do componente externo          (4 bytes)
+//   semi-arestas:  uint32 origem, gêmea, face, próxima, anterior     (20 bytes)
+//   internos:      uint32 face, uint32 semi-aresta do buraco         (8 bytes)
+// Os componentes internos vêm em ordem de face, e a contagem deles ocupa o
+// antigo campo reservado do cabeçalho. A seção de internos é da versão 2; a
+// versão 1 não a tem (o campo é ignorado) e continua sendo lida, como DCEL
+// sem buracos. Índices são base 0 e 0xFFFFFFFF representa ausência.
+// O checksum cobre todas as seções; com ele válido e a flag de malha
+// validada, a carga dispensa a validação da malha.
+
+static const uint32_t DCEL_BINARY_VERSION = 2;     // versão gravada
+static const uint32_t DCEL_BINARY_MIN_VERSION = 1; // versão mais antiga lida (sem componentes internos)
+static const uint32_t DCEL_BINARY_ENDIAN_TAG = 0x01020304;
+static const uint32_t DCEL_BINARY_VALIDATED = 1; // flag: malha passou por checkMesh
+
+#pragma pack(push, 1)
+struct DCELBinaryHeader {
+  char magic[8];          // "DCELBIN\0"
+  uint32_t version;
+  uint32_t endianTag;     // DCEL_BINARY_ENDIAN_TAG gravado em little-endian
+  uint64_t numVertices;
+  uint64_t numHalfEdges;
+  uint64_t numFaces;
+  uint32_t flags;
+  uint32_t numInner;      // registros de componentes internos (versão 2; reservado na 1)
+  uint64_t checksum;      // FNV-1a 64 sobre as seções de registros
+  uint64_t padding;
+};
+
+struct VertexRecord {
+  int32_t x, y;
+  uint32_t edge;
+};
+
+struct FaceRecord {
+  uint32_t outer;
+};
+
+struct HalfEdgeRecord {
+  uint32_t origin, twin, face, next, prev;
+};
+
+struct InnerRecord {
+  uint32_t face, edge;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(DCELBinaryHeader) == 64, "cabeçalho deve ter 64 bytes");
+static_assert(sizeof(VertexRecord) == 12, "registro de vértice deve ter 12 bytes");
+static_assert(sizeof(HalfEdgeRecord) == 20, "registro de semi-aresta deve ter 20 bytes");
+static_assert(sizeof(InnerRecord) == 8, "registro de componente interno deve ter 8 bytes");
+
+/**
+ * Grava a DCEL compacta no formato binário
+ * @param dcel DCEL já construída
+ * @param path Caminho do arquivo de saída
+ * @param validated Se a malha de origem passou por checkMesh
+ * @throws runtime_error se não conseguir gravar o arquivo
+ */
+void saveBinaryDCEL(const CompactDCEL& dcel, const string& path, bool validated);
+
+// ---------- Classe MappedDCEL ----------
+// DCEL lida de um arquivo binário via mmap: os registros são acessados
+// direto no mapeamento, sem alocação por elemento.
+class MappedDCEL {
+public:
+  /**
+   * Mapeia e confere o arquivo (magia, versão, endianness, tamanhos e checksum)
+   * @param path Caminho do arquivo binário
+   * @throws runtime_error se o arquivo for inválido ou estiver corrompido
+   */
+  explicit MappedDCEL(const string& path);
+  ~MappedDCEL();
+
+  MappedDCEL(const MappedDCEL&) = delete;
+  MappedDCEL& operator=(const MappedDCEL&) = delete;
+
+  size_t numVertices() const { return nv; }
+  size_t numHalfEdges() const { return nh; }
+  size_t numFaces() const { return nf; }
+  size_t numInner() const { return ni; }
+
+  // Campos dos registros (convertidos de little-endian, se necessário)
+  int32_t vertexX(size_t v) const;
+  int32_t vertexY(size_t v) const;
+  uint32_t vertexEdge(size_t v) const;
+  uint32_t faceEdge(size_t f) const;
+  uint32_t origin(size_t h) const;
+  uint32_t twin(size_t h) const;
+  uint32_t face(size_t h) const;
+  uint32_t next(size_t h) const;
+  uint32_t prev(size_t h) const;
+
+  /**
+   * Registros de componentes internos da face f, [first, last) em innerEdge
+   */
+  pair<size_t, size_t> innerRange(size_t f) const;
+  uint32_t innerEdge(size_t i) const;
+
+  /**
+   * Indica se a malha foi validada antes de ser gravada
+   */
+  bool validated() const { return flags & DCEL_BINARY_VALIDATED; }
+
+  /**
+   * Reconstrói a malha (coordenadas e ciclos das faces) para revalidação
+   * @return Malha equivalente à entrada original
+   */
+  Mesh toMesh() const;
+
+  /**
+   * Imprime a DCEL no mesmo formato de DCEL::printDCELOutput
+   * @param pool Pool para formatar a seção de semi-arestas em paralelo (pode ser nulo)
+   */
+  void printDCELOutput(ThreadPool* pool = nullptr) const;
+
+  /**
+   * Escreve a DCEL no mesmo formato de DCEL::printDCELOutput
+   * @param out Destino
+   * @param pool Pool para formatar a seção de semi-arestas em paralelo (pode ser nulo)
+   */
+  void printDCELOutput(OutputWriter& out, ThreadPool* pool = nullptr) const;
+
+private:
+  void* base = nullptr;
+  size_t mappedSize = 0;
+  size_t nv = 0, nh = 0, nf = 0, ni = 0;
+  uint32_t flags = 0;
+  const VertexRecord* vertices = nullptr;
+  const FaceRecord* faces = nullptr;
+  const HalfEdgeRecord* halfEdges = nullptr;
+  const InnerRecord* inner = nullptr;
+
+  uint32_t innerFace(size_t i) const;
+};
+
+#endif // DCEL_BINARY_HPP
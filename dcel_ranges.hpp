@@ -0,0 +1,323 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef DCEL_RANGES_HPP
+#define DCEL_RANGES_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "dcel.hpp"
+#include "dcel_soa.hpp"
+
+using namespace std;
+
+// Circuladores sobre a DCEL: percorrem um ciclo de semi-arestas a partir de
+// uma inicial até voltar a ela, sem alocar nada. Cada iterador guarda só a
+// semi-aresta corrente (ponteiro na DCEL, índice na CompactDCEL) e se ainda
+// está no início; o fim é a própria semi-aresta inicial. Assim o teste de
+// parada depois do primeiro passo é o mesmo do do/while escrito à mão. Os
+// iteradores são trivialmente copiáveis e funcionam em range-for e nos
+// algoritmos da biblioteca padrão:
+//
+//   for (HalfEdge* he : faceEdges(f)) ...          // next
+//   for (HalfEdge* he : outgoingEdges(v)) ...      // twin->next, todas saem de v
+//   count_if(adjacentFaces(f).begin(), adjacentFaces(f).end(), ...)
+//
+// O passo (Step) escolhe o ciclo e a projeção (Project) o que é entregue a
+// cada passo; ambos são tipos vazios, não ocupam espaço no iterador.
+// Os ciclos em volta de vértices usam twin, que sempre existe numa malha
+// fechada (checkMesh rejeita as abertas). Alterar next/twin do ciclo durante
+// a iteração invalida o circulador.
+
+// ---------- Passos e projeções da DCEL de ponteiros ----------
+// Modelos sobre o tipo da semi-aresta: servem a qualquer instanciação de BasicDCEL
+
+struct NextInFace {
+  template <class HE>
+  HE* operator()(const HE* he) const { return he->next; }
+};
+
+// A próxima semi-aresta que sai da mesma origem (anti-horário nas faces CCW)
+struct NextAroundOrigin {
+  template <class HE>
+  HE* operator()(const HE* he) const { return he->twin->next; }
+};
+
+struct EdgeItself {
+  template <class HE>
+  HE* operator()(HE* he) const { return he; }
+};
+
+struct EdgeOrigin {
+  template <class HE>
+  auto operator()(const HE* he) const { return he->origin; }
+};
+
+struct EdgeDestination {
+  template <class HE>
+  auto operator()(const HE* he) const { return he->next->origin; }
+};
+
+struct EdgeFace {
+  template <class HE>
+  auto operator()(const HE* he) const { return he->incidentFace; }
+};
+
+struct TwinFace {
+  template <class HE>
+  auto operator()(const HE* he) const { return he->twin->incidentFace; }
+};
+
+// ---------- Classe DCELCirculator ----------
+template <class Step, class Project, class HE = HalfEdge>
+class DCELCirculator {
+public:
+  using iterator_category = forward_iterator_tag;
+  using value_type = decltype(Project()(static_cast<HE*>(nullptr)));
+  using difference_type = ptrdiff_t;
+  using pointer = void;
+  using reference = value_type;
+
+  DCELCirculator() = default;
+  DCELCirculator(HE* current, bool fresh) : current(current), fresh(fresh) {}
+
+  reference operator*() const { return Project()(current); }
+
+  /**
+   * Semi-aresta corrente, qualquer que seja a projeção
+   */
+  HE* halfEdge() const { return current; }
+
+  DCELCirculator& operator++() {
+    current = Step()(current);
+    fresh = false;
+    return *this;
+  }
+
+  DCELCirculator operator++(int) {
+    DCELCirculator old = *this;
+    ++*this;
+    return old;
+  }
+
+  // Deu a volta: de novo na semi-aresta inicial, mas já fora do início
+  bool operator==(const DCELCirculator& other) const { return fresh == other.fresh && current == other.current; }
+  bool operator!=(const DCELCirculator& other) const { return !(*this == other); }
+
+private:
+  HE* current = nullptr;
+  bool fresh = false; // ainda não avançou (begin de um ciclo não vazio)
+};
+
+// Um ciclo inteiro a partir de start (vazio se start for nulo)
+template <class Step, class Project, class HE = HalfEdge>
+class DCELRange {
+public:
+  using iterator = DCELCirculator<Step, Project, HE>;
+
+  explicit DCELRange(HE* start) : start(start) {}
+
+  iterator begin() const { return iterator(start, start != nullptr); }
+  iterator end() const { return iterator(start, false); }
+  bool empty() const { return start == nullptr; }
+
+private:
+  HE* start;
+};
+
+static_assert(is_trivially_copyable<DCELCirculator<NextInFace, EdgeItself>>::value,
+              "circuladores devem ser copiados sem custo");
+
+/**
+ * Semi-arestas do componente externo da face, seguindo next
+ */
+template <class Coord, class Index>
+inline auto faceEdges(const BasicFace<Coord, Index>* f) {
+  return DCELRange<NextInFace, EdgeItself, BasicHalfEdge<Coord, Index>>(f->outerComponent);
+}
+
+/**
+ * Vértices da face, na ordem do ciclo
+ */
+template <class Coord, class Index>
+inline auto faceVertices(const BasicFace<Coord, Index>* f) {
+  return DCELRange<NextInFace, EdgeOrigin, BasicHalfEdge<Coord, Index>>(f->outerComponent);
+}
+
+/**
+ * Faces do outro lado de cada aresta da face (uma por aresta: repete faces
+ * que compartilham mais de uma aresta)
+ */
+template <class Coord, class Index>
+inline auto adjacentFaces(const BasicFace<Coord, Index>* f) {
+  return DCELRange<NextInFace, TwinFace, BasicHalfEdge<Coord, Index>>(f->outerComponent);
+}
+
+/**
+ * Semi-arestas que saem do vértice, via twin->next
+ */
+template <class Coord, class Index>
+inline auto outgoingEdges(const BasicVertex<Coord, Index>* v) {
+  return DCELRange<NextAroundOrigin, EdgeItself, BasicHalfEdge<Coord, Index>>(v->incidentEdge);
+}
+
+/**
+ * Vértices vizinhos (destino de cada semi-aresta que sai do vértice)
+ */
+template <class Coord, class Index>
+inline auto vertexNeighbors(const BasicVertex<Coord, Index>* v) {
+  return DCELRange<NextAroundOrigin, EdgeDestination, BasicHalfEdge<Coord, Index>>(v->incidentEdge);
+}
+
+/**
+ * Faces em volta do vértice (a face de cada semi-aresta que sai dele)
+ */
+template <class Coord, class Index>
+inline auto vertexFaces(const BasicVertex<Coord, Index>* v) {
+  return DCELRange<NextAroundOrigin, EdgeFace, BasicHalfEdge<Coord, Index>>(v->incidentEdge);
+}
+
+// ======================================================================================================================= //
+
+// ---------- Passos e projeções da CompactDCEL ----------
+// Mesmos ciclos, sobre índices; NIL faz o papel do ponteiro nulo. D é a
+// instanciação de BasicCompactDCEL
+
+struct CompactNextInFace {
+  template <class D>
+  typename D::index_t operator()(const D& d, typename D::index_t h) const { return d.next[h]; }
+};
+
+struct CompactNextAroundOrigin {
+  template <class D>
+  typename D::index_t operator()(const D& d, typename D::index_t h) const { return d.next[d.twin[h]]; }
+};
+
+struct CompactEdgeItself {
+  template <class D>
+  typename D::index_t operator()(const D&, typename D::index_t h) const { return h; }
+};
+
+struct CompactEdgeOrigin {
+  template <class D>
+  typename D::index_t operator()(const D& d, typename D::index_t h) const { return d.origin[h]; }
+};
+
+struct CompactEdgeDestination {
+  template <class D>
+  typename D::index_t operator()(const D& d, typename D::index_t h) const { return d.origin[d.next[h]]; }
+};
+
+struct CompactEdgeFace {
+  template <class D>
+  typename D::index_t operator()(const D& d, typename D::index_t h) const { return d.face[h]; }
+};
+
+struct CompactTwinFace {
+  template <class D>
+  typename D::index_t operator()(const D& d, typename D::index_t h) const { return d.face[d.twin[h]]; }
+};
+
+// ---------- Classe CompactCirculator ----------
+template <class Step, class Project, class D = CompactDCEL>
+class CompactCirculator {
+public:
+  using index_t = typename D::index_t;
+  using iterator_category = forward_iterator_tag;
+  using value_type = index_t;
+  using difference_type = ptrdiff_t;
+  using pointer = void;
+  using reference = index_t;
+
+  CompactCirculator() = default;
+  CompactCirculator(const D* dcel, index_t current, bool fresh)
+      : dcel(dcel), current(current), fresh(fresh ? 1 : 0) {}
+
+  reference operator*() const { return Project()(*dcel, current); }
+
+  /**
+   * Semi-aresta corrente, qualquer que seja a projeção
+   */
+  index_t halfEdge() const { return current; }
+
+  CompactCirculator& operator++() {
+    current = Step()(*dcel, current);
+    fresh = 0;
+    return *this;
+  }
+
+  CompactCirculator operator++(int) {
+    CompactCirculator old = *this;
+    ++*this;
+    return old;
+  }
+
+  bool operator==(const CompactCirculator& other) const { return fresh == other.fresh && current == other.current; }
+  bool operator!=(const CompactCirculator& other) const { return !(*this == other); }
+
+private:
+  const D* dcel = nullptr;
+  index_t current = D::NIL;
+  index_t fresh = 0; // do tamanho do índice: com bool o GCC empacota os dois campos e desfaz a cada passo
+};
+
+template <class Step, class Project, class D = CompactDCEL>
+class CompactRange {
+public:
+  using iterator = CompactCirculator<Step, Project, D>;
+
+  CompactRange(const D& dcel, typename D::index_t start) : dcel(&dcel), start(start) {}
+
+  iterator begin() const { return iterator(dcel, start, start != D::NIL); }
+  iterator end() const { return iterator(dcel, start, false); }
+  bool empty() const { return start == D::NIL; }
+
+private:
+  const D* dcel;
+  typename D::index_t start;
+};
+
+static_assert(is_trivially_copyable<CompactCirculator<CompactNextInFace, CompactEdgeItself>>::value,
+              "circuladores devem ser copiados sem custo");
+
+template <class Coord, class Index>
+inline auto faceEdges(const BasicCompactDCEL<Coord, Index>& d, size_t f) {
+  return CompactRange<CompactNextInFace, CompactEdgeItself, BasicCompactDCEL<Coord, Index>>(d, d.faceEdge[f]);
+}
+
+template <class Coord, class Index>
+inline auto faceVertices(const BasicCompactDCEL<Coord, Index>& d, size_t f) {
+  return CompactRange<CompactNextInFace, CompactEdgeOrigin, BasicCompactDCEL<Coord, Index>>(d, d.faceEdge[f]);
+}
+
+template <class Coord, class Index>
+inline auto adjacentFaces(const BasicCompactDCEL<Coord, Index>& d, size_t f) {
+  return CompactRange<CompactNextInFace, CompactTwinFace, BasicCompactDCEL<Coord, Index>>(d, d.faceEdge[f]);
+}
+
+template <class Coord, class Index>
+inline auto outgoingEdges(const BasicCompactDCEL<Coord, Index>& d, size_t v) {
+  return CompactRange<CompactNextAroundOrigin, CompactEdgeItself, BasicCompactDCEL<Coord, Index>>(d, d.vertexEdge[v]);
+}
+
+template <class Coord, class Index>
+inline auto vertexNeighbors(const BasicCompactDCEL<Coord, Index>& d, size_t v) {
+  using Range = CompactRange<CompactNextAroundOrigin, CompactEdgeDestination, BasicCompactDCEL<Coord, Index>>;
+  return Range(d, d.vertexEdge[v]);
+}
+
+template <class Coord, class Index>
+inline auto vertexFaces(const BasicCompactDCEL<Coord, Index>& d, size_t v) {
+  return CompactRange<CompactNextAroundOrigin, CompactEdgeFace, BasicCompactDCEL<Coord, Index>>(d, d.vertexEdge[v]);
+}
+
+#endif // DCEL_RANGES_HPP
@@ -0,0 +1,364 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "dcel_soa.hpp"
+#include "edge_table.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+
+using namespace std;
+
+// ======================================================================================================================= //
+
+template <class Coord, class Index>
+void BasicCompactDCEL<Coord, Index>::buildFromMesh(const vector<pair<int, int>>& vertexCoords, const FaceList& faceVertices,
+                                                   const HoleAssignment* holes, ThreadPool* pool) {
+  size_t totalHalfEdges = 0;
+  for (const auto& faceVerts : faceVertices) {
+    totalHalfEdges += faceVerts.size();
+  }
+  if (!fits(vertexCoords.size(), totalHalfEdges, faceVertices.size())) {
+    throw length_error("Malha grande demais para índices de " + to_string(8 * sizeof(index_t)) + " bits");
+  }
+
+  // Os buracos têm fase própria nas estatísticas, fora da construção
+  HoleAssignment computed;
+  if (!holes) {
+    assignHoles(vertexCoords, faceVertices, computed);
+    holes = &computed;
+  }
+  STATS_TIMER(STATS_BUILD);
+
+  // Construída na ordem da entrada: sem numeração separada
+  vertexInput.clear();
+  halfEdgeInput.clear();
+  faceInput.clear();
+
+  // Com pool, cada passo divide vértices, ciclos ou arestas entre as threads;
+  // sem pool, as mesmas passadas rodam inteiras na thread chamadora
+
+  // 1. Criar vértices a partir das coordenadas
+  createVertices(vertexCoords, pool);
+
+  // 2. Criar semi-arestas e faces a partir da lista de vértices das faces, já
+  //    com a aresta incidente de cada vértice e os buracos de cada face
+  createHalfEdgesAndFaces(faceVertices, *holes, pool);
+
+  // 3. Conectar as gêmeas
+  linkTwins(faceVertices, pool);
+}
+
+// ======================================================================================================================= //
+
+template <class Coord, class Index>
+void BasicCompactDCEL<Coord, Index>::buildFromMeshReordered(const vector<pair<int, int>>& vertexCoords,
+                                                            const FaceList& faceVertices, SpaceFillingCurve curve,
+                                                            ThreadPool* pool) {
+  MeshOrder order;
+  Mesh sorted;
+  spatialOrder(vertexCoords, faceVertices, curve, order);
+  reorderMesh(vertexCoords, faceVertices, order, sorted);
+  HoleAssignment holes;
+  assignHoles(sorted.vertices, sorted.faces, holes);
+  buildFromMesh(sorted.vertices, sorted.faces, &holes, pool);
+
+  vertexInput.assign(order.vertexInput.begin(), order.vertexInput.end());
+
+  // O ciclo novo c é o ciclo order.faceInput[c] da entrada, com o mesmo vértice
+  // inicial: a i-ésima semi-aresta de um é a i-ésima do outro
+  halfEdgeInput.resize(numHalfEdges());
+  for (size_t c = 0; c < sorted.faces.size(); c++) {
+    size_t first = sorted.faces.offsets[c], inputFirst = faceVertices.offsets[order.faceInput[c]];
+    for (size_t i = 0; i < sorted.faces[c].size(); i++) {
+      halfEdgeInput[first + i] = inputFirst + i;
+    }
+  }
+
+  // Faces são os ciclos que não são buracos: a numeração da entrada de cada
+  // face é a posição do seu ciclo entre os não buracos da entrada
+  vector<size_t> cycleFace;
+  numberFaces(holes, sorted.faces.size(), cycleFace);
+  vector<index_t> inputRank(sorted.faces.size(), 0);
+  for (size_t c = 0; c < sorted.faces.size(); c++) inputRank[order.faceInput[c]] = !holes.isHole(c);
+  index_t rank = 0;
+  for (index_t& r : inputRank) {
+    index_t isFace = r;
+    r = rank;
+    rank += isFace;
+  }
+  faceInput.resize(numFaces());
+  for (size_t c = 0; c < sorted.faces.size(); c++) {
+    if (!holes.isHole(c)) faceInput[cycleFace[c]] = inputRank[order.faceInput[c]];
+  }
+
+  // Aresta incidente: a primeira na ordem da entrada que sai do vértice
+  for (index_t h = 0; h < numHalfEdges(); h++) {
+    index_t& incident = vertexEdge[origin[h]];
+    if (halfEdgeInput[h] < halfEdgeInput[incident]) incident = h;
+  }
+}
+
+// ======================================================================================================================= //
+
+template <class Coord, class Index>
+void BasicCompactDCEL<Coord, Index>::createVertices(const vector<pair<int, int>>& vertexCoords, ThreadPool* pool) {
+  size_t n = vertexCoords.size();
+  vx.resize(n);
+  vy.resize(n);
+  size_t grain = pool ? max<size_t>(4096, n / (8 * pool->size())) : n;
+  parallelFor(pool, 0, n, grain, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; i++) {
+      vx[i] = vertexCoords[i].first;
+      vy[i] = vertexCoords[i].second;
+    }
+  });
+}
+
+// ======================================================================================================================= //
+
+template <class Coord, class Index>
+void BasicCompactDCEL<Coord, Index>::createHalfEdgesAndFaces(const FaceList& faceVertices,
+                                                             const HoleAssignment& holes, ThreadPool* pool) {
+  size_t totalHalfEdges = 0;
+  for (const auto& faceVerts : faceVertices) {
+    totalHalfEdges += faceVerts.size();
+  }
+
+  // Faces são os ciclos que não são buracos, na ordem da entrada
+  vector<size_t> cycleFace;
+  size_t numFaces = numberFaces(holes, faceVertices.size(), cycleFace);
+
+  origin.resize(totalHalfEdges);
+  vertexEdge.assign(vx.size(), NIL);
+  next.resize(totalHalfEdges);
+  prev.resize(totalHalfEdges);
+  face.resize(totalHalfEdges);
+  faceEdge.resize(numFaces);
+  innerOffsets.clear();
+  innerEdges.clear();
+  if (holes.holes > 0) {
+    innerOffsets.assign(numFaces + 1, 0);
+    innerEdges.resize(holes.holes);
+    for (size_t c = 0; c < faceVertices.size(); c++) {
+      if (holes.isHole(c)) innerOffsets[cycleFace[c] + 1]++;
+    }
+    for (size_t f = 0; f < numFaces; f++) innerOffsets[f + 1] += innerOffsets[f];
+  }
+  vector<index_t> innerFill(innerOffsets.begin(), innerOffsets.end());
+
+  // As semi-arestas de cada ciclo ocupam um bloco contíguo, na ordem da
+  // entrada, a partir de offsets[c]: cada bloco de ciclos escreve só as suas
+  size_t grain = pool ? max<size_t>(1024, faceVertices.size() / (8 * pool->size())) : faceVertices.size();
+  parallelFor(pool, 0, faceVertices.size(), grain, [&](size_t lo, size_t hi) {
+    for (size_t c = lo; c < hi; c++) {
+      const auto& faceVerts = faceVertices[c];
+      index_t base = faceVertices.offsets[c];
+      index_t n = faceVerts.size();
+      index_t f = cycleFace[c];
+
+      for (index_t i = 0; i < n; i++) {
+        index_t h = base + i;
+        origin[h] = faceVerts[i];
+        face[h] = f;
+        next[h] = base + (i + 1) % n;
+        prev[h] = base + (i + n - 1) % n;
+      }
+      if (!holes.isHole(c)) faceEdge[f] = n > 0 ? base : NIL;
+    }
+  });
+
+  // Os buracos de cada face na ordem dos ciclos: o próximo componente interno
+  // da face que contém o ciclo é a primeira semi-aresta dele
+  for (size_t c = 0; c < faceVertices.size() && holes.holes > 0; c++) {
+    if (holes.isHole(c)) innerEdges[innerFill[cycleFace[c]]++] = faceVertices.offsets[c];
+  }
+
+  // Aresta incidente: a primeira semi-aresta (em ordem) que tem o vértice como origem
+  if (!pool) {
+    for (index_t h = totalHalfEdges; h-- > 0;) vertexEdge[origin[h]] = h;
+    return;
+  }
+  unique_ptr<atomic<index_t>[]> firstEdge(new atomic<index_t>[vx.size()]);
+  size_t vertexGrain = max<size_t>(4096, vx.size() / (8 * pool->size()));
+  parallelFor(pool, 0, vx.size(), vertexGrain, [&](size_t lo, size_t hi) {
+    for (size_t v = lo; v < hi; v++) firstEdge[v].store(NIL, memory_order_relaxed);
+  });
+  size_t edgeGrain = max<size_t>(4096, totalHalfEdges / (8 * pool->size()));
+  parallelFor(pool, 0, totalHalfEdges, edgeGrain, [&](size_t lo, size_t hi) {
+    for (size_t h = lo; h < hi; h++) atomicMin(firstEdge[origin[h]], index_t(h));
+  });
+  parallelFor(pool, 0, vx.size(), vertexGrain, [&](size_t lo, size_t hi) {
+    for (size_t v = lo; v < hi; v++) vertexEdge[v] = firstEdge[v].load(memory_order_relaxed);
+  });
+}
+
+// ======================================================================================================================= //
+
+template <class Coord, class Index>
+void BasicCompactDCEL<Coord, Index>::linkTwins(const FaceList& faceVertices, ThreadPool* pool) {
+  size_t totalHalfEdges = origin.size();
+  twin.assign(totalHalfEdges, NIL);
+
+  // NONE e DUPLICATE da tabela concorrente não podem ser índices de semi-aresta
+  if (pool && totalHalfEdges < ConcurrentEdgeTable<index_t>::DUPLICATE) {
+    // Tabela concorrente por aresta não direcionada: pareia quando há
+    // exatamente uma semi-aresta em cada sentido, como a passada sequencial
+    ConcurrentEdgeTable<index_t> edges(totalHalfEdges, pool);
+    size_t grain = max<size_t>(1024, faceVertices.size() / (8 * pool->size()));
+    parallelFor(pool, 0, faceVertices.size(), grain, [&](size_t lo, size_t hi) {
+      for (size_t c = lo; c < hi; c++) {
+        const auto& faceVerts = faceVertices[c];
+        index_t base = faceVertices.offsets[c];
+        index_t n = faceVerts.size();
+        for (index_t i = 0; i < n; i++) edges.insert(faceVerts[i], faceVerts[(i + 1) % n], base + i);
+      }
+    });
+
+    atomic<size_t> paired{0};
+    edges.forEach(pool, [&](index_t forward, index_t backward) {
+      // NONE e DUPLICATE são os dois maiores valores de index_t
+      if (forward >= ConcurrentEdgeTable<index_t>::DUPLICATE || backward >= ConcurrentEdgeTable<index_t>::DUPLICATE) {
+        return;
+      }
+      twin[forward] = backward;
+      twin[backward] = forward;
+      paired.fetch_add(2, memory_order_relaxed);
+    });
+    size_t unmatched = totalHalfEdges - paired.load(memory_order_relaxed);
+    if (unmatched > 0) {
+      cerr << "Aviso: " << unmatched << " arestas não pareadas!" << endl;
+    }
+    return;
+  }
+
+  // Aresta direcionada -> sua semi-aresta, ou DUPLICATE se a aresta se repete
+  const index_t DUPLICATE = NIL - 1;
+  EdgeTable<index_t> edges(totalHalfEdges);
+  vector<uint64_t> keys(totalHalfEdges);
+  index_t base = 0;
+  for (const auto& faceVerts : faceVertices) {
+    index_t n = faceVerts.size();
+    for (index_t i = 0; i < n; i++) {
+      keys[base + i] = EdgeTable<index_t>::key(faceVerts[i], faceVerts[(i + 1) % n]);
+      bool inserted;
+      index_t& h = edges.findOrInsert(keys[base + i], inserted);
+      h = inserted ? base + i : DUPLICATE;
+    }
+    base += n;
+  }
+
+  // Só pareia se houver exatamente uma semi-aresta em cada sentido
+  size_t unmatched = 0;
+  for (index_t h = 0; h < totalHalfEdges; h++) {
+    uint64_t reverseKey = EdgeTable<index_t>::reverse(keys[h]);
+    const index_t* other = reverseKey != keys[h] ? edges.find(reverseKey) : nullptr;
+    if (other && *other != DUPLICATE && *edges.find(keys[h]) != DUPLICATE) {
+      twin[h] = *other;
+    } else {
+      unmatched++;
+    }
+  }
+
+  // Verifica arestas não pareadas (não deve acontecer em malha válida)
+  if (unmatched > 0) {
+    cerr << "Aviso: " << unmatched << " arestas não pareadas!" << endl;
+  }
+}
+
+// ======================================================================================================================= //
+
+template <class Coord, class Index>
+void BasicCompactDCEL<Coord, Index>::printDCELOutput(ThreadPool* pool) const {
+  OutputWriter out(1);
+  printDCELOutput(out, pool);
+  out.flush();
+}
+
+template <class Coord, class Index>
+void BasicCompactDCEL<Coord, Index>::printDCELOutput(OutputWriter& out, ThreadPool* pool) const {
+  // Índices de saída são base 1; NIL vira 0
+  auto idx = [](index_t i) -> uint64_t { return i == NIL ? 0 : uint64_t(i) + 1; };
+
+  if (!reordered()) {
+    writeDCELText(
+        out, numVertices(), numHalfEdges(), numFaces(),
+        [&](size_t v) {
+          return VertexLine{static_cast<long long>(vx[v]), static_cast<long long>(vy[v]), idx(vertexEdge[v])};
+        },
+        [&](size_t f) { return idx(faceEdge[f]); },
+        [&](size_t f, const auto& emit) {
+          for (size_t i = 0; i < numInner(f); i++) emit(idx(innerEdges[innerOffsets[f] + i]));
+        },
+        [&](size_t h) {
+          return array<uint64_t, 5>{idx(origin[h]), idx(twin[h]), idx(face[h]), idx(next[h]), idx(prev[h])};
+        },
+        pool);
+    return;
+  }
+
+  // Reordenada: cada linha i é o elemento que era o i-ésimo na entrada, e as
+  // referências são traduzidas para a numeração da entrada
+  auto inverse = [](const vector<index_t>& input) {
+    vector<index_t> at(input.size());
+    for (size_t i = 0; i < input.size(); i++) at[input[i]] = i;
+    return at;
+  };
+  vector<index_t> vertexAt = inverse(vertexInput), halfEdgeAt = inverse(halfEdgeInput), faceAt = inverse(faceInput);
+  auto vertexIdx = [&](index_t v) -> uint64_t { return v == NIL ? 0 : uint64_t(vertexInput[v]) + 1; };
+  auto edgeIdx = [&](index_t h) -> uint64_t { return h == NIL ? 0 : uint64_t(halfEdgeInput[h]) + 1; };
+  auto faceIdx = [&](index_t f) -> uint64_t { return f == NIL ? 0 : uint64_t(faceInput[f]) + 1; };
+
+  writeDCELText(
+      out, numVertices(), numHalfEdges(), numFaces(),
+      [&](size_t v) {
+        index_t c = vertexAt[v];
+        return VertexLine{static_cast<long long>(vx[c]), static_cast<long long>(vy[c]), edgeIdx(vertexEdge[c])};
+      },
+      [&](size_t f) { return edgeIdx(faceEdge[faceAt[f]]); },
+      [&](size_t f, const auto& emit) {
+        // Na ordem da entrada, os buracos aparecem pela ordem dos seus ciclos
+        index_t c = faceAt[f];
+        vector<uint64_t> inner;
+        for (size_t i = 0; i < numInner(c); i++) inner.push_back(edgeIdx(innerEdges[innerOffsets[c] + i]));
+        sort(inner.begin(), inner.end());
+        for (uint64_t edge : inner) emit(edge);
+      },
+      [&](size_t h) {
+        index_t c = halfEdgeAt[h];
+        return array<uint64_t, 5>{vertexIdx(origin[c]), edgeIdx(twin[c]), faceIdx(face[c]), edgeIdx(next[c]),
+                                  edgeIdx(prev[c])};
+      },
+      pool);
+}
+
+// ======================================================================================================================= //
+
+template <class Coord, class Index>
+size_t BasicCompactDCEL<Coord, Index>::memoryBytes() const {
+  return (vx.capacity() + vy.capacity()) * sizeof(Coord) +
+         (vertexEdge.capacity() + origin.capacity() + twin.capacity() + next.capacity() +
+          prev.capacity() + face.capacity() + faceEdge.capacity() + innerOffsets.capacity() +
+          innerEdges.capacity() + vertexInput.capacity() +
+          halfEdgeInput.capacity() + faceInput.capacity()) * sizeof(index_t);
+}
+
+// ======================================================================================================================= //
+
+template class BasicCompactDCEL<int32_t, uint32_t>;
+template class BasicCompactDCEL<int32_t, uint64_t>;
+template class BasicCompactDCEL<int64_t, uint32_t>;
+template class BasicCompactDCEL<int64_t, uint64_t>;
+template class BasicCompactDCEL<double, uint32_t>;
+template class BasicCompactDCEL<double, uint64_t>;
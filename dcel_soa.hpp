@@ -0,0 +1,170 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef DCEL_SOA_HPP
+#define DCEL_SOA_HPP
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "holes.hpp"
+#include "mesh.hpp"
+#include "output_writer.hpp"
+#include "reorder.hpp"
+
+using namespace std;
+
+// ---------- Classe BasicCompactDCEL ----------
+// DCEL em layout "structure of arrays": vértices, semi-arestas e faces vivem
+// em vetores contíguos e se referenciam por índices (base 0). Não há alocação
+// por elemento nem contagem de referências, e percorrer next/twin só toca os
+// vetores envolvidos.
+//
+// Coord é o tipo das coordenadas (int32_t, int64_t ou double) e Index o dos
+// índices (uint32_t ou uint64_t); as seis combinações são instanciadas em
+// dcel_soa.cpp. CompactDCEL (int32_t, uint32_t) é a mais estreita e a usada
+// pelo formato binário e pela localização de pontos; selectCompactDCEL
+// escolhe a instanciação que comporta uma malha.
+template <class Coord, class Index>
+class BasicCompactDCEL {
+public:
+  using coord_type = Coord;
+  using index_t = Index;
+  static constexpr index_t NIL = numeric_limits<index_t>::max();
+
+  // Vértices: coordenadas e uma semi-aresta incidente
+  vector<Coord> vx, vy;
+  vector<index_t> vertexEdge;
+
+  // Semi-arestas: origem, gêmea, próxima, anterior e face incidente
+  vector<index_t> origin, twin, next, prev, face;
+
+  // Faces: semi-aresta do componente externo
+  vector<index_t> faceEdge;
+
+  // Componentes internos (buracos) em CSR: os da face f são innerEdges[innerOffsets[f]..
+  // innerOffsets[f + 1]), uma semi-aresta por ciclo; vazios se a malha não tem buracos
+  vector<index_t> innerOffsets, innerEdges;
+
+  // Numeração da entrada (posição atual -> índice na entrada) quando a DCEL
+  // foi construída por buildFromMeshReordered; vazios na ordem da entrada
+  vector<index_t> vertexInput, halfEdgeInput, faceInput;
+
+  BasicCompactDCEL() = default;
+
+  /**
+   * Verifica se as contagens da malha cabem nos índices desta instanciação
+   * (NIL fica reservado)
+   * @return true se todos os índices são representáveis em Index
+   */
+  static bool fits(size_t numVertices, size_t numHalfEdges, size_t numFaces) {
+    return numVertices < NIL && numHalfEdges < NIL && numFaces < NIL;
+  }
+
+  size_t numVertices() const { return vx.size(); }
+  size_t numHalfEdges() const { return origin.size(); }
+  size_t numFaces() const { return faceEdge.size(); }
+
+  /**
+   * Constrói a DCEL a partir da malha, preservando a ordem da entrada
+   * (mesma numeração produzida por DCEL::buildFromMesh)
+   * @param vertexCoords Vetor de coordenadas (x,y) dos vértices
+   * @param faceVertices Faces (CSR), cada face é uma lista de índices de vértices
+   * @param holes Buracos já atribuídos (ver assignHoles); nulo = calcular aqui
+   * @param pool Pool para construir em paralelo (nulo = sequencial); o
+   *             resultado é o mesmo da construção sequencial
+   */
+  void buildFromMesh(const vector<pair<int, int>>& vertexCoords, const FaceList& faceVertices,
+                     const HoleAssignment* holes = nullptr, ThreadPool* pool = nullptr);
+
+  /**
+   * Constrói a DCEL com vértices e faces ordenados ao longo de uma curva que
+   * preenche o plano (reorder.hpp); as semi-arestas seguem a ordem das faces.
+   * Guarda a numeração da entrada, e a aresta incidente de cada vértice é a
+   * de menor índice na entrada, de modo que printDCELOutput produz a mesma
+   * saída de buildFromMesh
+   * @param vertexCoords Vetor de coordenadas (x,y) dos vértices
+   * @param faceVertices Faces (CSR), cada face é uma lista de índices de vértices
+   * @param curve Curva de Hilbert ou de Morton
+   * @param pool Pool para a construção em paralelo (pode ser nulo)
+   */
+  void buildFromMeshReordered(const vector<pair<int, int>>& vertexCoords, const FaceList& faceVertices,
+                              SpaceFillingCurve curve, ThreadPool* pool = nullptr);
+
+  bool reordered() const { return !faceInput.empty() || !vertexInput.empty(); }
+
+  /**
+   * Número de componentes internos da face f
+   */
+  size_t numInner(size_t f) const { return innerOffsets.empty() ? 0 : innerOffsets[f + 1] - innerOffsets[f]; }
+
+  /**
+   * Imprime a DCEL no mesmo formato de DCEL::printDCELOutput
+   * @param pool Pool para formatar a seção de semi-arestas em paralelo (pode ser nulo)
+   */
+  void printDCELOutput(ThreadPool* pool = nullptr) const;
+
+  /**
+   * Escreve a DCEL no mesmo formato de DCEL::printDCELOutput, na numeração
+   * da entrada se a DCEL foi reordenada
+   * @param out Destino
+   * @param pool Pool para formatar a seção de semi-arestas em paralelo (pode ser nulo)
+   */
+  void printDCELOutput(OutputWriter& out, ThreadPool* pool = nullptr) const;
+
+  /**
+   * Memória ocupada pelos vetores da estrutura (capacidade alocada)
+   * @return Total em bytes
+   */
+  size_t memoryBytes() const;
+
+private:
+  void createVertices(const vector<pair<int, int>>& vertexCoords, ThreadPool* pool);
+  void createHalfEdgesAndFaces(const FaceList& faceVertices, const HoleAssignment& holes, ThreadPool* pool);
+  void linkTwins(const FaceList& faceVertices, ThreadPool* pool);
+};
+
+using CompactDCEL = BasicCompactDCEL<int32_t, uint32_t>;
+using WideCompactDCEL = BasicCompactDCEL<int32_t, uint64_t>;
+
+/**
+ * Constrói a malha na CompactDCEL mais estreita que a comporta e a entrega a
+ * fn: coordenadas de 32 bits (as da entrada) e índices de 32 bits, ou de 64
+ * quando alguma contagem não cabe em 32
+ * @param vertexCoords Vetor de coordenadas (x,y) dos vértices
+ * @param faceVertices Faces (CSR)
+ * @param fn Chamada com a DCEL construída (const BasicCompactDCEL<...>&)
+ * @param curve Se não nulo, constrói com buildFromMeshReordered ao longo dessa curva
+ * @param pool Pool para a construção em paralelo (pode ser nulo)
+ */
+template <class Fn>
+void selectCompactDCEL(const vector<pair<int, int>>& vertexCoords, const FaceList& faceVertices, Fn&& fn,
+                       const SpaceFillingCurve* curve = nullptr, ThreadPool* pool = nullptr) {
+  auto build = [&](auto& dcel) {
+    if (curve) {
+      dcel.buildFromMeshReordered(vertexCoords, faceVertices, *curve, pool);
+    } else {
+      dcel.buildFromMesh(vertexCoords, faceVertices, nullptr, pool);
+    }
+  };
+  if (CompactDCEL::fits(vertexCoords.size(), faceVertices.totalIndices(), faceVertices.size())) {
+    CompactDCEL dcel;
+    build(dcel);
+    fn(static_cast<const CompactDCEL&>(dcel));
+  } else {
+    WideCompactDCEL dcel;
+    build(dcel);
+    fn(static_cast<const WideCompactDCEL&>(dcel));
+  }
+}
+
+#endif // DCEL_SOA_HPP
@@ -0,0 +1,233 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef EDGE_TABLE_HPP
+#define EDGE_TABLE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "stats.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+
+// ---------- Classe EdgeTable ----------
+// Tabela hash de endereçamento aberto para arestas direcionadas (v1, v2).
+// A chave é o par empacotado em 64 bits com o bit de sinal de cada índice
+// invertido, de modo que a ordem das chaves é a ordem lexicográfica de
+// pair<int, int> (inclusive para índices negativos de entradas inválidas).
+// Chave e valor ficam lado a lado no mesmo slot: uma consulta costuma custar
+// uma única linha de cache. A capacidade é fixada na construção (potência de
+// 2, pelo menos o dobro das chaves esperadas) e a sondagem é linear. Não há
+// remoção; quem precisa "apagar" uma entrada guarda um valor nulo.
+//
+// A chave de (INT_MAX, INT_MAX) marca os slots vazios; índices de vértice
+// válidos são menores que o número de vértices, que cabe em int.
+template <class T>
+class EdgeTable {
+public:
+  /**
+   * @param expected Número esperado de chaves distintas
+   */
+  explicit EdgeTable(size_t expected) {
+    size_t capacity = 16;
+    while (capacity < 2 * expected) capacity <<= 1;
+    slots.assign(capacity, Slot{EMPTY, T()});
+    mask = capacity - 1;
+    shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) shift--;
+  }
+
+  static uint64_t key(int v1, int v2) {
+    return (uint64_t(uint32_t(v1) ^ SIGN) << 32) | (uint32_t(v2) ^ SIGN);
+  }
+
+  static uint64_t reverse(uint64_t key) { return (key << 32) | (key >> 32); }
+
+  static int first(uint64_t key) { return int(uint32_t(key >> 32) ^ SIGN); }
+  static int second(uint64_t key) { return int(uint32_t(key) ^ SIGN); }
+
+  /**
+   * Encontra a chave ou a insere com o valor padrão
+   * @param key Chave de key(v1, v2)
+   * @param inserted Saída: true se a chave era nova
+   * @return Referência ao valor (válida até o fim da tabela)
+   */
+  T& findOrInsert(uint64_t key, bool& inserted) {
+    STATS_COUNT(STATS_MAP_LOOKUPS);
+    size_t i = slotOf(key);
+    while (slots[i].key != key) {
+      if (slots[i].key == EMPTY) {
+        slots[i].key = key;
+        used++;
+        inserted = true;
+        return slots[i].value;
+      }
+      i = (i + 1) & mask;
+    }
+    inserted = false;
+    return slots[i].value;
+  }
+
+  /**
+   * @return Ponteiro para o valor da chave, ou nulo se ela não estiver na tabela
+   */
+  T* find(uint64_t key) {
+    STATS_COUNT(STATS_MAP_LOOKUPS);
+    for (size_t i = slotOf(key);; i = (i + 1) & mask) {
+      if (slots[i].key == key) return &slots[i].value;
+      if (slots[i].key == EMPTY) return nullptr;
+    }
+  }
+
+  /**
+   * Visita as entradas em ordem de slot (não de chave)
+   * @param fn Chamada com (chave, valor)
+   */
+  template <class Fn>
+  void forEach(Fn&& fn) {
+    for (Slot& slot : slots) {
+      if (slot.key != EMPTY) fn(slot.key, slot.value);
+    }
+  }
+
+  size_t size() const { return used; }
+
+private:
+  static constexpr uint32_t SIGN = 0x80000000u;
+  static constexpr uint64_t EMPTY = ~uint64_t(0);
+
+  struct Slot {
+    uint64_t key;
+    T value;
+  };
+
+  vector<Slot> slots;
+  size_t mask = 0;
+  int shift = 64;
+  size_t used = 0;
+
+  // Hash multiplicativo (Fibonacci): os bits altos do produto misturam v1 e v2
+  size_t slotOf(uint64_t key) const { return size_t((key * 0x9E3779B97F4A7C15ull) >> shift); }
+};
+
+// ---------- Classe ConcurrentEdgeTable ----------
+// Tabela de gêmeas para a construção paralela: várias threads inserem ao
+// mesmo tempo, sem travas. A chave é a aresta não direcionada (menor, maior),
+// empacotada como em EdgeTable, e o slot guarda a semi-aresta de cada
+// sentido. Um slot vazio é tomado com compare-and-swap na chave; cada
+// sentido é escrito com compare-and-swap a partir de NONE, e um segundo
+// escritor no mesmo sentido (aresta repetida) marca o sentido como
+// DUPLICATE. Como as inserções só terminam no fim de uma passada paralela
+// (parallelFor espera o pool), a leitura dos pares dispensa ordenação de
+// memória: tudo é relaxed.
+//
+// Index é o tipo das semi-arestas (uint32_t ou uint64_t); NONE e DUPLICATE
+// são os dois maiores valores dele e não são índices válidos.
+template <class Index>
+class ConcurrentEdgeTable {
+public:
+  static constexpr Index NONE = numeric_limits<Index>::max();
+  static constexpr Index DUPLICATE = NONE - 1;
+
+  /**
+   * A capacidade passa do número de semi-arestas: mesmo numa entrada
+   * inválida, com cada uma numa aresta diferente, sobra slot vazio; numa
+   * malha válida (metade disso em arestas) a ocupação fica em no máximo 1/2
+   * @param halfEdges Número de semi-arestas a inserir
+   * @param pool Pool para limpar os slots em paralelo (pode ser nulo)
+   */
+  ConcurrentEdgeTable(size_t halfEdges, ThreadPool* pool) {
+    capacity = 16;
+    while (capacity <= halfEdges) capacity <<= 1;
+    slots.reset(new Slot[capacity]);
+    mask = capacity - 1;
+    shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) shift--;
+    parallelFor(pool, 0, capacity, grainFor(pool), [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        slots[i].key.store(EMPTY, memory_order_relaxed);
+        slots[i].half[0].store(NONE, memory_order_relaxed);
+        slots[i].half[1].store(NONE, memory_order_relaxed);
+      }
+    });
+  }
+
+  /**
+   * Registra a semi-aresta h de v1 para v2 (seguro entre threads)
+   * @return false se já havia uma semi-aresta de v1 para v2
+   */
+  bool insert(int v1, int v2, Index h) {
+    bool backward = v1 > v2;
+    uint64_t key = backward ? EdgeTable<Index>::key(v2, v1) : EdgeTable<Index>::key(v1, v2);
+    size_t i = size_t((key * 0x9E3779B97F4A7C15ull) >> shift);
+    for (;; i = (i + 1) & mask) {
+      uint64_t current = slots[i].key.load(memory_order_relaxed);
+      if (current == EMPTY) slots[i].key.compare_exchange_strong(current, key, memory_order_relaxed);
+      // Se a troca falhou, current é a chave de quem tomou o slot antes
+      if (current == EMPTY || current == key) break;
+    }
+    Index expected = NONE;
+    if (slots[i].half[backward].compare_exchange_strong(expected, h, memory_order_relaxed)) return true;
+    slots[i].half[backward].store(DUPLICATE, memory_order_relaxed);
+    return false;
+  }
+
+  /**
+   * Visita as arestas em paralelo, em blocos de slots
+   * @param pool Pool de threads (pode ser nulo)
+   * @param fn Chamada com (semi-aresta v1 < v2, semi-aresta v1 > v2), cada
+   *           uma NONE se ausente ou DUPLICATE se repetida
+   */
+  template <class Fn>
+  void forEach(ThreadPool* pool, Fn&& fn) const {
+    parallelFor(pool, 0, capacity, grainFor(pool), [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        if (slots[i].key.load(memory_order_relaxed) == EMPTY) continue;
+        fn(slots[i].half[0].load(memory_order_relaxed), slots[i].half[1].load(memory_order_relaxed));
+      }
+    });
+  }
+
+private:
+  static constexpr uint64_t EMPTY = ~uint64_t(0);
+
+  struct Slot {
+    atomic<uint64_t> key;
+    atomic<Index> half[2];
+  };
+
+  unique_ptr<Slot[]> slots;
+  size_t capacity = 0;
+  size_t mask = 0;
+  int shift = 64;
+
+  size_t grainFor(ThreadPool* pool) const {
+    return pool ? max<size_t>(4096, capacity / (8 * pool->size())) : capacity;
+  }
+};
+
+/**
+ * Baixa value para candidate se candidate for menor (seguro entre threads)
+ */
+template <class T>
+void atomicMin(atomic<T>& value, T candidate) {
+  T current = value.load(memory_order_relaxed);
+  while (candidate < current && !value.compare_exchange_weak(current, candidate, memory_order_relaxed)) {
+  }
+}
+
+#endif // EDGE_TABLE_HPP
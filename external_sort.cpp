@@ -0,0 +1,124 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "external_sort.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+using namespace std;
+
+SpillFile::SpillFile(const string& dir, size_t bufferBytes) : buffer(bufferBytes) {
+  string pattern = (dir.empty() ? string(".") : dir) + "/dcel-spill-XXXXXX";
+  vector<char> path(pattern.begin(), pattern.end());
+  path.push_back('\0');
+
+  fd = mkstemp(path.data());
+  if (fd < 0) {
+    throw runtime_error("não foi possível criar arquivo temporário em " + dir);
+  }
+  // Sem nome no diretório: o espaço é devolvido quando o descritor fecha
+  unlink(path.data());
+}
+
+SpillFile::~SpillFile() {
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+// ======================================================================================================================= //
+
+void SpillFile::flushWrite() {
+  const char* data = buffer.data();
+  size_t size = used;
+  while (size > 0) {
+    ssize_t n = pwrite(fd, data, size, fileSize);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      throw runtime_error("falha ao gravar arquivo temporário");
+    }
+    data += n;
+    size -= n;
+    fileSize += n;
+  }
+  used = 0;
+}
+
+// ======================================================================================================================= //
+
+void SpillFile::write(const void* data, size_t size) {
+  const char* src = static_cast<const char*>(data);
+  if (buffer.empty()) buffer.resize(1 << 20);
+
+  while (size > 0) {
+    if (used == buffer.size()) flushWrite();
+    size_t n = min(size, buffer.size() - used);
+    memcpy(buffer.data() + used, src, n);
+    used += n;
+    src += n;
+    size -= n;
+  }
+}
+
+// ======================================================================================================================= //
+
+void SpillFile::rewind(size_t bufferBytes) {
+  if (writing) {
+    flushWrite();
+    writing = false;
+  }
+  buffer.resize(max<size_t>(bufferBytes, 1));
+  buffer.shrink_to_fit();
+  used = pos = 0;
+  readOffset = 0;
+}
+
+// ======================================================================================================================= //
+
+size_t SpillFile::read(void* data, size_t size) {
+  char* dst = static_cast<char*>(data);
+  size_t done = 0;
+
+  while (done < size) {
+    if (pos == used) {
+      if (readOffset >= fileSize) break;
+      if (buffer.empty()) buffer.resize(1 << 20);
+      ssize_t n = pread(fd, buffer.data(), min<uint64_t>(buffer.size(), fileSize - readOffset), readOffset);
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        throw runtime_error("falha ao ler arquivo temporário");
+      }
+      if (n == 0) break;
+      readOffset += n;
+      used = n;
+      pos = 0;
+    }
+    size_t n = min(size - done, used - pos);
+    memcpy(dst + done, buffer.data() + pos, n);
+    pos += n;
+    done += n;
+  }
+  return done;
+}
+
+// ======================================================================================================================= //
+
+void SpillFile::release() {
+  if (writing) {
+    flushWrite();
+    writing = false;
+  }
+  vector<char>().swap(buffer);
+  used = pos = 0;
+}
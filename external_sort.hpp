@@ -0,0 +1,230 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef EXTERNAL_SORT_HPP
+#define EXTERNAL_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+// ---------- Classe SpillFile ----------
+// Arquivo temporário anônimo (removido do diretório assim que criado) com
+// buffer próprio: primeiro é escrito em sequência, depois lido em sequência
+// a partir do início quantas vezes for preciso.
+class SpillFile {
+public:
+  /**
+   * Cria o arquivo temporário
+   * @param dir Diretório onde o arquivo é criado
+   * @param bufferBytes Tamanho do buffer de escrita
+   * @throws runtime_error se não conseguir criar o arquivo
+   */
+  explicit SpillFile(const string& dir, size_t bufferBytes = 1 << 20);
+  ~SpillFile();
+
+  SpillFile(const SpillFile&) = delete;
+  SpillFile& operator=(const SpillFile&) = delete;
+
+  void write(const void* data, size_t size);
+
+  template <class T>
+  void put(const T& value) {
+    write(&value, sizeof(T));
+  }
+
+  /**
+   * Termina a escrita (se houver) e volta a leitura para o início
+   * @param bufferBytes Tamanho do buffer de leitura
+   */
+  void rewind(size_t bufferBytes = 1 << 20);
+
+  /**
+   * Lê até size bytes na posição corrente
+   * @return Bytes lidos (menos que size só no fim do arquivo)
+   */
+  size_t read(void* data, size_t size);
+
+  template <class T>
+  bool get(T& value) {
+    return read(&value, sizeof(T)) == sizeof(T);
+  }
+
+  /**
+   * Libera o buffer (o conteúdo já escrito continua no arquivo)
+   */
+  void release();
+
+  uint64_t bytes() const { return fileSize + (writing ? used : 0); }
+
+private:
+  int fd = -1;
+  vector<char> buffer;
+  size_t used = 0;        // bytes válidos no buffer
+  size_t pos = 0;         // próxima posição de leitura no buffer
+  uint64_t fileSize = 0;  // bytes já gravados no arquivo
+  uint64_t readOffset = 0;
+  bool writing = true;
+
+  void flushWrite();
+};
+
+// ======================================================================================================================= //
+
+// ---------- Classe ExternalSorter ----------
+// Ordenação externa: os valores entram com push; quando o buffer atinge o
+// orçamento de memória, ele é ordenado e gravado como uma "run" num arquivo
+// temporário. Em finish as runs são intercaladas (em várias passadas, se
+// forem muitas para o orçamento) e next devolve os valores em ordem.
+// Sem nenhuma run gravada, tudo acontece em memória.
+template <class T, class Less = less<T>>
+class ExternalSorter {
+  static_assert(is_trivially_copyable<T>::value, "ExternalSorter grava os valores byte a byte");
+
+public:
+  /**
+   * @param memoryBytes Orçamento de memória (buffer das runs e da intercalação)
+   * @param tmpDir Diretório dos arquivos temporários
+   * @param less Ordem dos valores
+   */
+  ExternalSorter(size_t memoryBytes, const string& tmpDir, Less less = Less())
+      : memoryBytes(max(memoryBytes, MIN_RUN_BUFFER * 2)), tmpDir(tmpDir), less(less) {
+    capacity = max<size_t>(1, this->memoryBytes / sizeof(T));
+  }
+
+  void push(const T& value) {
+    if (buffer.size() == capacity) spill();
+    buffer.push_back(value);
+    total++;
+  }
+
+  /**
+   * Encerra a entrada e prepara a leitura em ordem
+   */
+  void finish() {
+    if (runs.empty()) {
+      sort(buffer.begin(), buffer.end(), less);
+      memPos = 0;
+      return;
+    }
+    if (!buffer.empty()) spill();
+    vector<T>().swap(buffer);
+
+    // Intercala grupos de runs até que todas caibam numa única passada
+    size_t fanIn = max<size_t>(2, memoryBytes / MIN_RUN_BUFFER);
+    while (runs.size() > fanIn) {
+      vector<unique_ptr<SpillFile>> group;
+      for (size_t i = 0; i < fanIn; i++) group.push_back(move(runs[i]));
+      runs.erase(runs.begin(), runs.begin() + fanIn);
+
+      auto merged = make_unique<SpillFile>(tmpDir);
+      startMerge(group);
+      T value;
+      while (popMerge(value)) merged->put(value);
+      merged->release();
+      runs.push_back(move(merged));
+    }
+    startMerge(runs);
+  }
+
+  /**
+   * Próximo valor em ordem (depois de finish)
+   * @return false quando acabarem os valores
+   */
+  bool next(T& value) {
+    if (merging) return popMerge(value);
+    if (memPos == buffer.size()) return false;
+    value = buffer[memPos++];
+    return true;
+  }
+
+  size_t size() const { return total; }
+  size_t runCount() const { return spilled; }
+
+private:
+  // Menor buffer de leitura por run na intercalação
+  static constexpr size_t MIN_RUN_BUFFER = 64 << 10;
+
+  size_t memoryBytes;
+  string tmpDir;
+  Less less;
+  size_t capacity;
+  vector<T> buffer;
+  size_t memPos = 0;
+  size_t total = 0;
+  size_t spilled = 0;
+  vector<unique_ptr<SpillFile>> runs;
+
+  // Estado da intercalação: heap de (cabeça, run)
+  bool merging = false;
+  vector<SpillFile*> sources;
+  vector<pair<T, size_t>> heap;
+
+  void spill() {
+    sort(buffer.begin(), buffer.end(), less);
+    auto run = make_unique<SpillFile>(tmpDir);
+    run->write(buffer.data(), buffer.size() * sizeof(T));
+    run->release();
+    runs.push_back(move(run));
+    buffer.clear();
+    spilled++;
+  }
+
+  // Comparação invertida: a heap da STL é de máximo
+  bool heapAfter(const pair<T, size_t>& a, const pair<T, size_t>& b) const {
+    if (less(b.first, a.first)) return true;
+    if (less(a.first, b.first)) return false;
+    return a.second > b.second; // empate: a run de menor índice sai primeiro
+  }
+
+  void startMerge(vector<unique_ptr<SpillFile>>& files) {
+    size_t perRun = max(MIN_RUN_BUFFER, memoryBytes / (files.size() + 1));
+    sources.clear();
+    heap.clear();
+    auto cmp = [this](const pair<T, size_t>& a, const pair<T, size_t>& b) { return heapAfter(a, b); };
+    for (auto& file : files) {
+      file->rewind(perRun);
+      T head;
+      if (file->get(head)) {
+        heap.push_back({head, sources.size()});
+        push_heap(heap.begin(), heap.end(), cmp);
+      }
+      sources.push_back(file.get());
+    }
+    merging = true;
+  }
+
+  bool popMerge(T& value) {
+    if (heap.empty()) return false;
+    auto cmp = [this](const pair<T, size_t>& a, const pair<T, size_t>& b) { return heapAfter(a, b); };
+    pop_heap(heap.begin(), heap.end(), cmp);
+    value = heap.back().first;
+    size_t src = heap.back().second;
+    heap.pop_back();
+
+    T head;
+    if (sources[src]->get(head)) {
+      heap.push_back({head, src});
+      push_heap(heap.begin(), heap.end(), cmp);
+    } else {
+      sources[src]->release();
+    }
+    return true;
+  }
+};
+
+#endif // EXTERNAL_SORT_HPP
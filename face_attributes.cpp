@@ -0,0 +1,36 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "face_attributes.hpp"
+#include "stats.hpp"
+
+using namespace std;
+
+// ======================================================================================================================= //
+
+FaceAttributes<int> faceAttributes(const vector<pair<int, int>> &coords, const FaceView &face) {
+  FaceAttributesBuilder<int> builder;
+  for (int idx : face) builder.add(coords[idx].first, coords[idx].second);
+  return builder.finish();
+}
+
+// ======================================================================================================================= //
+
+void computeFaceAttributes(const vector<pair<int, int>> &coords, const FaceList &faces,
+                           vector<FaceAttributes<int>> &attributes, ThreadPool *pool) {
+  STATS_TIMER(STATS_FACE_ATTRIBUTES);
+  attributes.resize(faces.size());
+
+  // Cada face é independente: blocos contíguos de faces por tarefa
+  size_t grain = pool ? max<size_t>(1024, faces.size() / (8 * pool->size())) : faces.size();
+  parallelFor(pool, 0, faces.size(), grain, [&](size_t lo, size_t hi) {
+    for (size_t f = lo; f < hi; ++f) attributes[f] = faceAttributes(coords, faces[f]);
+  });
+}
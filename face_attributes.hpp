@@ -0,0 +1,183 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef FACE_ATTRIBUTES_HPP
+#define FACE_ATTRIBUTES_HPP
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mesh.hpp"
+#include "predicates.hpp"
+#include "spatial_grid.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+
+// Atributos geométricos de uma face, calculados numa única passada pelo ciclo
+// de vértices: área com sinal, orientação, retângulo envolvente, centróide e
+// número de vértices. As validações, a edição e as consultas espaciais usam
+// estes valores em vez de montar um vector<pair> com o polígono de cada face.
+//
+// A orientação é exata. Com coordenadas de até 32 bits (ou double com valores
+// inteiros nessa faixa, como nas malhas lidas da entrada), é o sinal da soma
+// do shoelace em __int128, o mesmo de polygonOrientation. Fora dessa faixa,
+// é a orientação no vértice extremo, válida para polígonos simples.
+
+// ---------- Estrutura FaceAttributes ----------
+template <class Coord>
+struct FaceAttributes {
+  double area = 0;            // área com sinal (positiva = anti-horária)
+  double centroidX = 0;       // centróide da região (média dos vértices se a área for zero)
+  double centroidY = 0;
+  Coord minX = 0, minY = 0;   // retângulo envolvente (limites inclusivos)
+  Coord maxX = 0, maxY = 0;
+  uint32_t vertexCount = 0;
+  int orientation = 0;        // +1 anti-horária, -1 horária, 0 degenerada
+
+  /**
+   * Retângulo envolvente nas coordenadas inteiras das grades (arredondado para fora)
+   */
+  BoundingBox bbox() const {
+    return {static_cast<long long>(floor(minX)), static_cast<long long>(floor(minY)),
+            static_cast<long long>(ceil(maxX)), static_cast<long long>(ceil(maxY))};
+  }
+};
+
+// ---------- Classe FaceAttributesBuilder ----------
+// Acumula os vértices de um ciclo, em ordem, e produz os atributos da face
+template <class Coord>
+class FaceAttributesBuilder {
+public:
+  void add(Coord x, Coord y) {
+    if (count == 0) {
+      first = {x, y};
+      out.minX = out.maxX = x;
+      out.minY = out.maxY = y;
+      extreme = first;
+    } else {
+      addEdge(last, {x, y});
+      out.minX = min(out.minX, x);
+      out.maxX = max(out.maxX, x);
+      out.minY = min(out.minY, y);
+      out.maxY = max(out.maxY, y);
+      if (count == 1) afterFirst = {x, y};
+      if (extremeNeedsNext) {
+        afterExtreme = {x, y};
+        extremeNeedsNext = false;
+      }
+      if (make_pair(x, y) < extreme) {
+        extreme = {x, y};
+        beforeExtreme = last;
+        extremeNeedsNext = true;
+        extremeIsFirst = false;
+      }
+    }
+    exact = exact && fitsInt(x) && fitsInt(y);
+    sumX += static_cast<double>(x);
+    sumY += static_cast<double>(y);
+    last = {x, y};
+    count++;
+  }
+
+  FaceAttributes<Coord> finish() {
+    out.vertexCount = static_cast<uint32_t>(count);
+    if (count == 0) return out;
+    addEdge(last, first);
+
+    out.area = twiceArea / 2;
+    if (out.area != 0) {
+      out.centroidX = momentX / (3 * twiceArea);
+      out.centroidY = momentY / (3 * twiceArea);
+    } else {
+      out.centroidX = sumX / count;
+      out.centroidY = sumY / count;
+    }
+
+    if (count < 3) {
+      out.orientation = 0;
+    } else if (exact) {
+      out.orientation = (exactArea > 0) - (exactArea < 0);
+    } else {
+      // Vizinhos do vértice extremo, fechando o ciclo nas pontas
+      pair<Coord, Coord> before = extremeIsFirst ? last : beforeExtreme;
+      pair<Coord, Coord> after = extremeIsFirst ? afterFirst : (extremeNeedsNext ? first : afterExtreme);
+      out.orientation = orient2d(before, extreme, after);
+    }
+    return out;
+  }
+
+private:
+  FaceAttributes<Coord> out;
+  size_t count = 0;
+  pair<Coord, Coord> first{}, last{}, afterFirst{};
+  pair<Coord, Coord> extreme{}, beforeExtreme{}, afterExtreme{};
+  bool extremeIsFirst = true, extremeNeedsNext = false;
+  bool exact = true;
+  __int128 exactArea = 0;
+  double twiceArea = 0, momentX = 0, momentY = 0, sumX = 0, sumY = 0;
+
+  static bool fitsInt(Coord value) {
+    if constexpr (is_integral_v<Coord> && sizeof(Coord) <= sizeof(int32_t)) {
+      return true;
+    } else {
+      return value >= INT32_MIN && value <= INT32_MAX && static_cast<Coord>(static_cast<int64_t>(value)) == value;
+    }
+  }
+
+  void addEdge(const pair<Coord, Coord>& a, const pair<Coord, Coord>& b) {
+    double ax = static_cast<double>(a.first), ay = static_cast<double>(a.second);
+    double bx = static_cast<double>(b.first), by = static_cast<double>(b.second);
+    double cross = ax * by - bx * ay;
+    twiceArea += cross;
+    momentX += (ax + bx) * cross;
+    momentY += (ay + by) * cross;
+    if (exact && fitsInt(a.first) && fitsInt(a.second) && fitsInt(b.first) && fitsInt(b.second)) {
+      exactArea += static_cast<int64_t>(a.first) * static_cast<int64_t>(b.second) -
+                   static_cast<int64_t>(b.first) * static_cast<int64_t>(a.second);
+    }
+  }
+};
+
+/**
+ * Atributos de uma face dada por índices em coords
+ */
+FaceAttributes<int> faceAttributes(const vector<pair<int, int>> &coords, const FaceView &face);
+
+/**
+ * Calcula os atributos de todas as faces numa passada paralela
+ * @param coords Vetor de coordenadas (x,y) dos vértices
+ * @param faces Faces (CSR) com índices válidos
+ * @param attributes Saída: atributos de cada face, na ordem de faces
+ * @param pool Pool para dividir as faces entre threads (nulo = sequencial); a
+ *             passada espera o pool inteiro, então deve rodar antes de outras
+ *             tarefas serem submetidas a ele
+ */
+void computeFaceAttributes(const vector<pair<int, int>> &coords, const FaceList &faces,
+                           vector<FaceAttributes<int>> &attributes, ThreadPool *pool = nullptr);
+
+/**
+ * Verifica o sentido da face a partir dos atributos, com as mesmas exceções
+ * de isCounterClockwise
+ * @return true se estiver em CCW, false caso contrário
+ */
+template <class Coord>
+bool isCounterClockwise(const FaceAttributes<Coord> &attributes) {
+  if (attributes.vertexCount < 3) throw invalid_argument("Face inválida: menos de 3 vértices");
+  if (attributes.orientation == 0) throw invalid_argument("Face degenerada: área zero");
+  return attributes.orientation > 0;
+}
+
+#endif // FACE_ATTRIBUTES_HPP
@@ -0,0 +1,179 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "holes.hpp"
+#include "predicates.hpp"
+#include "stats.hpp"
+#include "sweep.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+
+using namespace std;
+
+// ======================================================================================================================= //
+
+// Representante do conjunto de v, com compressão de caminho pela metade
+static int findRoot(vector<int> &parent, int v) {
+  while (parent[v] != v) {
+    parent[v] = parent[parent[v]];
+    v = parent[v];
+  }
+  return v;
+}
+
+void findComponents(size_t numVertices, const FaceList &faces, MeshComponents &components) {
+  vector<int> parent(numVertices);
+  iota(parent.begin(), parent.end(), 0);
+  vector<char> used(numVertices, 0);
+
+  // Numa malha fechada cada aresta aparece nos dois sentidos: basta uni-la em um
+  for (const auto &face : faces) {
+    size_t n = face.size();
+    for (size_t i = 0; i < n; ++i) {
+      int u = face[i], v = face[(i + 1) % n];
+      used[u] = 1;
+      if (u > v) continue;
+      int a = findRoot(parent, u), b = findRoot(parent, v);
+      if (a != b) parent[max(a, b)] = min(a, b);
+    }
+  }
+
+  // Componentes numerados na ordem do menor vértice de cada um
+  components.vertexComponent.assign(numVertices, -1);
+  components.count = 0;
+  for (size_t v = 0; v < numVertices; ++v) {
+    if (!used[v]) continue;
+    int root = findRoot(parent, v);
+    if (components.vertexComponent[root] == -1) components.vertexComponent[root] = components.count++;
+    components.vertexComponent[v] = components.vertexComponent[root];
+  }
+}
+
+// ======================================================================================================================= //
+
+// Ordem do status da varredura, com busca por ponto: um segmento fica "antes"
+// do ponto se o ponto está estritamente acima dele
+struct HoleStatusOrder {
+  using is_transparent = void;
+  const vector<SweepSegment> *segs;
+
+  bool operator()(int a, int b) const { return segmentBelow((*segs)[a], (*segs)[b], a, b); }
+  bool operator()(int a, const pair<int, int> &pt) const {
+    return orient2d((*segs)[a].p, (*segs)[a].q, pt) > 0;
+  }
+  bool operator()(const pair<int, int> &pt, int a) const {
+    return orient2d((*segs)[a].p, (*segs)[a].q, pt) < 0;
+  }
+};
+
+void assignHoles(const vector<pair<int, int>> &verticesCoords, const FaceList &faces, HoleAssignment &holes) {
+  STATS_TIMER(STATS_HOLES);
+  holes.container.assign(faces.size(), -1);
+  holes.holes = 0;
+
+  MeshComponents components;
+  findComponents(verticesCoords.size(), faces, components);
+  if (components.count < 2) return;
+  const vector<int> &component = components.vertexComponent;
+
+  // Menor vértice de cada componente
+  vector<int> minVertex(components.count, -1);
+  for (size_t v = 0; v < verticesCoords.size(); ++v) {
+    int c = component[v];
+    if (c >= 0 && (minVertex[c] == -1 || verticesCoords[v] < verticesCoords[minVertex[c]])) minVertex[c] = v;
+  }
+
+  // Ciclo externo: o da semi-aresta que sai do menor vértice com o maior ângulo.
+  // Todas apontam para x >= 0, então "maior ângulo" é "mais à esquerda" (orientação exata)
+  vector<int> exterior(components.count, -1), exteriorTarget(components.count, -1);
+  for (size_t f = 0; f < faces.size(); ++f) {
+    const auto &face = faces[f];
+    size_t n = face.size();
+    for (size_t i = 0; i < n; ++i) {
+      int v = face[i], c = component[v];
+      if (v != minVertex[c]) continue;
+      int w = face[(i + 1) % n];
+      if (exterior[c] == -1 ||
+          orient2d(verticesCoords[v], verticesCoords[exteriorTarget[c]], verticesCoords[w]) > 0) {
+        exterior[c] = f;
+        exteriorTarget[c] = w;
+      }
+    }
+  }
+
+  // Varredura em x: em cada abscissa saem os segmentos que terminam e entram os
+  // que começam; verticais não separam nada à direita da linha e ficam de fora
+  vector<SweepSegment> segs = collectSegments(verticesCoords, faces);
+  vector<int> starts, ends;
+  for (size_t i = 0; i < segs.size(); ++i) {
+    if (segs[i].p.first == segs[i].q.first) continue;
+    starts.push_back(i);
+    ends.push_back(i);
+  }
+  sort(starts.begin(), starts.end(), [&](int a, int b) { return segs[a].p.first < segs[b].p.first; });
+  sort(ends.begin(), ends.end(), [&](int a, int b) { return segs[a].q.first < segs[b].q.first; });
+
+  // Consultas nos menores vértices, em ordem lexicográfica: a aresta abaixo de um
+  // componente começa num vértice menor, então o componente dela já foi resolvido
+  vector<int> order(components.count);
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(),
+       [&](int a, int b) { return verticesCoords[minVertex[a]] < verticesCoords[minVertex[b]]; });
+
+  set<int, HoleStatusOrder> status(HoleStatusOrder{&segs});
+  vector<int> containerOf(components.count, -1); // face (ciclo) que contém cada componente
+  size_t si = 0, ei = 0;
+  for (int c : order) {
+    const pair<int, int> &p = verticesCoords[minVertex[c]];
+    while ((ei < ends.size() && segs[ends[ei]].q.first <= p.first) ||
+           (si < starts.size() && segs[starts[si]].p.first <= p.first)) {
+      int x = ei < ends.size() ? segs[ends[ei]].q.first : segs[starts[si]].p.first;
+      if (si < starts.size()) x = min(x, segs[starts[si]].p.first);
+      for (; ei < ends.size() && segs[ends[ei]].q.first == x; ++ei) status.erase(ends[ei]);
+      for (; si < starts.size() && segs[starts[si]].p.first == x; ++si) status.insert(starts[si]);
+    }
+
+    // Aresta de outro componente logo abaixo de p (as do próprio componente que
+    // saem de p passam por ele e não ficam abaixo)
+    auto it = status.lower_bound(p);
+    while (it != status.begin()) {
+      --it;
+      const SweepSegment &s = segs[*it];
+      int other = component[s.u];
+      if (other == c) continue;
+
+      // Ciclo acima da aresta: o que a percorre da esquerda para a direita
+      int above = (s.from == s.u) ? s.face : s.twinFace;
+      if (above >= 0) containerOf[c] = above == exterior[other] ? containerOf[other] : above;
+      break;
+    }
+
+    if (containerOf[c] >= 0) {
+      holes.container[exterior[c]] = containerOf[c];
+      holes.holes++;
+    }
+  }
+}
+
+// ======================================================================================================================= //
+
+size_t numberFaces(const HoleAssignment &holes, size_t numCycles, vector<size_t> &cycleFace) {
+  cycleFace.resize(numCycles);
+  size_t numFaces = 0;
+  for (size_t c = 0; c < numCycles; ++c) {
+    if (!holes.isHole(c)) cycleFace[c] = numFaces++;
+  }
+  for (size_t c = 0; c < numCycles; ++c) {
+    if (holes.isHole(c)) cycleFace[c] = cycleFace[holes.container[c]];
+  }
+  return numFaces;
+}
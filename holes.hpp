@@ -0,0 +1,77 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef HOLES_HPP
+#define HOLES_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "mesh.hpp"
+
+using namespace std;
+
+// Componentes internos (buracos). Uma malha pode ter vários componentes
+// conexos, e um deles pode ficar no interior de uma face limitada de outro
+// (ilhas, lagos, enclaves). O ciclo externo do componente aninhado não é
+// uma face: é um componente interno da face que o contém.
+//
+// O ciclo externo de um componente é o que passa à esquerda do seu menor
+// vértice (menor x, depois menor y): o da semi-aresta que sai dele com o
+// maior ângulo. A face que contém o componente sai de uma varredura em x
+// sobre as arestas: no menor vértice p, a aresta de outro componente logo
+// abaixo de p tem acima dela o ciclo em volta de p. Se esse ciclo for o
+// externo do outro componente, p está na mesma região que ele. Essa aresta
+// começa num vértice menor que p, então os componentes formam uma floresta
+// e cada um é resolvido quando a varredura chega a ele, em O(n log n) no
+// total. Componentes sem aresta abaixo ficam na região ilimitada, e o ciclo
+// externo deles continua sendo uma face, como antes.
+
+// Componente conexo de cada vértice (-1 para vértices fora de todas as faces)
+struct MeshComponents {
+  vector<int> vertexComponent;
+  size_t count = 0;
+};
+
+// Buracos de uma malha, por ciclo da entrada
+struct HoleAssignment {
+  vector<int> container; // -1 se o ciclo é uma face; senão, o ciclo da face que o contém
+  size_t holes = 0;
+
+  bool isHole(size_t cycle) const { return !container.empty() && container[cycle] >= 0; }
+};
+
+/**
+ * Separa os vértices em componentes conexos pelas arestas das faces (union-find)
+ * @param numVertices Número de vértices
+ * @param faces Faces (CSR) de uma malha fechada (cada aresta nos dois sentidos)
+ * @param components Saída: componente de cada vértice e número de componentes
+ */
+void findComponents(size_t numVertices, const FaceList &faces, MeshComponents &components);
+
+/**
+ * Atribui o ciclo externo de cada componente aninhado à face que o contém
+ * @param verticesCoords Vetor de coordenadas (x,y) dos vértices
+ * @param faces Faces (CSR) de uma malha válida
+ * @param holes Saída: face que contém cada ciclo que é buraco
+ */
+void assignHoles(const vector<pair<int, int>> &verticesCoords, const FaceList &faces, HoleAssignment &holes);
+
+/**
+ * Numeração das faces: os ciclos que não são buracos, na ordem da entrada
+ * @param holes Buracos de assignHoles
+ * @param numCycles Número de ciclos da entrada
+ * @param cycleFace Saída: face de cada ciclo (a face que contém, para os buracos)
+ * @return Número de faces
+ */
+size_t numberFaces(const HoleAssignment &holes, size_t numCycles, vector<size_t> &cycleFace);
+
+#endif // HOLES_HPP
@@ -8,54 +8,254 @@
  * Motivo: Trabalho 2 da disciplina de Geometria Computacional
  *
  ************************************************************************/
+#include "batch.hpp"
 #include "dcel.hpp"
+#include "dcel_binary.hpp"
+#include "dcel_soa.hpp"
+#include "mesh_editor.hpp"
+#include "mesh_io.hpp"
+#include "overlay.hpp"
+#include "point_location.hpp"
+#include "reorder.hpp"
+#include "stats.hpp"
+#include "stream_dcel.hpp"
+#include <fstream>
 #include <iostream>
-#include <sstream>
+#include <memory>
 #include <vector>
+#include <sstream>
 #include <string>
+#include <cstdlib>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
 using namespace std;
 
+// Com -j, a construção da DCEL e a formatação da saída também usam um pool de
+// threads (criado depois da validação)
+static unique_ptr<ThreadPool> makePool(unsigned threads) {
+  return threads > 1 ? make_unique<ThreadPool>(threads) : nullptr;
+}
+
+// Com --stats, o relatório de fases e contadores vai para stderr na saída de main,
+// seja qual for o caminho de retorno
+struct StatsReport {
+  bool enabled = false;
+  ~StatsReport() {
+    if (enabled) writeStatsReport(cerr);
+  }
+};
+
+// Aplica um roteiro de edições (--edit), uma por linha, com ids base 1 da DCEL atual:
+//   split-face a b | remove-edge h | split-edge h x y | move-vertex v x y
+// Edições recusadas são relatadas em stderr e não alteram a DCEL
+static bool applyEdits(EditDCEL& dcel, const string& file) {
+  ifstream script(file);
+  if (!script) {
+    cerr << "Não foi possível abrir " << file << endl;
+    return false;
+  }
+  MeshEditor editor(dcel);
+  auto halfEdge = [&](size_t id) { return id >= 1 && id <= dcel.halfEdges.size() ? dcel.halfEdges[id - 1] : nullptr; };
+  auto vertex = [&](size_t id) { return id >= 1 && id <= dcel.vertices.size() ? dcel.vertices[id - 1] : nullptr; };
+
+  string line;
+  for (size_t lineNo = 1; getline(script, line); lineNo++) {
+    istringstream in(line);
+    string op, errorMessage;
+    size_t a = 0, b = 0;
+    int x = 0, y = 0;
+    if (!(in >> op)) continue;
+
+    bool ok;
+    if (op == "split-face" && in >> a >> b) {
+      ok = editor.splitFace(halfEdge(a), halfEdge(b), errorMessage);
+    } else if (op == "remove-edge" && in >> a) {
+      ok = editor.removeEdge(halfEdge(a), errorMessage);
+    } else if (op == "split-edge" && in >> a >> x >> y) {
+      ok = editor.splitEdge(halfEdge(a), x, y, errorMessage);
+    } else if (op == "move-vertex" && in >> a >> x >> y) {
+      ok = editor.moveVertex(vertex(a), x, y, errorMessage);
+    } else {
+      ok = false;
+      errorMessage = "comando inválido";
+    }
+    if (!ok) {
+      cerr << file << ":" << lineNo << ": " << errorMessage << endl;
+    }
+  }
+  return true;
+}
+
 int main(int argc, char* argv[]) {
   bool verbose = false;
-  // Verifica se é modo verbose para debug
+  bool compact = false;
+  unsigned threads = 1;
+  bool threadsGiven = false;
+  bool batch = false;
+  vector<string> batchInputs;
+  BatchOptions batchOptions;
+  string saveBin, loadBin, locateFile, editFile, overlayFile;
+  bool streaming = false;
+  bool skipGeometry = false;
+  bool reorder = false;
+  SpaceFillingCurve curve = CURVE_HILBERT;
+  StatsReport stats;
+  StreamOptions streamOptions;
+  if (const char* tmp = getenv("TMPDIR")) {
+    streamOptions.tmpDir = tmp;
+  }
+  // Verifica se é modo verbose para debug, se deve usar a DCEL compacta (SoA),
+  // quantas threads usar na validação e na construção (-j N), se deve gravar/ler a DCEL binária
+  // se deve construir fora de memória (--stream --skip-geometry, --mem-budget MB, --tmp dir)
+  // se deve localizar pontos nas faces em vez de imprimir a DCEL (--locate arquivo)
+  // se deve aplicar edições à DCEL antes de imprimi-la (--edit arquivo)
+  // se deve construir a DCEL compacta ao longo de uma curva (--reorder hilbert|morton, implica --soa)
+  // se deve sobrepor a malha a outra e imprimir a subdivisão combinada (--overlay arquivo)
+  // se deve relatar tempos por fase e contadores em JSON no stderr (--stats)
+  // e se deve processar várias malhas em lote (--batch [--out-dir dir] entradas...)
   for (int i = 1; i < argc; ++i) {
-    if (string(argv[i]) == "-v") {
+    string arg = argv[i];
+    if (arg == "-v") {
       verbose = true;
-      break;
+    } else if (arg == "--soa") {
+      compact = true;
+    } else if (arg == "-j" && i + 1 < argc) {
+      threads = max(1, atoi(argv[++i]));
+      threadsGiven = true;
+    } else if (arg.rfind("-j", 0) == 0 && arg.size() > 2) {
+      threads = max(1, atoi(arg.c_str() + 2));
+      threadsGiven = true;
+    } else if (arg == "--save-bin" && i + 1 < argc) {
+      saveBin = argv[++i];
+    } else if (arg == "--load-bin" && i + 1 < argc) {
+      loadBin = argv[++i];
+    } else if (arg == "--locate" && i + 1 < argc) {
+      locateFile = argv[++i];
+    } else if (arg == "--edit" && i + 1 < argc) {
+      editFile = argv[++i];
+    } else if (arg == "--overlay" && i + 1 < argc) {
+      overlayFile = argv[++i];
+    } else if (arg == "--reorder" && i + 1 < argc) {
+      string name = argv[++i];
+      if (!parseSpaceFillingCurve(name, curve)) {
+        cerr << "Curva desconhecida: " << name << " (use hilbert ou morton)" << endl;
+        return 1;
+      }
+      reorder = true;
+      compact = true;
+    } else if (arg == "--stats") {
+      stats.enabled = true;
+    } else if (arg == "--stream") {
+      streaming = true;
+    } else if (arg == "--skip-geometry") {
+      skipGeometry = true;
+    } else if (arg == "--mem-budget" && i + 1 < argc) {
+      streamOptions.memoryBudget = size_t(max(1, atoi(argv[++i]))) << 20;
+    } else if (arg == "--tmp" && i + 1 < argc) {
+      streamOptions.tmpDir = argv[++i];
+    } else if (arg == "--batch") {
+      batch = true;
+    } else if (arg == "--out-dir" && i + 1 < argc) {
+      batchOptions.outDir = argv[++i];
+    } else if (arg == "-" || arg[0] != '-') {
+      batchInputs.push_back(arg);
+    }
+  }
+
+  // --save-bin grava a DCEL da entrada como construída: não há DCEL equivalente
+  // a gravar depois de uma edição, de uma reordenação, nem nos outros modos
+  if (!saveBin.empty()) {
+    const char* conflict = !editFile.empty()     ? "--edit"
+                           : reorder             ? "--reorder"
+                           : !locateFile.empty() ? "--locate"
+                           : !overlayFile.empty() ? "--overlay"
+                           : !loadBin.empty()    ? "--load-bin"
+                           : streaming           ? "--stream"
+                           : batch               ? "--batch"
+                                                 : nullptr;
+    if (conflict) {
+      cerr << "--save-bin não pode ser combinado com " << conflict << endl;
+      return 1;
     }
   }
 
-  int n, f;
-  cin >> n >> f;
-  vector<pair<int, int>> vertices(n);
+  if (batch) {
+    // Lote: paralelismo entre malhas (cada uma é validada numa só thread); sem -j, um worker por núcleo
+    batchOptions.threads = threadsGiven ? threads : max(1u, thread::hardware_concurrency());
+    if (batchInputs.empty()) {
+      batchInputs.push_back("-");
+    }
+    return runBatch(batchInputs, batchOptions) == 0 ? 0 : 1;
+  }
 
-  // Lê os vértices
-  for (int i = 0; i < n; ++i) {
-    int x, y;
-    cin >> x >> y;
-    vertices[i] = {x, y};
+  if (skipGeometry && !streaming) {
+    cerr << "--skip-geometry só vale com --stream" << endl;
+    return 1;
   }
 
-  // Lê as faces
-  vector<vector<int>> faces(f);
-  for (int i = 0; i < f; ++i) {
-    int v;
-    faces[i] = vector<int>();
-    string line;
-    getline(cin >> ws, line); // Lê a linha inteira ignorando whitespace anterior
-    istringstream iss(line);
-    while (iss >> v) {
-      faces[i].push_back(v-1);
+  if (streaming) {
+    // Construção fora de memória: só validação topológica. Uma malha superposta
+    // sairia como DCEL válida, então o modo só roda com a renúncia explícita
+    if (!skipGeometry) {
+      cerr << "--stream não verifica superposição nem componentes aninhados; "
+              "use --stream --skip-geometry para aceitar a malha sem essas verificações"
+           << endl;
+      return 1;
+    }
+    cerr << "Aviso: --skip-geometry: a malha não é verificada quanto a superposição" << endl;
+    try {
+      string errorMessage;
+      InputScanner in(STDIN_FILENO);
+      OutputWriter out(STDOUT_FILENO);
+      if (!streamDCEL(in, out, streamOptions, errorMessage)) {
+        cout << errorMessage << endl;
+        return 1;
+      }
+      out.flush();
+    } catch (const exception& e) {
+      cerr << "Erro na construção fora de memória: " << e.what() << endl;
+      return 1;
     }
+    return 0;
   }
 
+  if (!loadBin.empty()) {
+    // Carrega a DCEL binária; só revalida se ela não foi validada ao ser gravada
+    try {
+      MappedDCEL dcel(loadBin);
+      if (!dcel.validated()) {
+        Mesh mesh = dcel.toMesh();
+        string errorMessage;
+        if (!checkMesh(mesh.vertices, mesh.faces, errorMessage, threads)) {
+          cout << errorMessage << endl;
+          return 1;
+        }
+      }
+      dcel.printDCELOutput(makePool(threads).get());
+    } catch (const exception& e) {
+      cerr << "Erro ao carregar DCEL binária: " << e.what() << endl;
+      return 1;
+    }
+    return 0;
+  }
+
+  // Lê a malha da entrada padrão (mapeada, se for um arquivo)
+  Mesh mesh;
+  {
+    InputScanner in(STDIN_FILENO);
+    readMesh(in, mesh);
+  }
+  const auto& vertices = mesh.vertices;
+  const auto& faces = mesh.faces;
+
   if (verbose) {
     debugPrintMesh(vertices, faces);
   }
 
   // Verifica a validade da malha
   string errorMessage;
-  bool isValid = checkMesh(vertices, faces, errorMessage);
+  bool isValid = checkMesh(vertices, faces, errorMessage, threads);
   
   if (!isValid) {
     // Se a malha não for válida, imprime a mensagem de erro e termina
@@ -63,17 +263,112 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  unique_ptr<ThreadPool> pool = makePool(threads);
+
   try {
+    if (!locateFile.empty()) {
+      // Localização: uma linha por ponto com a face (base 1) que o contém, 0 se fora da malha
+      int fd = open(locateFile.c_str(), O_RDONLY);
+      if (fd < 0) {
+        cerr << "Não foi possível abrir " << locateFile << endl;
+        return 1;
+      }
+      vector<pair<int, int>> points;
+      {
+        InputScanner in(fd);
+        readPoints(in, points);
+      }
+      close(fd);
+
+      CompactDCEL dcel;
+      dcel.buildFromMesh(vertices, faces, nullptr, pool.get());
+      PointLocator locator(dcel);
+      vector<int> located;
+      locator.locate(points, located, pool.get());
+
+      OutputWriter out(STDOUT_FILENO);
+      for (int f : located) {
+        out.putUInt(f + 1);
+        out.put('\n');
+      }
+      out.flush();
+      return 0;
+    }
+
+    if (!overlayFile.empty()) {
+      // Sobreposição: a outra malha também precisa ser válida; a saída é a DCEL
+      // combinada, com as faces de origem em cada linha de face
+      int fd = open(overlayFile.c_str(), O_RDONLY);
+      if (fd < 0) {
+        cerr << "Não foi possível abrir " << overlayFile << endl;
+        return 1;
+      }
+      Mesh other;
+      {
+        InputScanner in(fd);
+        readMesh(in, other);
+      }
+      close(fd);
+      if (!checkMesh(other.vertices, other.faces, errorMessage, threads)) {
+        cout << overlayFile << ": " << errorMessage << endl;
+        return 1;
+      }
+
+      DCEL first, second;
+      first.buildFromMesh(vertices, faces, nullptr, pool.get());
+      second.buildFromMesh(other.vertices, other.faces, nullptr, pool.get());
+      OverlayResult overlay;
+      if (!overlayDCEL(first, second, overlay, errorMessage)) {
+        cout << errorMessage << endl;
+        return 1;
+      }
+      OutputWriter out(STDOUT_FILENO);
+      printOverlayOutput(overlay, out);
+      out.flush();
+      return 0;
+    }
+
     // Constrói a DCEL, pois a malha é válida
-    DCEL dcel;
-    dcel.buildFromMesh(vertices, faces);
-    
-    // Gera a saída no formato requerido
-    dcel.printDCELOutput();
+    if (!saveBin.empty()) {
+      // O formato binário guarda índices de 32 bits; a saída sai da mesma DCEL
+      CompactDCEL dcel;
+      dcel.buildFromMesh(vertices, faces, nullptr, pool.get());
+      saveBinaryDCEL(dcel, saveBin, true);
+      dcel.printDCELOutput(pool.get());
+      return 0;
+    } else if (compact && editFile.empty()) {
+      // Reordenada ou não, a saída usa a numeração da entrada
+      selectCompactDCEL(
+          vertices, faces, [&](const auto& dcel) { dcel.printDCELOutput(pool.get()); },
+          reorder ? &curve : nullptr, pool.get());
+      return 0;
+    }
+
+    if (!editFile.empty()) {
+      // A edição só cria vértices inteiros: DCEL de coordenadas int64_t (ver mesh_editor.hpp)
+      EditDCEL dcel;
+      dcel.buildFromMesh(vertices, faces, nullptr, pool.get());
+      if (!applyEdits(dcel, editFile)) {
+        return 1;
+      }
+      dcel.printDCELOutput(pool.get());
+      return 0;
+    }
+
+    // Só construir e imprimir: a instanciação mais estreita que comporta a malha
+    if (BasicDCEL<int32_t, uint32_t>::fits(vertices.size(), faces.totalIndices(), faces.size())) {
+      BasicDCEL<int32_t, uint32_t> dcel;
+      dcel.buildFromMesh(vertices, faces, nullptr, pool.get());
+      dcel.printDCELOutput(pool.get());
+    } else {
+      BasicDCEL<int32_t, uint64_t> dcel;
+      dcel.buildFromMesh(vertices, faces, nullptr, pool.get());
+      dcel.printDCELOutput(pool.get());
+    }
     
   } catch (const exception& e) {
     // Em caso de erro na construção da DCEL
-    if (verbose) {
+    if (verbose || !saveBin.empty() || !locateFile.empty() || !overlayFile.empty()) {
       cerr << "Erro ao construir DCEL: " << e.what() << endl;
     }
     return 1;
@@ -0,0 +1,104 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef MESH_HPP
+#define MESH_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// ---------- Classe FaceView ----------
+// Visão (sem cópia) dos índices de vértices de uma face
+class FaceView {
+public:
+  FaceView(const int* first, const int* last) : first(first), last(last) {}
+
+  size_t size() const { return static_cast<size_t>(last - first); }
+  bool empty() const { return first == last; }
+  const int& operator[](size_t i) const { return first[i]; }
+  const int* begin() const { return first; }
+  const int* end() const { return last; }
+
+private:
+  const int* first;
+  const int* last;
+};
+
+// ---------- Classe FaceList ----------
+// Faces em formato CSR: os índices de todas as faces ficam em um único vetor
+// e offsets[f]..offsets[f+1] delimita a face f. Substitui vector<vector<int>>,
+// que faz uma alocação por face.
+class FaceList {
+public:
+  vector<size_t> offsets{0};
+  vector<int> indices;
+
+  FaceList() = default;
+
+  FaceList(initializer_list<initializer_list<int>> faces) {
+    for (const auto& face : faces) addFace(face.begin(), face.end());
+  }
+
+  explicit FaceList(const vector<vector<int>>& faces) {
+    for (const auto& face : faces) addFace(face.begin(), face.end());
+  }
+
+  size_t size() const { return offsets.size() - 1; }
+  bool empty() const { return size() == 0; }
+  size_t totalIndices() const { return indices.size(); }
+
+  FaceView operator[](size_t f) const {
+    return FaceView(indices.data() + offsets[f], indices.data() + offsets[f + 1]);
+  }
+
+  void reserve(size_t faces, size_t totalIndices) {
+    offsets.reserve(faces + 1);
+    indices.reserve(totalIndices);
+  }
+
+  // Acrescenta índices à face em construção; closeFace() a encerra
+  void push(int vertex) { indices.push_back(vertex); }
+  void closeFace() { offsets.push_back(indices.size()); }
+
+  template <typename It>
+  void addFace(It first, It last) {
+    indices.insert(indices.end(), first, last);
+    closeFace();
+  }
+
+  // Iteração por faces (range-for)
+  class const_iterator {
+  public:
+    const_iterator(const FaceList* list, size_t f) : list(list), f(f) {}
+    FaceView operator*() const { return (*list)[f]; }
+    const_iterator& operator++() { ++f; return *this; }
+    bool operator!=(const const_iterator& o) const { return f != o.f; }
+    bool operator==(const const_iterator& o) const { return f == o.f; }
+
+  private:
+    const FaceList* list;
+    size_t f;
+  };
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size()); }
+};
+
+// Malha de entrada: coordenadas dos vértices e faces (índices base 0)
+struct Mesh {
+  vector<pair<int, int>> vertices;
+  FaceList faces;
+};
+
+#endif // MESH_HPP
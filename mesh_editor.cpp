@@ -0,0 +1,527 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "mesh_editor.hpp"
+#include "dcel_ranges.hpp"
+
+#include <algorithm>
+#include <climits>
+
+using namespace std;
+
+// Coordenadas de um vértice: as da malha e as das edições cabem em int
+static pair<int, int> coordOf(const EditVertex *v) {
+  return {static_cast<int>(v->x), static_cast<int>(v->y)};
+}
+
+// Retângulo envolvente do segmento de uma semi-aresta
+static BoundingBox edgeBox(const EditHalfEdge *he) {
+  pair<int, int> a = coordOf(he->origin), b = coordOf(he->next->origin);
+  return {min(a.first, b.first), min(a.second, b.second), max(a.first, b.first), max(a.second, b.second)};
+}
+
+// Segmento no formato da varredura; u/v são os ids dos vértices
+static SweepSegment segmentOf(const EditHalfEdge *he) {
+  const EditVertex *a = he->origin, *b = he->next->origin;
+  SweepSegment s;
+  s.from = static_cast<int>(a->id);
+  s.to = static_cast<int>(b->id);
+  if (coordOf(b) < coordOf(a)) swap(a, b);
+  s.p = coordOf(a);
+  s.q = coordOf(b);
+  s.u = static_cast<int>(a->id);
+  s.v = static_cast<int>(b->id);
+  s.face = s.twinFace = -1;
+  return s;
+}
+
+// Sinal exato da área do ciclo da face (positivo se anti-horária), guardado na face
+static int signOf(const EditFace *f) { return f->attributes().orientation; }
+
+// Os testes locais da edição só olham o ciclo externo de cada face: faces com
+// componentes internos (buracos) não são editadas
+static const char *INNER_COMPONENTS = "face com componentes internos";
+static bool hasInner(const EditFace *f) { return f->innerCount > 0; }
+
+// Faces em volta de um vértice (uma por semi-aresta que sai dele)
+static vector<EditFace *> facesAround(const EditVertex *v) {
+  auto faces = vertexFaces(v);
+  return vector<EditFace *>(faces.begin(), faces.end());
+}
+
+// ======================================================================================================================= //
+
+MeshEditor::MeshEditor(EditDCEL &dcel) : dcel(dcel) {
+  BoundingBox bounds{LLONG_MAX, LLONG_MAX, LLONG_MIN, LLONG_MIN};
+  for (const EditVertex *v : dcel.vertices) {
+    pair<int, int> c = coordOf(v);
+    bounds.minX = min<long long>(bounds.minX, c.first);
+    bounds.minY = min<long long>(bounds.minY, c.second);
+    bounds.maxX = max<long long>(bounds.maxX, c.first);
+    bounds.maxY = max<long long>(bounds.maxY, c.second);
+  }
+  if (dcel.vertices.empty()) bounds = {0, 0, 0, 0};
+
+  edgeGrid = BucketGrid<EditHalfEdge *>(bounds, dcel.halfEdges.size());
+  vertexGrid = BucketGrid<EditVertex *>(bounds, dcel.vertices.size());
+  for (EditHalfEdge *he : dcel.halfEdges) indexEdge(he);
+  for (EditVertex *v : dcel.vertices) indexVertex(v);
+}
+
+// ======================================================================================================================= //
+
+void MeshEditor::indexEdge(EditHalfEdge *he) { edgeGrid.insert(he, edgeBox(he)); }
+void MeshEditor::unindexEdge(EditHalfEdge *he) { edgeGrid.erase(he, edgeBox(he)); }
+
+void MeshEditor::indexVertex(EditVertex *v) {
+  pair<int, int> c = coordOf(v);
+  vertexGrid.insert(v, {c.first, c.second, c.first, c.second});
+}
+
+void MeshEditor::unindexVertex(EditVertex *v) {
+  pair<int, int> c = coordOf(v);
+  vertexGrid.erase(v, {c.first, c.second, c.first, c.second});
+}
+
+size_t MeshEditor::newStamp() {
+  if (vertexStamp.size() < dcel.vertices.size()) vertexStamp.resize(dcel.vertices.size(), 0);
+  return ++stampCounter;
+}
+
+// ======================================================================================================================= //
+
+EditHalfEdge *MeshEditor::linkSplitFace(EditHalfEdge *a, EditHalfEdge *b) {
+  EditFace *f = a->incidentFace;
+  EditFace *g = dcel.addFace();
+  EditHalfEdge *h1 = dcel.addHalfEdge(); // origem(a) -> origem(b), fica em f
+  EditHalfEdge *h2 = dcel.addHalfEdge(); // origem(b) -> origem(a), fica em g
+  EditHalfEdge *ap = a->prev, *bp = b->prev;
+
+  h1->origin = a->origin;
+  h2->origin = b->origin;
+  h1->twin = h2;
+  h2->twin = h1;
+
+  // f: ... ap -> h1 -> b ...   g: a ... bp -> h2 -> a
+  ap->next = h1;
+  h1->prev = ap;
+  h1->next = b;
+  b->prev = h1;
+  bp->next = h2;
+  h2->prev = bp;
+  h2->next = a;
+  a->prev = h2;
+
+  h1->incidentFace = f;
+  EditHalfEdge *he = h2;
+  do {
+    he->incidentFace = g;
+    he = he->next;
+  } while (he != h2);
+
+  f->outerComponent = h1;
+  g->outerComponent = h2;
+  f->invalidateAttributes();
+  g->invalidateAttributes();
+  return h1;
+}
+
+// ======================================================================================================================= //
+
+void MeshEditor::unlinkEdge(EditHalfEdge *e) {
+  EditHalfEdge *t = e->twin;
+  EditFace *f = e->incidentFace, *g = t->incidentFace;
+  EditHalfEdge *ep = e->prev, *en = e->next, *tp = t->prev, *tn = t->next;
+
+  for (EditHalfEdge *he = tn; he != t; he = he->next) he->incidentFace = f;
+
+  ep->next = tn;
+  tn->prev = ep;
+  tp->next = en;
+  en->prev = tp;
+
+  if (f->outerComponent == e) f->outerComponent = en;
+  f->invalidateAttributes();
+  if (e->origin->incidentEdge == e) e->origin->incidentEdge = tn;
+  if (t->origin->incidentEdge == t) t->origin->incidentEdge = en;
+
+  dcel.removeHalfEdge(e);
+  dcel.removeHalfEdge(t);
+  dcel.removeFace(g);
+}
+
+// ======================================================================================================================= //
+
+EditVertex *MeshEditor::linkSplitEdge(EditHalfEdge *e, int x, int y) {
+  EditHalfEdge *t = e->twin;
+  EditVertex *w = dcel.addVertex(x, y);
+  EditHalfEdge *e2 = dcel.addHalfEdge(); // w -> destino(e), depois de e
+  EditHalfEdge *t2 = dcel.addHalfEdge(); // w -> destino(t), depois de t
+
+  e2->origin = w;
+  e2->incidentFace = e->incidentFace;
+  e2->prev = e;
+  e2->next = e->next;
+  e->next->prev = e2;
+  e->next = e2;
+
+  t2->origin = w;
+  t2->incidentFace = t->incidentFace;
+  t2->prev = t;
+  t2->next = t->next;
+  t->next->prev = t2;
+  t->next = t2;
+
+  e->twin = t2;
+  t2->twin = e;
+  t->twin = e2;
+  e2->twin = t;
+
+  w->incidentEdge = e2;
+  e->incidentFace->invalidateAttributes();
+  t->incidentFace->invalidateAttributes();
+  return w;
+}
+
+// ======================================================================================================================= //
+
+void MeshEditor::unlinkSplitEdge(EditHalfEdge *e) {
+  EditHalfEdge *e2 = e->next, *t2 = e->twin, *t = e2->twin;
+  EditVertex *w = e2->origin;
+
+  e->next = e2->next;
+  e2->next->prev = e;
+  t->next = t2->next;
+  t2->next->prev = t;
+  e->twin = t;
+  t->twin = e;
+
+  if (e->incidentFace->outerComponent == e2) e->incidentFace->outerComponent = e;
+  if (t->incidentFace->outerComponent == t2) t->incidentFace->outerComponent = t;
+  e->incidentFace->invalidateAttributes();
+  t->incidentFace->invalidateAttributes();
+
+  dcel.removeHalfEdge(e2);
+  dcel.removeHalfEdge(t2);
+  dcel.removeVertex(w);
+}
+
+// ======================================================================================================================= //
+
+// Nenhuma aresta da face pode conflitar com outra aresta da malha
+bool MeshEditor::checkEdges(const EditFace *face, string &errorMessage) const {
+  vector<EditHalfEdge *> candidates;
+  for (const EditHalfEdge *he : faceEdges(face)) {
+    SweepSegment s = segmentOf(he);
+    edgeGrid.query(edgeBox(he), candidates);
+    for (const EditHalfEdge *c : candidates) {
+      if (c == he || c == he->twin) continue;
+      if (segmentsConflict(s, segmentOf(c))) {
+        errorMessage = "superposta";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// ======================================================================================================================= //
+
+// Nenhum vértice de fora pode ficar na borda ou no interior de uma face anti-horária
+// A orientação e o retângulo envolvente vêm dos atributos guardados na face
+bool MeshEditor::checkContainment(const EditFace *face, string &errorMessage) {
+  const FaceAttributes<int64_t> &attributes = face->attributes();
+  if (!isCounterClockwise(attributes)) return true;
+
+  // Polígono em SoA (com o primeiro vértice repetido no fim) reaproveitado entre as faces
+  size_t stamp = newStamp();
+  polygon.xs.clear();
+  polygon.ys.clear();
+  for (const EditVertex *v : faceVertices(face)) {
+    pair<int, int> c = coordOf(v);
+    polygon.xs.push_back(c.first);
+    polygon.ys.push_back(c.second);
+    vertexStamp[v->id] = stamp;
+  }
+  polygon.xs.push_back(polygon.xs.front());
+  polygon.ys.push_back(polygon.ys.front());
+
+  vector<EditVertex *> candidates;
+  vertexGrid.query(attributes.bbox(), candidates);
+  for (const EditVertex *v : candidates) {
+    if (vertexStamp[v->id] == stamp) continue;
+    if (classifyPoint(coordOf(v), polygon) != POINT_OUTSIDE) {
+      errorMessage = "superposta";
+      return false;
+    }
+  }
+  return true;
+}
+
+// ======================================================================================================================= //
+
+// O vértice não pode coincidir com outro, e a face logo abaixo dele (deslocada
+// infinitesimalmente para a direita) tem de ser uma das faces em volta dele:
+// senão ele foi parar dentro de uma face que não o contém
+bool MeshEditor::checkVertex(const EditVertex *v, string &errorMessage) const {
+  pair<int, int> p = coordOf(v);
+  vector<EditVertex *> same;
+  vertexGrid.query({p.first, p.second, p.first, p.second}, same);
+  for (const EditVertex *o : same) {
+    if (o != v && coordOf(o) == p) {
+      errorMessage = "superposta";
+      return false;
+    }
+  }
+
+  // Aresta mais alta abaixo de p em x = p.x + ε: só semi-arestas da esquerda para a
+  // direita com a.x <= p.x < b.x; altura em p.x como fração num/den, empate pela inclinação
+  const EditHalfEdge *best = nullptr;
+  __int128 bestNum = 0, bestDen = 1, bestRise = 0;
+  bool onEdge = false;
+  edgeGrid.scanDown(p.first, p.second, [&](const vector<EditHalfEdge *> &cell, long long bottom) {
+    for (const EditHalfEdge *c : cell) {
+      const EditVertex *from = c->origin, *to = c->next->origin;
+      if (from == v || to == v) continue;
+      pair<int, int> a = coordOf(from), b = coordOf(to);
+      if (!(a.first <= p.first && p.first < b.first)) continue;
+
+      __int128 den = b.first - a.first;
+      __int128 rise = b.second - a.second;
+      __int128 num = __int128(a.second) * den + __int128(p.first - a.first) * rise;
+      __int128 py = __int128(p.second) * den;
+      if (num > py) continue;
+      if (num == py) {
+        onEdge = true;
+        return false;
+      }
+      if (best) {
+        __int128 lhs = num * bestDen, rhs = bestNum * den;
+        if (lhs < rhs || (lhs == rhs && rise * bestDen <= bestRise * den)) continue;
+      }
+      best = c;
+      bestNum = num;
+      bestDen = den;
+      bestRise = rise;
+    }
+    // As linhas de baixo só têm arestas mais baixas que a melhor encontrada
+    return !(best && bottom != LLONG_MIN && bestNum >= __int128(bottom) * bestDen);
+  });
+
+  if (onEdge) {
+    errorMessage = "superposta";
+    return false;
+  }
+
+  vector<EditFace *> around = facesAround(v);
+  if (best) {
+    if (find(around.begin(), around.end(), best->incidentFace) == around.end()) {
+      errorMessage = "superposta";
+      return false;
+    }
+  } else {
+    // Nada abaixo: o vértice está na região ilimitada, que pertence à face horária
+    bool outer = any_of(around.begin(), around.end(), [](const EditFace *f) { return signOf(f) < 0; });
+    if (!outer) {
+      errorMessage = "superposta";
+      return false;
+    }
+  }
+  return true;
+}
+
+// ======================================================================================================================= //
+
+bool MeshEditor::checkTouched(const vector<EditFace *> &faces, const vector<EditVertex *> &moved, string &errorMessage) {
+  for (const EditVertex *v : moved) {
+    if (!checkVertex(v, errorMessage)) return false;
+  }
+  for (const EditFace *f : faces) {
+    if (!checkEdges(f, errorMessage)) return false;
+  }
+  for (const EditFace *f : faces) {
+    if (!checkContainment(f, errorMessage)) return false;
+  }
+  return true;
+}
+
+// ======================================================================================================================= //
+
+bool MeshEditor::splitFace(EditHalfEdge *a, EditHalfEdge *b, string &errorMessage, EditHalfEdge **created) {
+  if (!a || !b || a == b || a->incidentFace != b->incidentFace) {
+    errorMessage = "semi-arestas de faces diferentes";
+    return false;
+  }
+  if (a->next == b || b->next == a || a->origin == b->origin) {
+    errorMessage = "semi-arestas adjacentes";
+    return false;
+  }
+  if (hasInner(a->incidentFace)) {
+    errorMessage = INNER_COMPONENTS;
+    return false;
+  }
+  // Já existe aresta entre os dois vértices: seria uma aresta dupla
+  auto neighbors = vertexNeighbors(a->origin);
+  if (find(neighbors.begin(), neighbors.end(), b->origin) != neighbors.end()) {
+    errorMessage = "não subdivisão planar";
+    return false;
+  }
+
+  EditFace *f = a->incidentFace;
+  EditHalfEdge *oldOuter = f->outerComponent;
+  bool ccw = signOf(f) > 0;
+
+  EditHalfEdge *h1 = linkSplitFace(a, b);
+  EditHalfEdge *h2 = h1->twin;
+  EditFace *g = h2->incidentFace;
+  indexEdge(h1);
+  indexEdge(h2);
+
+  // Uma face anti-horária se divide em duas anti-horárias; a externa (horária)
+  // continua com exatamente uma parte horária
+  int s1 = signOf(f), s2 = signOf(g);
+  bool signsOk = ccw ? (s1 > 0 && s2 > 0) : ((s1 < 0) != (s2 < 0) && s1 != 0 && s2 != 0);
+
+  if (!signsOk) errorMessage = "superposta";
+  if (!signsOk || !checkTouched({f, g}, {}, errorMessage)) {
+    unindexEdge(h1);
+    unindexEdge(h2);
+    unlinkEdge(h1);
+    f->outerComponent = oldOuter;
+    return false;
+  }
+
+  if (created) *created = h1;
+  return true;
+}
+
+// ======================================================================================================================= //
+
+bool MeshEditor::removeEdge(EditHalfEdge *e, string &errorMessage) {
+  if (!e || !e->twin || e->incidentFace == e->twin->incidentFace) {
+    errorMessage = "aresta com a mesma face dos dois lados";
+    return false;
+  }
+  EditHalfEdge *t = e->twin;
+  if (hasInner(e->incidentFace) || hasInner(t->incidentFace)) {
+    errorMessage = INNER_COMPONENTS;
+    return false;
+  }
+
+  // A face unida não pode passar duas vezes pelo mesmo vértice: as duas faces
+  // só podem ter em comum as extremidades da aresta removida
+  size_t stamp = newStamp();
+  EditHalfEdge *he = e;
+  do {
+    vertexStamp[he->origin->id] = stamp;
+    he = he->next;
+  } while (he != e);
+  for (he = t->next->next; he != t; he = he->next) {
+    if (vertexStamp[he->origin->id] == stamp) {
+      errorMessage = "não subdivisão planar";
+      return false;
+    }
+  }
+
+  // A união de duas faces vizinhas válidas não cria sobreposição nova
+  unindexEdge(e);
+  unindexEdge(t);
+  unlinkEdge(e);
+  return true;
+}
+
+// ======================================================================================================================= //
+
+bool MeshEditor::splitEdge(EditHalfEdge *e, int x, int y, string &errorMessage, EditVertex **created) {
+  if (!e || !e->twin) {
+    errorMessage = "semi-aresta sem gêmea";
+    return false;
+  }
+  EditHalfEdge *t = e->twin;
+  EditFace *f = e->incidentFace, *g = t->incidentFace;
+  if (hasInner(f) || hasInner(g)) {
+    errorMessage = INNER_COMPONENTS;
+    return false;
+  }
+  int sf = signOf(f), sg = signOf(g);
+
+  unindexEdge(e);
+  unindexEdge(t);
+  EditVertex *w = linkSplitEdge(e, x, y);
+  EditHalfEdge *e2 = e->next, *t2 = t->next;
+  indexEdge(e);
+  indexEdge(t);
+  indexEdge(e2);
+  indexEdge(t2);
+  indexVertex(w);
+
+  bool ok = signOf(f) == sf && signOf(g) == sg;
+  if (!ok) errorMessage = "superposta";
+  if (!ok || !checkTouched(f == g ? vector<EditFace *>{f} : vector<EditFace *>{f, g}, {w}, errorMessage)) {
+    unindexVertex(w);
+    unindexEdge(e);
+    unindexEdge(t);
+    unindexEdge(e2);
+    unindexEdge(t2);
+    unlinkSplitEdge(e);
+    indexEdge(e);
+    indexEdge(t);
+    return false;
+  }
+
+  if (created) *created = w;
+  return true;
+}
+
+// ======================================================================================================================= //
+
+bool MeshEditor::moveVertex(EditVertex *v, int x, int y, string &errorMessage) {
+  if (!v || !v->incidentEdge) {
+    errorMessage = "vértice sem aresta incidente";
+    return false;
+  }
+
+  // Semi-arestas que saem de v e suas gêmeas mudam de geometria
+  vector<EditHalfEdge *> touched;
+  vector<EditFace *> faces;
+  for (EditHalfEdge *he : outgoingEdges(v)) {
+    touched.push_back(he);
+    touched.push_back(he->twin);
+    if (find(faces.begin(), faces.end(), he->incidentFace) == faces.end()) faces.push_back(he->incidentFace);
+  }
+  if (any_of(faces.begin(), faces.end(), hasInner)) {
+    errorMessage = INNER_COMPONENTS;
+    return false;
+  }
+
+  vector<int> signs;
+  for (const EditFace *f : faces) signs.push_back(signOf(f));
+
+  int64_t oldX = v->x, oldY = v->y;
+  auto place = [&](int64_t px, int64_t py) {
+    for (EditHalfEdge *h : touched) unindexEdge(h);
+    unindexVertex(v);
+    v->x = px;
+    v->y = py;
+    for (EditFace *f : faces) f->invalidateAttributes();
+    for (EditHalfEdge *h : touched) indexEdge(h);
+    indexVertex(v);
+  };
+  place(x, y);
+
+  bool ok = true;
+  for (size_t i = 0; i < faces.size() && ok; i++) ok = signOf(faces[i]) == signs[i];
+  if (!ok) errorMessage = "superposta";
+  if (!ok || !checkTouched(faces, {v}, errorMessage)) {
+    place(oldX, oldY);
+    return false;
+  }
+  return true;
+}
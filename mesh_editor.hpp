@@ -0,0 +1,110 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef MESH_EDITOR_HPP
+#define MESH_EDITOR_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dcel.hpp"
+#include "predicates.hpp"
+#include "spatial_grid.hpp"
+#include "sweep.hpp"
+
+using namespace std;
+
+// A edição só cria vértices inteiros (split-edge e move-vertex recebem int):
+// a DCEL editada guarda coordenadas int64_t, e não double, e ids size_t
+using EditVertex = BasicVertex<int64_t, size_t>;
+using EditHalfEdge = BasicHalfEdge<int64_t, size_t>;
+using EditFace = BasicFace<int64_t, size_t>;
+using EditDCEL = BasicDCEL<int64_t, size_t>;
+
+// ---------- Classe MeshEditor ----------
+// Edição incremental de uma DCEL válida. Cada operação religa
+// twin/next/prev/incidentFace só em volta do trecho editado e depois refaz as
+// verificações geométricas de checkMesh (interseção entre arestas, vértices
+// coincidentes e vértices dentro de faces) apenas para as faces tocadas,
+// consultando grades dinâmicas de semi-arestas e de vértices. Se a malha
+// editada for inválida, a operação é desfeita e os ponteiros existentes
+// continuam valendo.
+class MeshEditor {
+public:
+  /**
+   * Indexa a DCEL (que deve ser válida e continuar viva enquanto o editor existir)
+   * @param dcel DCEL a ser editada
+   */
+  explicit MeshEditor(EditDCEL &dcel);
+
+  /**
+   * Insere a aresta origem(a) -> origem(b), dividindo a face das duas semi-arestas
+   * @param a Semi-aresta da face; a nova face fica com o trecho de a até antes de b
+   * @param b Semi-aresta da mesma face, não adjacente a a
+   * @param errorMessage Motivo da recusa
+   * @param created Saída opcional: nova semi-aresta origem(a) -> origem(b)
+   * @return true se a edição foi aplicada
+   */
+  bool splitFace(EditHalfEdge *a, EditHalfEdge *b, string &errorMessage, EditHalfEdge **created = nullptr);
+
+  /**
+   * Remove a aresta de e, juntando a face da gêmea à face de e
+   * @param e Semi-aresta da aresta removida (as duas faces devem ser distintas)
+   * @param errorMessage Motivo da recusa
+   * @return true se a edição foi aplicada
+   */
+  bool removeEdge(EditHalfEdge *e, string &errorMessage);
+
+  /**
+   * Divide a aresta de e com um novo vértice em (x, y)
+   * @param e Semi-aresta dividida; e passa a terminar no novo vértice
+   * @param errorMessage Motivo da recusa
+   * @param created Saída opcional: novo vértice
+   * @return true se a edição foi aplicada
+   */
+  bool splitEdge(EditHalfEdge *e, int x, int y, string &errorMessage, EditVertex **created = nullptr);
+
+  /**
+   * Move um vértice para (x, y)
+   * @param errorMessage Motivo da recusa
+   * @return true se a edição foi aplicada
+   */
+  bool moveVertex(EditVertex *v, int x, int y, string &errorMessage);
+
+private:
+  EditDCEL &dcel;
+  BucketGrid<EditHalfEdge *> edgeGrid;
+  BucketGrid<EditVertex *> vertexGrid;
+  vector<size_t> vertexStamp; // por id de vértice: última marca recebida
+  size_t stampCounter = 0;
+  PolygonSoA polygon;         // face de checkContainment, reaproveitada entre chamadas
+
+  // Indexação nas grades (sempre com as coordenadas atuais)
+  void indexEdge(EditHalfEdge *he);
+  void unindexEdge(EditHalfEdge *he);
+  void indexVertex(EditVertex *v);
+  void unindexVertex(EditVertex *v);
+
+  // Religações sem validação (usadas também para desfazer)
+  EditHalfEdge *linkSplitFace(EditHalfEdge *a, EditHalfEdge *b);
+  void unlinkEdge(EditHalfEdge *e);
+  EditVertex *linkSplitEdge(EditHalfEdge *e, int x, int y);
+  void unlinkSplitEdge(EditHalfEdge *e);
+
+  // Verificações locais
+  bool checkTouched(const vector<EditFace *> &faces, const vector<EditVertex *> &moved, string &errorMessage);
+  bool checkEdges(const EditFace *face, string &errorMessage) const;
+  bool checkContainment(const EditFace *face, string &errorMessage);
+  bool checkVertex(const EditVertex *v, string &errorMessage) const;
+  size_t newStamp();
+};
+
+#endif // MESH_EDITOR_HPP
@@ -0,0 +1,198 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "mesh_io.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Tamanho do bloco de leitura quando a entrada não pode ser mapeada
+static const size_t BLOCK_SIZE = 1 << 20;
+
+// Maior token numérico esperado; abaixo disso o buffer é reabastecido antes de converter
+static const size_t MAX_TOKEN = 64;
+
+static inline bool isBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// ======================================================================================================================= //
+
+InputScanner::InputScanner(int fd) : fd(fd) {
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+    // Arquivo regular: mapeia tudo a partir da posição corrente
+    off_t offset = lseek(fd, 0, SEEK_CUR);
+    if (offset < 0) offset = 0;
+    void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      madvise(p, st.st_size, MADV_SEQUENTIAL);
+      mapped = static_cast<char*>(p);
+      mappedSize = st.st_size;
+      cur = mapped + min<off_t>(offset, st.st_size);
+      lim = mapped + mappedSize;
+      eof = true;
+      return;
+    }
+  }
+
+  // Pipe ou terminal: leitura em blocos
+  buffer.resize(BLOCK_SIZE + MAX_TOKEN);
+  cur = lim = buffer.data();
+}
+
+InputScanner::~InputScanner() {
+  if (mapped) {
+    munmap(mapped, mappedSize);
+  }
+}
+
+// ======================================================================================================================= //
+
+// Move o que sobrou para o início do buffer e lê mais um bloco
+bool InputScanner::refill() {
+  if (eof) return false;
+
+  size_t rest = lim - cur;
+  memmove(buffer.data(), cur, rest);
+  cur = buffer.data();
+  lim = cur + rest;
+
+  while (static_cast<size_t>(lim - buffer.data()) < buffer.size()) {
+    ssize_t n = read(fd, const_cast<char*>(lim), buffer.size() - (lim - buffer.data()));
+    if (n <= 0) {
+      eof = true;
+      break;
+    }
+    lim += n;
+    // Um bloco parcial já basta; só insiste se ainda não há um token completo
+    if (static_cast<size_t>(lim - cur) >= MAX_TOKEN) break;
+  }
+  return lim > cur;
+}
+
+// ======================================================================================================================= //
+
+bool InputScanner::skipWhitespace() {
+  while (true) {
+    while (cur < lim && (isBlank(*cur) || *cur == '\n')) cur++;
+    if (cur < lim) return true;
+    if (!refill()) return false;
+  }
+}
+
+// ======================================================================================================================= //
+
+void InputScanner::skipLine() {
+  while (true) {
+    const char* nl = static_cast<const char*>(memchr(cur, '\n', lim - cur));
+    if (nl) {
+      cur = nl + 1;
+      return;
+    }
+    cur = lim;
+    if (!refill()) return;
+  }
+}
+
+// ======================================================================================================================= //
+
+// Converte o número em cur (sem espaços antes); aceita sinal como o istream
+bool InputScanner::parseInt(int& value) {
+  if (static_cast<size_t>(lim - cur) < MAX_TOKEN) refill();
+
+  const char* start = cur;
+  if (start < lim && *start == '+') start++;
+  auto res = from_chars(start, lim, value);
+  if (res.ec != errc() || (start != cur && start < lim && *start == '-')) {
+    value = 0;
+    return false;
+  }
+  cur = res.ptr;
+  return true;
+}
+
+// ======================================================================================================================= //
+
+bool InputScanner::readInt(int& value) {
+  if (fail || !skipWhitespace() || !parseInt(value)) {
+    fail = true;
+    value = 0;
+    return false;
+  }
+  return true;
+}
+
+// ======================================================================================================================= //
+
+bool InputScanner::readIntInLine(int& value) {
+  while (true) {
+    while (cur < lim && isBlank(*cur)) cur++;
+    if (cur < lim) break;
+    if (!refill()) return false;
+  }
+  if (*cur == '\n') return false;
+  return parseInt(value);
+}
+
+// ======================================================================================================================= //
+
+bool readMesh(InputScanner& in, Mesh& mesh) {
+  STATS_TIMER(STATS_PARSE);
+  int n = 0, f = 0;
+  in.readInt(n);
+  in.readInt(f);
+  bool header = !in.failed();
+  n = max(n, 0);
+  f = max(f, 0);
+
+  // Lê os vértices direto no vetor pré-alocado
+  mesh.vertices.assign(n, {0, 0});
+  for (int i = 0; i < n; ++i) {
+    in.readInt(mesh.vertices[i].first);
+    in.readInt(mesh.vertices[i].second);
+  }
+
+  // Lê as faces, uma por linha; cada índice ocupa pelo menos dois bytes da entrada
+  mesh.faces = FaceList();
+  mesh.faces.reserve(f, min(in.available() / 2, static_cast<size_t>(f) * 8));
+  for (int i = 0; i < f; ++i) {
+    readFaceLine(in, [&](int v) { mesh.faces.push(v); });
+    mesh.faces.closeFace();
+  }
+
+  return header;
+}
+
+// ======================================================================================================================= //
+
+bool readPoints(InputScanner& in, vector<pair<int, int>>& points) {
+  int k = 0;
+  in.readInt(k);
+  bool header = !in.failed();
+
+  points.clear();
+  points.reserve(min(static_cast<size_t>(max(k, 0)), in.available() / 4 + 1));
+  for (int i = 0; i < k; ++i) {
+    pair<int, int> pt;
+    in.readInt(pt.first);
+    in.readInt(pt.second);
+    if (in.failed()) break;
+    points.push_back(pt);
+  }
+  return header;
+}
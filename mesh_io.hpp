@@ -0,0 +1,126 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef MESH_IO_HPP
+#define MESH_IO_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "mesh.hpp"
+
+using namespace std;
+
+// ---------- Classe InputScanner ----------
+// Leitor de inteiros sem cópia: se o descritor for um arquivo regular, ele é
+// mapeado inteiro com mmap; senão (pipe, terminal) é lido em blocos grandes.
+// Os números são convertidos com from_chars direto do buffer, sem string nem
+// stream intermediários. Como o istream, depois da primeira falha de leitura
+// todas as leituras seguintes falham.
+class InputScanner {
+public:
+  /**
+   * Prepara a leitura do descritor (não o fecha no destrutor)
+   * @param fd Descritor de arquivo aberto para leitura
+   */
+  explicit InputScanner(int fd);
+  ~InputScanner();
+
+  InputScanner(const InputScanner&) = delete;
+  InputScanner& operator=(const InputScanner&) = delete;
+
+  /**
+   * Lê o próximo inteiro, pulando espaços e quebras de linha
+   * @param value Valor lido (0 em caso de falha, como no istream)
+   * @return true se leu um inteiro
+   */
+  bool readInt(int& value);
+
+  /**
+   * Lê o próximo inteiro da linha corrente, sem atravessar a quebra de linha
+   * @param value Valor lido
+   * @return false no fim da linha, do arquivo ou se encontrar algo que não é número
+   */
+  bool readIntInLine(int& value);
+
+  /**
+   * Descarta o restante da linha corrente, inclusive a quebra de linha
+   */
+  void skipLine();
+
+  /**
+   * Pula espaços e quebras de linha
+   * @return false se chegou ao fim da entrada
+   */
+  bool skipWhitespace();
+
+  /**
+   * Indica se uma leitura já falhou
+   */
+  bool failed() const { return fail; }
+
+  /**
+   * Bytes ainda não consumidos que já estão disponíveis (todo o restante, se mapeado)
+   */
+  size_t available() const { return static_cast<size_t>(lim - cur); }
+
+private:
+  int fd;
+  const char* cur = nullptr;
+  const char* lim = nullptr;
+  char* mapped = nullptr;
+  size_t mappedSize = 0;
+  vector<char> buffer;
+  bool eof = false;
+  bool fail = false;
+
+  bool refill();
+  bool parseInt(int& value);
+};
+
+/**
+ * Lê a próxima face, como getline(cin >> ws, line): pula linhas em branco e
+ * entrega cada índice da linha (convertido para base 0) a sink
+ * @param in Leitor posicionado antes da face
+ * @param sink Função chamada com cada índice de vértice
+ */
+template <class Sink>
+void readFaceLine(InputScanner& in, Sink&& sink) {
+  if (!in.failed() && in.skipWhitespace()) {
+    int v;
+    while (in.readIntInLine(v)) {
+      sink(v - 1);
+    }
+    in.skipLine();
+  } else {
+    // Fim da entrada: a face fica vazia, como na leitura por istream
+    int dummy;
+    in.readInt(dummy);
+  }
+}
+
+/**
+ * Lê uma malha no formato texto (.in) direto para os vetores pré-alocados
+ * Primeira linha: n f; depois n linhas "x y"; depois f linhas com os índices (base 1) de cada face
+ * @param in Leitor posicionado no início da malha
+ * @param mesh Malha de saída (índices convertidos para base 0)
+ * @return true se o cabeçalho foi lido
+ */
+bool readMesh(InputScanner& in, Mesh& mesh);
+
+/**
+ * Lê uma lista de pontos: primeira linha k; depois k linhas "x y"
+ * @param in Leitor posicionado no início da lista
+ * @param points Pontos lidos (os que faltarem no fim da entrada são descartados)
+ * @return true se o cabeçalho foi lido
+ */
+bool readPoints(InputScanner& in, vector<pair<int, int>>& points);
+
+#endif // MESH_IO_HPP
@@ -0,0 +1,86 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "output_writer.hpp"
+
+#include <cerrno>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+
+using namespace std;
+
+OutputWriter::OutputWriter(int fd, size_t capacity) : fd(fd), buffer(max(capacity, MAX_NUMBER)) {
+  cout.flush();
+}
+
+OutputWriter::OutputWriter(string* target, size_t capacity) : target(target), buffer(max(capacity, MAX_NUMBER)) {}
+
+OutputWriter::~OutputWriter() {
+  try {
+    flush();
+  } catch (const exception&) {
+    // Destrutor não propaga; quem precisa do erro chama flush antes
+  }
+}
+
+// ======================================================================================================================= //
+
+// Escreve tudo no descritor, repetindo em escritas parciais
+static void writeAll(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    ssize_t n = write(fd, data, size);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      throw runtime_error("falha ao escrever a saída");
+    }
+    data += n;
+    size -= n;
+  }
+}
+
+// ======================================================================================================================= //
+
+void OutputWriter::flush() {
+  if (used == 0) return;
+  if (target) {
+    target->append(buffer.data(), used);
+  } else {
+    writeAll(fd, buffer.data(), used);
+  }
+  used = 0;
+}
+
+// ======================================================================================================================= //
+
+void OutputWriter::redirect(string* newTarget) {
+  flush();
+  target = newTarget;
+}
+
+// ======================================================================================================================= //
+
+void OutputWriter::append(const char* data, size_t size) {
+  if (size <= buffer.size() - used) {
+    memcpy(buffer.data() + used, data, size);
+    used += size;
+    return;
+  }
+
+  flush();
+  if (size < buffer.size()) {
+    memcpy(buffer.data(), data, size);
+    used = size;
+  } else if (target) {
+    target->append(data, size);
+  } else {
+    writeAll(fd, data, size);
+  }
+}
@@ -0,0 +1,222 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef OUTPUT_WRITER_HPP
+#define OUTPUT_WRITER_HPP
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "stats.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+
+// ---------- Classe OutputWriter ----------
+// Saída com buffer grande e reaproveitado: os números são formatados com
+// to_chars direto no buffer, que só é esvaziado quando enche (ou no flush),
+// com poucas chamadas grandes a write. O destino é um descritor de arquivo
+// ou uma string, para montar a saída em memória.
+class OutputWriter {
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 1 << 20;
+
+  /**
+   * Escreve no descritor (não o fecha); esvazia o cout antes para manter a ordem
+   * @param fd Descritor aberto para escrita
+   * @param capacity Tamanho do buffer em bytes
+   */
+  explicit OutputWriter(int fd, size_t capacity = DEFAULT_CAPACITY);
+
+  /**
+   * Acrescenta a saída ao final da string
+   * @param target String de destino
+   * @param capacity Tamanho do buffer em bytes
+   */
+  explicit OutputWriter(string* target, size_t capacity = DEFAULT_CAPACITY);
+
+  ~OutputWriter();
+
+  OutputWriter(const OutputWriter&) = delete;
+  OutputWriter& operator=(const OutputWriter&) = delete;
+
+  void put(char c) {
+    if (used == buffer.size()) flush();
+    buffer[used++] = c;
+  }
+
+  void putInt(long long value) {
+    reserveRoom();
+    used = to_chars(buffer.data() + used, buffer.data() + buffer.size(), value).ptr - buffer.data();
+  }
+
+  void putUInt(unsigned long long value) {
+    reserveRoom();
+    used = to_chars(buffer.data() + used, buffer.data() + buffer.size(), value).ptr - buffer.data();
+  }
+
+  // Menor representação que, lida de volta, dá o mesmo double
+  void putDouble(double value) {
+    reserveRoom();
+    used = to_chars(buffer.data() + used, buffer.data() + buffer.size(), value).ptr - buffer.data();
+  }
+
+  /**
+   * Copia um bloco de bytes para a saída (blocos grandes vão direto ao destino)
+   */
+  void append(const char* data, size_t size);
+  void append(const string& text) { append(text.data(), text.size()); }
+
+  /**
+   * Esvazia o buffer no destino
+   * @throws runtime_error se a escrita no descritor falhar
+   */
+  void flush();
+
+  /**
+   * Esvazia o buffer na string atual e passa a acrescentar a saída a outra,
+   * reaproveitando o buffer (só para destinos string)
+   * @param newTarget String de destino
+   */
+  void redirect(string* newTarget);
+
+private:
+  // Espaço para o maior número formatado
+  static constexpr size_t MAX_NUMBER = 24;
+
+  int fd = -1;
+  string* target = nullptr;
+  vector<char> buffer;
+  size_t used = 0;
+
+  void reserveRoom() {
+    if (buffer.size() - used < MAX_NUMBER) flush();
+  }
+};
+
+// ======================================================================================================================= //
+
+// Linha de um vértice na saída: coordenadas e semi-aresta incidente (base 1, 0 = nula)
+struct VertexLine {
+  long long x, y;
+  uint64_t edge;
+};
+
+// Semi-arestas por bloco na formatação paralela
+static const size_t OUTPUT_CHUNK = 1 << 16;
+
+/**
+ * Escreve uma linha de semi-aresta: origem gêmea face próxima anterior
+ */
+inline void writeHalfEdgeLine(OutputWriter& out, const array<uint64_t, 5>& fields) {
+  out.putUInt(fields[0]);
+  for (size_t i = 1; i < fields.size(); i++) {
+    out.put(' ');
+    out.putUInt(fields[i]);
+  }
+  out.put('\n');
+}
+
+/**
+ * Escreve a DCEL no formato de saída, independente da representação
+ * Os índices já vêm em base 1 (0 = nulo) das funções de acesso. Com pool,
+ * a seção de semi-arestas é formatada em blocos paralelos, concatenados em ordem.
+ * @param out Destino
+ * @param numVertices Número de vértices
+ * @param numHalfEdges Número de semi-arestas
+ * @param numFaces Número de faces
+ * @param vertexAt Função v -> VertexLine
+ * @param faceAt Função f -> semi-aresta do componente externo
+ * @param innerAt Função (f, emit) que chama emit(semi-aresta) para cada componente
+ *                interno da face, em ordem; a linha da face lista-os depois do externo
+ * @param halfEdgeAt Função h -> {origem, gêmea, face, próxima, anterior}
+ * @param pool Pool para a formatação paralela (pode ser nulo)
+ */
+template <class VertexFn, class FaceFn, class InnerFn, class HalfEdgeFn>
+void writeDCELText(OutputWriter& out, size_t numVertices, size_t numHalfEdges, size_t numFaces,
+                   const VertexFn& vertexAt, const FaceFn& faceAt, const InnerFn& innerAt,
+                   const HalfEdgeFn& halfEdgeAt, ThreadPool* pool = nullptr) {
+  STATS_TIMER(STATS_OUTPUT);
+
+  // 1. Primeira linha: contagem de vértices, arestas (semi-arestas/2), faces
+  out.putUInt(numVertices);
+  out.put(' ');
+  out.putUInt(numHalfEdges / 2);
+  out.put(' ');
+  out.putUInt(numFaces);
+  out.put('\n');
+
+  // 2. Seção de vértices: x y índice_da_semi-aresta_incidente
+  for (size_t v = 0; v < numVertices; v++) {
+    VertexLine line = vertexAt(v);
+    out.putInt(line.x);
+    out.put(' ');
+    out.putInt(line.y);
+    out.put(' ');
+    out.putUInt(line.edge);
+    out.put('\n');
+  }
+
+  // 3. Seção de faces: índice_da_semi-aresta_do_componente_externo [componentes_internos...]
+  for (size_t f = 0; f < numFaces; f++) {
+    out.putUInt(faceAt(f));
+    innerAt(f, [&](uint64_t edge) {
+      out.put(' ');
+      out.putUInt(edge);
+    });
+    out.put('\n');
+  }
+
+  // 4. Seção de semi-arestas: origem gêmea face_esquerda próxima anterior
+  if (!pool || pool->size() < 2 || numHalfEdges <= OUTPUT_CHUNK) {
+    for (size_t h = 0; h < numHalfEdges; h++) {
+      writeHalfEdgeLine(out, halfEdgeAt(h));
+    }
+    return;
+  }
+
+  // Em ondas de alguns blocos por thread, para limitar a memória dos blocos formatados.
+  // As strings dos blocos e o buffer de cada worker (+1 para a thread chamadora)
+  // são reaproveitados entre blocos e ondas
+  size_t numChunks = (numHalfEdges + OUTPUT_CHUNK - 1) / OUTPUT_CHUNK;
+  size_t wave = pool->size() * 2;
+  vector<string> chunks(wave);
+  vector<unique_ptr<OutputWriter>> writers(pool->size() + 1);
+  for (size_t first = 0; first < numChunks; first += wave) {
+    size_t last = min(numChunks, first + wave);
+    parallelFor(pool, first, last, 1, [&](size_t lo, size_t hi) {
+      unique_ptr<OutputWriter>& chunkOut = writers[ThreadPool::workerIndex() + 1];
+      for (size_t c = lo; c < hi; c++) {
+        string& text = chunks[c - first];
+        text.clear();
+        if (chunkOut) {
+          chunkOut->redirect(&text);
+        } else {
+          chunkOut = make_unique<OutputWriter>(&text);
+        }
+        size_t end = min(numHalfEdges, (c + 1) * OUTPUT_CHUNK);
+        for (size_t h = c * OUTPUT_CHUNK; h < end; h++) {
+          writeHalfEdgeLine(*chunkOut, halfEdgeAt(h));
+        }
+        chunkOut->flush();
+      }
+    });
+    for (size_t c = first; c < last; c++) {
+      out.append(chunks[c - first]);
+    }
+  }
+}
+
+#endif // OUTPUT_WRITER_HPP
@@ -0,0 +1,616 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "overlay.hpp"
+#include "dcel_ranges.hpp"
+#include "point_location.hpp"
+#include "predicates.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <set>
+
+using namespace std;
+
+// Ponto exato (x/d, y/d), d > 0. Com |coord| <= 2^22, numeradores ficam abaixo
+// de 2^72 e denominadores de 2^48: os produtos cruzados cabem em __int128.
+struct ExactPoint {
+  __int128 x, y, d;
+};
+
+// Ordem lexicográfica (x, depois y), a mesma das extremidades de SweepSegment
+static int comparePoints(const ExactPoint &a, const ExactPoint &b) {
+  __int128 l = a.x * b.d, r = b.x * a.d;
+  if (l == r) {
+    l = a.y * b.d;
+    r = b.y * a.d;
+  }
+  return (l > r) - (l < r);
+}
+
+struct ExactPointLess {
+  bool operator()(const ExactPoint &a, const ExactPoint &b) const { return comparePoints(a, b) < 0; }
+};
+
+// Aresta não direcionada de uma das malhas, de p para q (p < q)
+struct OverlaySegment {
+  long long px, py, qx, qy;
+  long long dx, dy;         // q - p
+  int source;               // 0 = primeira malha, 1 = segunda
+  const HalfEdge *pq, *qp;  // semi-arestas de origem em cada sentido
+};
+
+// Face de origem ainda não determinada
+static const int UNKNOWN_FACE = -2;
+
+// ======================================================================================================================= //
+
+// Uma entrada por par de semi-arestas gêmeas
+static bool collectOverlaySegments(const DCEL &dcel, int source, vector<OverlaySegment> &segments,
+                                   string &errorMessage) {
+  for (const Vertex *v : dcel.vertices) {
+    if (v->x != floor(v->x) || v->y != floor(v->y) || fabs(v->x) > OVERLAY_MAX_COORD ||
+        fabs(v->y) > OVERLAY_MAX_COORD) {
+      errorMessage = "coordenadas fora do intervalo da sobreposição (inteiras, |x|, |y| <= " +
+                     to_string(OVERLAY_MAX_COORD) + ")";
+      return false;
+    }
+  }
+
+  for (const HalfEdge *he : dcel.halfEdges) {
+    const HalfEdge *twin = he->twin;
+    if (twin && twin->id < he->id) continue;
+
+    const Vertex *from = he->origin, *to = he->next->origin;
+    OverlaySegment s;
+    s.source = source;
+    if (make_pair(from->x, from->y) < make_pair(to->x, to->y)) {
+      s.pq = he;
+      s.qp = twin;
+    } else {
+      swap(from, to);
+      s.pq = twin;
+      s.qp = he;
+    }
+    s.px = static_cast<long long>(from->x);
+    s.py = static_cast<long long>(from->y);
+    s.qx = static_cast<long long>(to->x);
+    s.qy = static_cast<long long>(to->y);
+    s.dx = s.qx - s.px;
+    s.dy = s.qy - s.py;
+    segments.push_back(s);
+  }
+  return true;
+}
+
+// ======================================================================================================================= //
+
+// ---------- Classe OverlaySweep ----------
+// Bentley–Ottmann com o tratamento de degenerações de de Berg et al.: em cada
+// ponto de evento, os segmentos que passam por ele (que terminam nele ou o
+// contêm no interior) são contíguos no status; saem todos e voltam os que
+// continuam, na ordem logo à direita do ponto. Assim pontos comuns a vários
+// segmentos, extremidades no interior de outra aresta e trechos colineares
+// não precisam de casos especiais. Segmentos verticais ficam acima dos demais
+// que passam pelo mesmo ponto (a linha de varredura está levemente inclinada,
+// como na ordem lexicográfica dos eventos).
+class OverlaySweep {
+public:
+  explicit OverlaySweep(const vector<OverlaySegment> &segments) : segs(segments), status(StatusLess{this}) {}
+
+  /**
+   * Percorre todos os eventos
+   * @param points Saída: pontos de evento (os vértices da sobreposição), em ordem lexicográfica
+   * @param incidences Saída: pares (segmento, ponto) para cada ponto sobre um segmento,
+   *                   na ordem da varredura (de p para q em cada segmento)
+   */
+  void run(vector<ExactPoint> &points, vector<pair<int, int>> &incidences) {
+    for (size_t i = 0; i < segs.size(); ++i) {
+      events[{segs[i].px, segs[i].py, 1}].push_back(static_cast<int>(i));
+      events[{segs[i].qx, segs[i].qy, 1}];
+    }
+
+    vector<int> through;
+    while (!events.empty()) {
+      auto first = events.begin();
+      event = first->first;
+      vector<int> starting = move(first->second);
+      events.erase(first);
+
+      int vertex = static_cast<int>(points.size());
+      points.push_back(event);
+
+      // Ativos que passam pelo ponto: saem todos do status
+      auto range = status.equal_range(PROBE);
+      through.assign(range.first, range.second);
+      status.erase(range.first, range.second);
+
+      for (int s : through) incidences.push_back({s, vertex});
+      for (int s : starting) incidences.push_back({s, vertex});
+
+      // Voltam os que continuam e entram os que começam, ordenados logo à direita do ponto
+      for (int s : through) {
+        if (!endsAtEvent(segs[s])) status.insert(s);
+      }
+      for (int s : starting) status.insert(s);
+
+      // Novos vizinhos: em volta do ponto, se nada continuou; senão, nas pontas do grupo
+      range = status.equal_range(PROBE);
+      if (range.first == range.second) {
+        if (range.first != status.begin() && range.first != status.end()) testPair(*prev(range.first), *range.first);
+      } else {
+        if (range.first != status.begin()) testPair(*prev(range.first), *range.first);
+        if (range.second != status.end()) testPair(*prev(range.second), *range.second);
+      }
+    }
+  }
+
+private:
+  // No status, PROBE representa o próprio ponto de evento nas buscas
+  static constexpr int PROBE = -1;
+
+  struct StatusLess {
+    const OverlaySweep *sweep;
+    bool operator()(int a, int b) const { return sweep->below(a, b); }
+  };
+
+  const vector<OverlaySegment> &segs;
+  ExactPoint event{0, 0, 1};
+  map<ExactPoint, vector<int>, ExactPointLess> events; // ponto -> segmentos que começam nele
+  set<int, StatusLess> status;
+
+  bool endsAtEvent(const OverlaySegment &s) const { return s.qx * event.d == event.x && s.qy * event.d == event.y; }
+
+  // Ordenada do segmento na abscissa do evento, como num / (den * event.d).
+  // Verticais (e o próprio ponto) ficam na altura do evento.
+  void heightAt(int s, __int128 &num, __int128 &den) const {
+    if (s == PROBE || segs[s].dx == 0) {
+      num = event.y;
+      den = 1;
+      return;
+    }
+    const OverlaySegment &seg = segs[s];
+    num = static_cast<__int128>(seg.py) * seg.dx * event.d + (event.x - static_cast<__int128>(seg.px) * event.d) * seg.dy;
+    den = seg.dx;
+  }
+
+  // Ordem de baixo para cima na linha de varredura
+  bool below(int a, int b) const {
+    __int128 na, da, nb, db;
+    heightAt(a, na, da);
+    heightAt(b, nb, db);
+    __int128 l = na * db, r = nb * da;
+    if (l != r) return l < r;
+    if (a == PROBE || b == PROBE) return false;
+
+    // Passam pelo mesmo ponto: logo à direita dele, vale a ordem das inclinações
+    const OverlaySegment &sa = segs[a], &sb = segs[b];
+    __int128 c = static_cast<__int128>(sa.dy) * sb.dx - static_cast<__int128>(sb.dy) * sa.dx;
+    if (c != 0) return c < 0;
+    return a < b;
+  }
+
+  // Agenda o ponto em que dois vizinhos se encontram, se estiver depois do evento atual.
+  // Arestas da mesma malha só se tocam em extremidades, que já são eventos; trechos
+  // colineares de malhas diferentes aparecem como extremidades no interior da outra.
+  void testPair(int a, int b) {
+    const OverlaySegment &s = segs[a], &t = segs[b];
+    if (s.source == t.source) return;
+    STATS_COUNT(STATS_SEGMENT_TESTS);
+
+    __int128 den = static_cast<__int128>(s.dx) * t.dy - static_cast<__int128>(s.dy) * t.dx;
+    if (den == 0) return;
+    __int128 rx = t.px - s.px, ry = t.py - s.py;
+    __int128 tn = rx * t.dy - ry * t.dx; // parâmetro em s, vezes den
+    __int128 un = rx * s.dy - ry * s.dx; // parâmetro em t, vezes den
+    if (den < 0) {
+      den = -den;
+      tn = -tn;
+      un = -un;
+    }
+    if (tn < 0 || tn > den || un < 0 || un > den) return;
+
+    ExactPoint hit{s.px * den + tn * s.dx, s.py * den + tn * s.dy, den};
+    if (comparePoints(hit, event) > 0) events[hit];
+  }
+};
+
+// ======================================================================================================================= //
+
+// Face limitada = ciclo anti-horário (orientação guardada na face)
+static vector<char> boundedFaces(const DCEL &dcel) {
+  vector<char> bounded(dcel.faces.size());
+  for (const Face *f : dcel.faces) bounded[f->id] = f->attributes().orientation > 0;
+  return bounded;
+}
+
+// ======================================================================================================================= //
+
+// Face de origem de cada face da sobreposição, para uma das malhas.
+// sourceEdge[h]: semi-aresta da malha de origem com o mesmo sentido de h (nula se h não vem dela).
+static void assignSourceFaces(const DCEL &overlay, const DCEL &source, const vector<const HalfEdge *> &sourceEdge,
+                              vector<int> &label) {
+  vector<char> bounded = boundedFaces(source);
+  label.assign(overlay.faces.size(), UNKNOWN_FACE);
+
+  // Uma aresta da origem dá a face dela à esquerda (a externa conta como fora da malha)
+  vector<const Face *> queue;
+  for (const HalfEdge *h : overlay.halfEdges) {
+    const HalfEdge *s = sourceEdge[h->id];
+    size_t f = h->incidentFace->id;
+    if (s && label[f] == UNKNOWN_FACE) {
+      label[f] = bounded[s->incidentFace->id] ? static_cast<int>(s->incidentFace->id) : -1;
+      queue.push_back(h->incidentFace);
+    }
+  }
+
+  unique_ptr<PointLocator> locator; // só se algum componente não tocar nenhuma aresta da origem
+  size_t head = 0, scan = 0;
+  while (true) {
+    // Atravessar uma aresta que não é da origem não muda a face de origem
+    while (head < queue.size()) {
+      const Face *g = queue[head++];
+      for (const HalfEdge *h : faceEdges(g)) {
+        size_t other = h->twin->incidentFace->id;
+        if (!sourceEdge[h->id] && label[other] == UNKNOWN_FACE) {
+          label[other] = label[g->id];
+          queue.push_back(h->twin->incidentFace);
+        }
+      }
+    }
+
+    // Um componente sem arestas da origem fica no interior de uma só face dela
+    // (a localização também passa pelos buracos da origem): basta localizar um vértice
+    while (scan < label.size() && label[scan] != UNKNOWN_FACE) scan++;
+    if (scan == label.size()) break;
+    if (!locator) locator = make_unique<PointLocator>(source);
+    const Vertex *v = overlay.faces[scan]->outerComponent->origin;
+    label[scan] = locator->locate({static_cast<int>(v->x), static_cast<int>(v->y)});
+    queue.push_back(overlay.faces[scan]);
+  }
+}
+
+// ======================================================================================================================= //
+
+// Sinal da posição de pt em relação à reta (inteira) do segmento s: 1 à esquerda, -1 à direita
+static int sideOfSegment(const OverlaySegment &s, const ExactPoint &pt) {
+  __int128 v = s.dx * (pt.y - s.py * pt.d) - s.dy * (pt.x - s.px * pt.d);
+  return (v > 0) - (v < 0);
+}
+
+// Abscissas exatas: -1, 0 ou 1 conforme a.x for menor, igual ou maior que b.x
+static int compareX(const ExactPoint &a, const ExactPoint &b) {
+  __int128 l = a.x * b.d, r = b.x * a.d;
+  return (l > r) - (l < r);
+}
+
+// Ordem do status da varredura de buracos sobre as arestas da sobreposição, com
+// busca por ponto, como em assignHoles. As arestas não se cruzam e cada uma está
+// sobre um segmento inteiro de uma das malhas: as orientações são exatas.
+struct OverlayHoleOrder {
+  using is_transparent = void;
+  const DCEL *dcel;
+  const vector<ExactPoint> *points;
+  const vector<OverlaySegment> *segments;
+  const vector<int> *support;
+  const vector<pair<long long, long long>> *direction;
+
+  const OverlaySegment &line(int e) const { return (*segments)[(*support)[e]]; }
+  size_t from(int e) const { return dcel->halfEdges[2 * e]->origin->id; }
+  size_t to(int e) const { return dcel->halfEdges[2 * e + 1]->origin->id; }
+
+  bool operator()(int a, int b) const {
+    if (a == b) return false;
+    // Vértices estão em ordem lexicográfica: a extremidade esquerda de menor id começou antes
+    if (from(a) == from(b)) {
+      const auto &u = (*direction)[a], &w = (*direction)[b];
+      long long c = u.first * w.second - u.second * w.first;
+      if (c != 0) return c > 0;
+      return a < b;
+    }
+    if (from(a) < from(b)) {
+      int o = sideOfSegment(line(a), (*points)[from(b)]);
+      if (o == 0) o = sideOfSegment(line(a), (*points)[to(b)]);
+      if (o != 0) return o > 0;
+    } else {
+      int o = sideOfSegment(line(b), (*points)[from(a)]);
+      if (o == 0) o = sideOfSegment(line(b), (*points)[to(a)]);
+      if (o != 0) return o < 0;
+    }
+    return a < b;
+  }
+  bool operator()(int a, const ExactPoint &pt) const { return sideOfSegment(line(a), pt) > 0; }
+  bool operator()(const ExactPoint &pt, int a) const { return sideOfSegment(line(a), pt) < 0; }
+};
+
+// Mesma varredura de assignHoles (holes.hpp), sobre os ciclos da sobreposição:
+// container[c] é o ciclo da face que contém o ciclo c, ou -1 se c é uma face.
+// O menor vértice de um componente é sempre um vértice das entradas (um ponto de
+// interseção fica no interior de um segmento, cuja ponta esquerda é menor), então
+// as consultas são em pontos inteiros.
+static void assignOverlayHoles(const DCEL &dcel, const vector<ExactPoint> &points,
+                               const vector<OverlaySegment> &segments, const vector<int> &support,
+                               const vector<pair<long long, long long>> &direction, vector<int> &container) {
+  STATS_TIMER(STATS_HOLES);
+  size_t nv = dcel.vertices.size(), ne = dcel.halfEdges.size() / 2;
+  container.assign(dcel.faces.size(), -1);
+
+  // Componentes conexos, numerados pelo menor vértice (que é o primeiro na ordem)
+  vector<int> parent(nv);
+  iota(parent.begin(), parent.end(), 0);
+  auto root = [&](int v) {
+    while (parent[v] != v) v = parent[v] = parent[parent[v]];
+    return v;
+  };
+  for (size_t e = 0; e < ne; ++e) {
+    int a = root(dcel.halfEdges[2 * e]->origin->id), b = root(dcel.halfEdges[2 * e + 1]->origin->id);
+    if (a != b) parent[max(a, b)] = min(a, b);
+  }
+  vector<int> component(nv, -1), minVertex;
+  for (size_t v = 0; v < nv; ++v) {
+    if (!dcel.vertices[v]->incidentEdge) continue;
+    int r = root(v);
+    if (component[r] == -1) {
+      component[r] = minVertex.size();
+      minVertex.push_back(r);
+    }
+    component[v] = component[r];
+  }
+  size_t count = minVertex.size();
+  if (count < 2) return;
+
+  // Ciclo externo: o da semi-aresta que sai do menor vértice com o maior ângulo
+  vector<int> exterior(count, -1);
+  for (size_t c = 0; c < count; ++c) {
+    const HalfEdge *best = nullptr;
+    for (const HalfEdge *h : outgoingEdges(dcel.vertices[minVertex[c]])) {
+      if (!best) {
+        best = h;
+        continue;
+      }
+      pair<long long, long long> u = direction[best->id / 2], w = direction[h->id / 2];
+      if (u.first * w.second - u.second * w.first > 0) best = h;
+    }
+    exterior[c] = best->incidentFace->id;
+  }
+
+  // Varredura em x sobre as arestas não verticais (a semi-aresta par vai da esquerda para a direita)
+  vector<int> starts, ends;
+  for (size_t e = 0; e < ne; ++e) {
+    if (direction[e].first == 0) continue;
+    starts.push_back(e);
+    ends.push_back(e);
+  }
+  auto left = [&](int e) -> const ExactPoint & { return points[dcel.halfEdges[2 * e]->origin->id]; };
+  auto right = [&](int e) -> const ExactPoint & { return points[dcel.halfEdges[2 * e + 1]->origin->id]; };
+  sort(starts.begin(), starts.end(), [&](int a, int b) { return compareX(left(a), left(b)) < 0; });
+  sort(ends.begin(), ends.end(), [&](int a, int b) { return compareX(right(a), right(b)) < 0; });
+
+  set<int, OverlayHoleOrder> status(OverlayHoleOrder{&dcel, &points, &segments, &support, &direction});
+  vector<int> containerOf(count, -1);
+  size_t si = 0, ei = 0;
+  for (size_t c = 0; c < count; ++c) {
+    const ExactPoint &p = points[minVertex[c]];
+    while ((ei < ends.size() && compareX(right(ends[ei]), p) <= 0) ||
+           (si < starts.size() && compareX(left(starts[si]), p) <= 0)) {
+      const ExactPoint *x = ei < ends.size() ? &right(ends[ei]) : &left(starts[si]);
+      if (si < starts.size() && compareX(left(starts[si]), *x) < 0) x = &left(starts[si]);
+      ExactPoint at = *x;
+      for (; ei < ends.size() && compareX(right(ends[ei]), at) == 0; ++ei) status.erase(ends[ei]);
+      for (; si < starts.size() && compareX(left(starts[si]), at) == 0; ++si) status.insert(starts[si]);
+    }
+
+    // Aresta de outro componente logo abaixo de p
+    auto it = status.lower_bound(p);
+    while (it != status.begin()) {
+      --it;
+      int other = component[dcel.halfEdges[2 * *it]->origin->id];
+      if (other == static_cast<int>(c)) continue;
+      int above = dcel.halfEdges[2 * *it]->incidentFace->id;
+      containerOf[c] = above == exterior[other] ? containerOf[other] : above;
+      break;
+    }
+    if (containerOf[c] >= 0) container[exterior[c]] = containerOf[c];
+  }
+}
+
+// ======================================================================================================================= //
+
+bool overlayDCEL(const DCEL &a, const DCEL &b, OverlayResult &result, string &errorMessage) {
+  STATS_TIMER(STATS_OVERLAY);
+
+  vector<OverlaySegment> segments;
+  if (!collectOverlaySegments(a, 0, segments, errorMessage) || !collectOverlaySegments(b, 1, segments, errorMessage)) {
+    return false;
+  }
+
+  // 1. Varredura: os vértices da sobreposição e os que caem sobre cada segmento
+  vector<ExactPoint> points;
+  vector<pair<int, int>> incidences;
+  OverlaySweep(segments).run(points, incidences);
+  stable_sort(incidences.begin(), incidences.end(),
+              [](const pair<int, int> &x, const pair<int, int> &y) { return x.first < y.first; });
+
+  // 2. Trechos entre vértices consecutivos de cada segmento (do menor para o maior vértice);
+  //    trechos colineares das duas malhas têm as mesmas pontas e viram uma só aresta
+  struct Piece {
+    int from, to, seg;
+  };
+  vector<Piece> pieces;
+  for (size_t i = 0; i + 1 < incidences.size(); ++i) {
+    if (incidences[i].first == incidences[i + 1].first) {
+      pieces.push_back({incidences[i].second, incidences[i + 1].second, incidences[i].first});
+    }
+  }
+  sort(pieces.begin(), pieces.end(), [](const Piece &x, const Piece &y) {
+    return make_pair(x.from, x.to) < make_pair(y.from, y.to);
+  });
+
+  // 3. Vértices e pares de semi-arestas (2k no sentido do trecho, 2k+1 a gêmea)
+  DCEL &dcel = result.dcel;
+  for (const ExactPoint &p : points) {
+    dcel.addVertex(static_cast<double>(p.x) / static_cast<double>(p.d), static_cast<double>(p.y) / static_cast<double>(p.d));
+  }
+
+  vector<const HalfEdge *> sourceEdge[2];
+  vector<int> support;                          // por aresta: segmento de origem (um deles, se colineares)
+  vector<pair<long long, long long>> direction; // por aresta: direção inteira do segmento de origem
+  for (size_t i = 0, j; i < pieces.size(); i = j) {
+    HalfEdge *h = dcel.addHalfEdge();
+    HalfEdge *t = dcel.addHalfEdge();
+    h->origin = dcel.vertices[pieces[i].from];
+    t->origin = dcel.vertices[pieces[i].to];
+    h->twin = t;
+    t->twin = h;
+    for (auto &edges : sourceEdge) edges.insert(edges.end(), 2, nullptr);
+    for (j = i; j < pieces.size() && pieces[j].from == pieces[i].from && pieces[j].to == pieces[i].to; ++j) {
+      const OverlaySegment &s = segments[pieces[j].seg];
+      sourceEdge[s.source][h->id] = s.pq;
+      sourceEdge[s.source][t->id] = s.qp;
+    }
+    support.push_back(pieces[i].seg);
+    direction.push_back({segments[pieces[i].seg].dx, segments[pieces[i].seg].dy});
+  }
+
+  // 4. Semi-arestas que saem de cada vértice em ordem anti-horária: a que chega
+  //    pela gêmea de e segue pela vizinha de e no sentido horário
+  size_t nv = dcel.vertices.size(), nh = dcel.halfEdges.size();
+  vector<size_t> offset(nv + 1, 0);
+  for (const HalfEdge *h : dcel.halfEdges) offset[h->origin->id + 1]++;
+  for (size_t v = 0; v < nv; ++v) offset[v + 1] += offset[v];
+  vector<HalfEdge *> around(nh);
+  {
+    vector<size_t> fill(offset.begin(), offset.end() - 1);
+    for (HalfEdge *h : dcel.halfEdges) around[fill[h->origin->id]++] = h;
+  }
+
+  auto directionOf = [&](const HalfEdge *h) {
+    pair<long long, long long> d = direction[h->id / 2];
+    return h->id % 2 ? make_pair(-d.first, -d.second) : d;
+  };
+  auto angleLess = [&](const HalfEdge *x, const HalfEdge *y) {
+    pair<long long, long long> u = directionOf(x), w = directionOf(y);
+    bool lowerU = u.second < 0 || (u.second == 0 && u.first < 0);
+    bool lowerW = w.second < 0 || (w.second == 0 && w.first < 0);
+    if (lowerU != lowerW) return lowerW;
+    return u.first * w.second - u.second * w.first > 0;
+  };
+
+  for (size_t v = 0; v < nv; ++v) {
+    size_t lo = offset[v], hi = offset[v + 1];
+    sort(around.begin() + lo, around.begin() + hi, angleLess);
+    for (size_t i = lo; i < hi; ++i) {
+      HalfEdge *clockwise = around[i == lo ? hi - 1 : i - 1];
+      around[i]->twin->next = clockwise;
+      clockwise->prev = around[i]->twin;
+    }
+    if (lo < hi) dcel.vertices[v]->incidentEdge = around[lo];
+  }
+
+  // 5. Faces: os ciclos de next, na ordem da primeira semi-aresta de cada um
+  for (HalfEdge *h : dcel.halfEdges) {
+    if (h->incidentFace) continue;
+    Face *face = dcel.addFace();
+    face->outerComponent = h;
+    for (HalfEdge *e : faceEdges(face)) e->incidentFace = face;
+  }
+
+  // 6. Faces de origem
+  vector<int> inA, inB;
+  assignSourceFaces(dcel, a, sourceEdge[0], inA);
+  assignSourceFaces(dcel, b, sourceEdge[1], inB);
+
+  // 7. Buracos: o ciclo externo de um componente aninhado vira componente interno
+  //    da face que o contém; as demais faces são renumeradas na mesma ordem
+  vector<int> container;
+  assignOverlayHoles(dcel, points, segments, support, direction, container);
+
+  vector<Face *> cycles;
+  cycles.swap(dcel.faces);
+  vector<vector<HalfEdge *>> inner(cycles.size());
+  for (size_t c = 0; c < cycles.size(); ++c) {
+    if (container[c] >= 0) {
+      inner[container[c]].push_back(cycles[c]->outerComponent);
+    } else {
+      cycles[c]->id = dcel.faces.size();
+      dcel.faces.push_back(cycles[c]);
+      result.faceSources.push_back({inA[c], inB[c]});
+    }
+  }
+  for (size_t c = 0; c < cycles.size(); ++c) {
+    if (inner[c].empty()) continue;
+    Face *face = cycles[c];
+    for (HalfEdge *start : inner[c]) {
+      HalfEdge *e = start;
+      do {
+        e->incidentFace = face;
+        e = e->next;
+      } while (e != start);
+    }
+    dcel.setInnerComponents(face, inner[c]);
+  }
+  return true;
+}
+
+// ======================================================================================================================= //
+
+// Coordenada inteira sem casas decimais; as de interseção na menor forma que volta ao mesmo double
+static void putCoordinate(OutputWriter &out, double value) {
+  if (value == floor(value) && fabs(value) < 9007199254740992.0) {
+    out.putInt(static_cast<long long>(value));
+  } else {
+    out.putDouble(value);
+  }
+}
+
+void printOverlayOutput(const OverlayResult &overlay, OutputWriter &out) {
+  STATS_TIMER(STATS_OUTPUT);
+  const DCEL &dcel = overlay.dcel;
+  auto edgeOut = [](const HalfEdge *he) -> uint64_t { return he ? he->id + 1 : 0; };
+
+  out.putUInt(dcel.vertices.size());
+  out.put(' ');
+  out.putUInt(dcel.halfEdges.size() / 2);
+  out.put(' ');
+  out.putUInt(dcel.faces.size());
+  out.put('\n');
+
+  for (const Vertex *v : dcel.vertices) {
+    putCoordinate(out, v->x);
+    out.put(' ');
+    putCoordinate(out, v->y);
+    out.put(' ');
+    out.putUInt(edgeOut(v->incidentEdge));
+    out.put('\n');
+  }
+
+  // semi-aresta [buracos...] face_em_a face_em_b
+  for (const Face *f : dcel.faces) {
+    out.putUInt(edgeOut(f->outerComponent));
+    out.put(' ');
+    for (size_t i = 0; i < f->innerCount; ++i) {
+      out.putUInt(edgeOut(f->innerComponents[i]));
+      out.put(' ');
+    }
+    out.putUInt(overlay.faceSources[f->id].first + 1);
+    out.put(' ');
+    out.putUInt(overlay.faceSources[f->id].second + 1);
+    out.put('\n');
+  }
+
+  for (const HalfEdge *he : dcel.halfEdges) {
+    writeHalfEdgeLine(out, {he->origin->id + 1, edgeOut(he->twin), he->incidentFace->id + 1, edgeOut(he->next),
+                            edgeOut(he->prev)});
+  }
+}
@@ -0,0 +1,72 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef OVERLAY_HPP
+#define OVERLAY_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dcel.hpp"
+#include "output_writer.hpp"
+
+using namespace std;
+
+// Sobreposição (map overlay) de duas subdivisões planares válidas. Uma
+// varredura de Bentley–Ottmann sobre as arestas das duas DCELs encontra todos
+// os pontos em que elas se cruzam ou se tocam, em O((n + k) log n) para n
+// arestas e k interseções. As arestas são partidas nesses pontos, trechos
+// colineares das duas malhas viram uma só aresta, e as semi-arestas são
+// ligadas pela ordem angular em volta de cada vértice.
+//
+// Cada face da DCEL resultante guarda o par de faces de origem (uma de cada
+// malha) que a contém. Ciclos em sentido horário, como a face externa das
+// entradas, representam a região em volta de um componente conexo; como na
+// construção a partir da malha, o de um componente aninhado é componente
+// interno (buraco) da face que o contém, achada pela mesma varredura de
+// assignHoles sobre as arestas da sobreposição.
+//
+// Os pontos de interseção são racionais e a varredura os compara de forma
+// exata em __int128, o que limita as coordenadas de entrada a
+// |x|, |y| <= OVERLAY_MAX_COORD. Na DCEL resultante, as coordenadas são
+// guardadas em double.
+
+static const long long OVERLAY_MAX_COORD = 1LL << 22;
+
+struct OverlayResult {
+  DCEL dcel;
+  // Por face da DCEL (índice = Face::id): faces de origem em a e em b, base 0;
+  // -1 quando a face fica fora de todas as faces limitadas daquela malha
+  vector<pair<int, int>> faceSources;
+};
+
+/**
+ * Calcula a subdivisão combinada de duas DCELs
+ * @param a Primeira DCEL, construída a partir de uma malha válida
+ * @param b Segunda DCEL, construída a partir de uma malha válida
+ * @param result Saída: DCEL sobreposta e faces de origem de cada face
+ * @param errorMessage Mensagem de erro caso as coordenadas não sejam inteiras ou
+ *                     excedam OVERLAY_MAX_COORD
+ * @return true se a sobreposição foi calculada
+ */
+bool overlayDCEL(const DCEL &a, const DCEL &b, OverlayResult &result, string &errorMessage);
+
+/**
+ * Escreve a sobreposição no formato da DCEL. Vértices de interseção têm
+ * coordenadas fracionárias; cada linha de face traz, depois da semi-aresta do
+ * ciclo externo e das dos buracos, as faces de origem em a e em b (base 1,
+ * 0 = fora da malha)
+ * @param overlay Resultado de overlayDCEL
+ * @param out Destino
+ */
+void printOverlayOutput(const OverlayResult &overlay, OutputWriter &out);
+
+#endif // OVERLAY_HPP
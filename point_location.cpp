@@ -0,0 +1,275 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "point_location.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+// Prioridade da treap derivada do índice do segmento (determinística, sem guardar no nó)
+static inline uint32_t treapPriority(int seg) {
+  uint32_t x = static_cast<uint32_t>(seg) + 0x9E3779B9u;
+  x ^= x >> 16;
+  x *= 0x85EBCA6Bu;
+  x ^= x >> 13;
+  x *= 0xC2B2AE35u;
+  x ^= x >> 16;
+  return x;
+}
+
+static inline bool higherPriority(int a, int b) {
+  uint32_t pa = treapPriority(a), pb = treapPriority(b);
+  return pa != pb ? pa > pb : a < b;
+}
+
+// ======================================================================================================================= //
+
+SlabLocator::SlabLocator(const vector<SweepSegment> &segments) : segs(segments) {
+  // Eventos por abscissa: em cada x, primeiro saem os segmentos que terminam, depois entram os que começam
+  vector<int> starts, ends;
+  for (size_t i = 0; i < segs.size(); ++i) {
+    if (segs[i].p.first == segs[i].q.first) continue; // vertical
+    starts.push_back(i);
+    ends.push_back(i);
+  }
+  sort(starts.begin(), starts.end(), [this](int a, int b) { return segs[a].p.first < segs[b].p.first; });
+  sort(ends.begin(), ends.end(), [this](int a, int b) { return segs[a].q.first < segs[b].q.first; });
+
+  nodes.reserve(starts.size() * 8);
+  int root = -1;
+  size_t si = 0, ei = 0;
+  while (si < starts.size() || ei < ends.size()) {
+    int x = ei < ends.size() ? segs[ends[ei]].q.first : segs[starts[si]].p.first;
+    if (si < starts.size()) x = min(x, segs[starts[si]].p.first);
+
+    for (; ei < ends.size() && segs[ends[ei]].q.first == x; ++ei) {
+      root = erase(root, ends[ei]);
+    }
+    for (; si < starts.size() && segs[starts[si]].p.first == x; ++si) {
+      root = insert(root, starts[si]);
+    }
+    xs.push_back(x);
+    roots.push_back(root);
+  }
+}
+
+// ======================================================================================================================= //
+
+bool SlabLocator::below(int a, int b) const {
+  return segmentBelow(segs[a], segs[b], a, b);
+}
+
+int SlabLocator::copyNode(int n) {
+  Node copy = nodes[n];
+  nodes.push_back(copy);
+  return static_cast<int>(nodes.size()) - 1;
+}
+
+// Separa os segmentos abaixo de seg dos demais, copiando o caminho percorrido
+void SlabLocator::split(int root, int seg, int &lower, int &upper) {
+  if (root == -1) {
+    lower = upper = -1;
+    return;
+  }
+  int c = copyNode(root);
+  int l, r;
+  if (below(nodes[c].seg, seg)) {
+    split(nodes[c].right, seg, l, r);
+    nodes[c].right = l;
+    lower = c;
+    upper = r;
+  } else {
+    split(nodes[c].left, seg, l, r);
+    nodes[c].left = r;
+    lower = l;
+    upper = c;
+  }
+}
+
+// Junta duas versões em que todo segmento de a está abaixo de todo segmento de b
+int SlabLocator::merge(int a, int b) {
+  if (a == -1) return b;
+  if (b == -1) return a;
+  if (higherPriority(nodes[a].seg, nodes[b].seg)) {
+    int c = copyNode(a);
+    int t = merge(nodes[c].right, b);
+    nodes[c].right = t;
+    return c;
+  }
+  int c = copyNode(b);
+  int t = merge(a, nodes[c].left);
+  nodes[c].left = t;
+  return c;
+}
+
+int SlabLocator::insert(int root, int seg) {
+  if (root == -1 || higherPriority(seg, nodes[root].seg)) {
+    int l, r;
+    split(root, seg, l, r);
+    nodes.push_back({seg, l, r});
+    return static_cast<int>(nodes.size()) - 1;
+  }
+  int c = copyNode(root);
+  if (below(seg, nodes[c].seg)) {
+    int t = insert(nodes[c].left, seg);
+    nodes[c].left = t;
+  } else {
+    int t = insert(nodes[c].right, seg);
+    nodes[c].right = t;
+  }
+  return c;
+}
+
+int SlabLocator::erase(int root, int seg) {
+  if (root == -1) return -1;
+  if (nodes[root].seg == seg) {
+    return merge(nodes[root].left, nodes[root].right);
+  }
+  int c = copyNode(root);
+  if (below(seg, nodes[c].seg)) {
+    int t = erase(nodes[c].left, seg);
+    nodes[c].left = t;
+  } else {
+    int t = erase(nodes[c].right, seg);
+    nodes[c].right = t;
+  }
+  return c;
+}
+
+// ======================================================================================================================= //
+
+int SlabLocator::edgeBelow(const pair<int, int> &pt) const {
+  // Faixa [xs[i], xs[i+1]) que contém pt.x; na última abscissa vale a faixa à esquerda
+  auto it = upper_bound(xs.begin(), xs.end(), pt.first);
+  if (it == xs.begin()) return -1;
+  size_t i = (it - xs.begin()) - 1;
+  if (i + 1 == xs.size()) {
+    if (xs[i] != pt.first || i == 0) return -1;
+    i--;
+  }
+
+  // Descida: à direita (acima) quando o ponto está acima do segmento
+  int best = -1;
+  int n = roots[i];
+  while (n != -1) {
+    const SweepSegment &s = segs[nodes[n].seg];
+    int o = orientation(s.p, s.q, pt);
+    if (o == 0) return nodes[n].seg; // ponto sobre o segmento
+    if (o == 2) {
+      best = nodes[n].seg;
+      n = nodes[n].right;
+    } else {
+      n = nodes[n].left;
+    }
+  }
+  return best;
+}
+
+// ======================================================================================================================= //
+
+PointLocator::PointLocator(const CompactDCEL &dcel) {
+  vector<pair<int, int>> coords(dcel.numVertices());
+  for (size_t v = 0; v < coords.size(); ++v) {
+    coords[v] = {dcel.vx[v], dcel.vy[v]};
+  }
+
+  // Ciclos das faces a partir do componente externo, depois os buracos
+  FaceList cycles;
+  vector<int> owner;
+  cycles.reserve(dcel.numFaces() + dcel.innerEdges.size(), dcel.numHalfEdges());
+  auto pushCycle = [&](CompactDCEL::index_t start, size_t f) {
+    if (start != CompactDCEL::NIL) {
+      CompactDCEL::index_t h = start;
+      do {
+        cycles.push(dcel.origin[h]);
+        h = dcel.next[h];
+      } while (h != start);
+    }
+    cycles.closeFace();
+    owner.push_back(f);
+  };
+  for (size_t f = 0; f < dcel.numFaces(); ++f) {
+    pushCycle(dcel.faceEdge[f], f);
+  }
+  for (size_t f = 0; f < dcel.numFaces(); ++f) {
+    for (size_t i = 0; i < dcel.numInner(f); ++i) pushCycle(dcel.innerEdges[dcel.innerOffsets[f] + i], f);
+  }
+  build(coords, cycles, owner, dcel.numFaces());
+}
+
+PointLocator::PointLocator(const DCEL &dcel) {
+  vector<pair<int, int>> coords(dcel.vertices.size());
+  for (size_t v = 0; v < coords.size(); ++v) {
+    coords[v] = {static_cast<int>(dcel.vertices[v]->x), static_cast<int>(dcel.vertices[v]->y)};
+  }
+
+  FaceList cycles;
+  vector<int> owner;
+  cycles.reserve(dcel.faces.size(), dcel.halfEdges.size());
+  auto pushCycle = [&](const HalfEdge *start, size_t f) {
+    if (start) {
+      const HalfEdge *he = start;
+      do {
+        cycles.push(static_cast<int>(he->origin->id));
+        he = he->next;
+      } while (he != start);
+    }
+    cycles.closeFace();
+    owner.push_back(f);
+  };
+  for (const Face *face : dcel.faces) {
+    pushCycle(face->outerComponent, face->id);
+  }
+  for (const Face *face : dcel.faces) {
+    for (size_t i = 0; i < face->innerCount; ++i) pushCycle(face->innerComponents[i], face->id);
+  }
+  build(coords, cycles, owner, dcel.faces.size());
+}
+
+// ======================================================================================================================= //
+
+void PointLocator::build(const vector<pair<int, int>> &coords, const FaceList &cycles, const vector<int> &owner,
+                         size_t numFaces) {
+  // Face limitada = ciclo externo anti-horário (área com sinal positiva); os
+  // primeiros numFaces ciclos são os externos, na ordem das faces
+  bounded.assign(numFaces, 0);
+  for (size_t f = 0; f < numFaces; ++f) {
+    bounded[f] = polygonOrientation(coords, cycles[f]) > 0;
+  }
+  cycleFace = owner;
+
+  locator = SlabLocator(collectSegments(coords, cycles));
+}
+
+// ======================================================================================================================= //
+
+int PointLocator::locate(const pair<int, int> &pt) const {
+  int e = locator.edgeBelow(pt);
+  if (e == -1) return -1;
+
+  // A face acima do segmento é a do ciclo que o percorre da esquerda para a
+  // direita (interior à esquerda); num buraco, a face que o contém
+  const SweepSegment &s = locator.segments()[e];
+  int cycle = (s.from == s.u) ? s.face : s.twinFace;
+  if (cycle < 0) return -1;
+  int face = cycleFace[cycle];
+  return bounded[face] ? face : -1;
+}
+
+void PointLocator::locate(const vector<pair<int, int>> &points, vector<int> &faces, ThreadPool *pool) const {
+  faces.resize(points.size());
+  parallelFor(pool, 0, points.size(), 4096, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
+      faces[i] = locate(points[i]);
+    }
+  });
+}
@@ -0,0 +1,120 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef POINT_LOCATION_HPP
+#define POINT_LOCATION_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "dcel.hpp"
+#include "dcel_soa.hpp"
+#include "sweep.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+
+// ---------- Classe SlabLocator ----------
+// Decomposição em faixas verticais (slabs) sobre segmentos que não se cruzam.
+// Uma varredura em x insere e remove os segmentos numa treap persistente
+// (cópia de caminho), ordenada de baixo para cima por segmentBelow; cada
+// abscissa de evento guarda a versão válida à sua direita. Consulta: busca
+// binária da faixa + descida na versão, O(log n). Memória O(n log n).
+// Segmentos verticais não entram: não separam nada dentro de uma faixa.
+class SlabLocator {
+public:
+  SlabLocator() = default;
+
+  /**
+   * Constrói as faixas
+   * @param segments Segmentos com extremidades em ordem lexicográfica (ver collectSegments);
+   *                 só podem se tocar nas extremidades
+   */
+  explicit SlabLocator(const vector<SweepSegment> &segments);
+
+  /**
+   * Segmento imediatamente abaixo do ponto (ou que passa por ele)
+   * @param pt Ponto de consulta
+   * @return Índice do segmento em segments, ou -1 se não houver nenhum abaixo
+   */
+  int edgeBelow(const pair<int, int> &pt) const;
+
+  /**
+   * Segmentos de entrada (os mesmos índices devolvidos por edgeBelow)
+   */
+  const vector<SweepSegment> &segments() const { return segs; }
+
+  /**
+   * Nós da treap persistente (todas as versões)
+   */
+  size_t nodeCount() const { return nodes.size(); }
+
+private:
+  struct Node {
+    int seg;
+    int left, right; // -1 = vazio
+  };
+
+  vector<SweepSegment> segs;
+  vector<Node> nodes;
+  vector<int> xs;    // abscissas dos eventos, crescentes
+  vector<int> roots; // roots[i]: versão para x em [xs[i], xs[i+1])
+
+  int copyNode(int n);
+  int insert(int root, int seg);
+  int erase(int root, int seg);
+  int merge(int a, int b);
+  void split(int root, int seg, int &below, int &above);
+  bool below(int a, int b) const;
+};
+
+// ---------- Classe PointLocator ----------
+// Localização de pontos nas faces de uma DCEL construída: a face que contém o
+// ponto é a que fica acima da aresta imediatamente abaixo dele. Faces em
+// sentido horário (a face externa) representam a região ilimitada. As arestas
+// dos componentes internos (buracos) também entram: acima delas fica a face
+// que contém o buraco. Pontos na borda ficam com a face acima da aresta (ou à
+// direita, se ela for vertical, conforme a aresta abaixo).
+class PointLocator {
+public:
+  /**
+   * @param dcel DCEL construída a partir de uma malha válida
+   */
+  explicit PointLocator(const CompactDCEL &dcel);
+  explicit PointLocator(const DCEL &dcel);
+
+  /**
+   * Face que contém o ponto
+   * @param pt Ponto de consulta
+   * @return Índice da face (base 0), ou -1 se o ponto está na região ilimitada
+   */
+  int locate(const pair<int, int> &pt) const;
+
+  /**
+   * Localiza um lote de pontos
+   * @param points Pontos de consulta
+   * @param faces Saída: uma face (ou -1) por ponto, na mesma ordem
+   * @param pool Pool para dividir o lote entre threads (pode ser nulo)
+   */
+  void locate(const vector<pair<int, int>> &points, vector<int> &faces, ThreadPool *pool = nullptr) const;
+
+  const SlabLocator &slabs() const { return locator; }
+
+private:
+  SlabLocator locator;
+  vector<char> bounded;  // face com ciclo externo anti-horário (região limitada)
+  vector<int> cycleFace; // face de cada ciclo dado a SlabLocator
+
+  void build(const vector<pair<int, int>> &coords, const FaceList &cycles, const vector<int> &owner,
+             size_t numFaces);
+};
+
+#endif // POINT_LOCATION_HPP
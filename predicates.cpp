@@ -0,0 +1,381 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "predicates.hpp"
+#include "stats.hpp"
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PREDICATES_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Filtro das coordenadas inteiras: as diferenças são exatas (int64) e só os
+// dois produtos e a subtração arredondam, logo |det - exato| <= 4ε(|l| + |r|)
+// (ε = DBL_EPSILON, com folga). Fora dessa faixa o sinal em double é o certo.
+// Se |l| + |r| < 2^53, os produtos e a subtração são inteiros exatos e o sinal
+// (inclusive zero) também é o certo: o caso comum das malhas de coordenadas
+// pequenas, em que os colineares nunca chegam ao cálculo exato.
+static const double INT_ERR_BOUND = 4 * DBL_EPSILON;
+static const double INT_EXACT_LIMIT = 9007199254740992.0; // 2^53
+
+// Cota de Shewchuk (ccwerrboundA) para coordenadas double: (3 + 16u)u, u = 2^-53
+static const double DOUBLE_ERR_BOUND = (3.0 + 16.0 * (DBL_EPSILON / 2)) * (DBL_EPSILON / 2);
+
+// Sinal exato pelo determinante em __int128 (não estoura para |coord| < 2^62)
+static inline int orientExact(long long ax, long long ay, long long bx, long long by, long long cx, long long cy) {
+  __int128 det = static_cast<__int128>(bx - ax) * (cy - ay) - static_cast<__int128>(by - ay) * (cx - ax);
+  return (det > 0) - (det < 0);
+}
+
+// Filtro + fallback, sem contar nas estatísticas; fallbacks é incrementado quando o filtro não decide
+static inline int orientFiltered(long long ax, long long ay, long long bx, long long by, long long cx, long long cy,
+                                 unsigned &fallbacks) {
+  double l = static_cast<double>(bx - ax) * static_cast<double>(cy - ay);
+  double r = static_cast<double>(by - ay) * static_cast<double>(cx - ax);
+  double det = l - r;
+  double magnitude = fabs(l) + fabs(r);
+  if (magnitude < INT_EXACT_LIMIT) return (det > 0) - (det < 0);
+  double bound = INT_ERR_BOUND * magnitude;
+  if (det > bound) return 1;
+  if (det < -bound) return -1;
+  fallbacks++;
+  return orientExact(ax, ay, bx, by, cx, cy);
+}
+
+int orient2d(long long ax, long long ay, long long bx, long long by, long long cx, long long cy) {
+  unsigned fallbacks = 0;
+  int sign = orientFiltered(ax, ay, bx, by, cx, cy, fallbacks);
+  STATS_COUNT(STATS_PREDICATES);
+  STATS_ADD(STATS_PREDICATE_FALLBACKS, fallbacks);
+  return sign;
+}
+
+// ======================================================================================================================= //
+
+// a + b = x + y exatamente, com x = fl(a + b)
+static inline void twoSum(double a, double b, double &x, double &y) {
+  x = a + b;
+  double bv = x - a;
+  double av = x - bv;
+  y = (a - av) + (b - bv);
+}
+
+// a · b = x + y exatamente, com x = fl(a · b)
+static inline void twoProduct(double a, double b, double &x, double &y) {
+  x = a * b;
+  y = fma(a, b, -x);
+}
+
+// Soma exata de termos em uma expansão não sobreposta (Grow-Expansion com
+// eliminação de zeros); o sinal da soma é o do componente de maior magnitude
+static int expansionSign(const double *terms, int count) {
+  double expansion[16];
+  int size = 0;
+  for (int t = 0; t < count; t++) {
+    double q = terms[t];
+    int out = 0;
+    for (int i = 0; i < size; i++) {
+      double sum, err;
+      twoSum(q, expansion[i], sum, err);
+      q = sum;
+      if (err != 0) expansion[out++] = err;
+    }
+    if (q != 0) expansion[out++] = q;
+    size = out;
+  }
+  if (size == 0) return 0;
+  return expansion[size - 1] > 0 ? 1 : -1;
+}
+
+int orient2dDouble(double ax, double ay, double bx, double by, double cx, double cy) {
+  STATS_COUNT(STATS_PREDICATES);
+  double l = (ax - cx) * (by - cy);
+  double r = (ay - cy) * (bx - cx);
+  double det = l - r;
+  double bound = DOUBLE_ERR_BOUND * (fabs(l) + fabs(r));
+  if (det > bound) return 1;
+  if (det < -bound) return -1;
+
+  // det = ax·by - ax·cy + bx·cy - bx·ay + cx·ay - cx·by, cada produto como soma exata de dois doubles
+  STATS_COUNT(STATS_PREDICATE_FALLBACKS);
+  const double factors[6][2] = {{ax, by}, {-ax, cy}, {bx, cy}, {-bx, ay}, {cx, ay}, {-cx, by}};
+  double terms[12];
+  for (int k = 0; k < 6; k++) twoProduct(factors[k][0], factors[k][1], terms[2 * k], terms[2 * k + 1]);
+  return expansionSign(terms, 12);
+}
+
+// ======================================================================================================================= //
+
+int polygonOrientation(const vector<pair<int, int>> &polygon) {
+  __int128 area = 0;
+  size_t n = polygon.size();
+  for (size_t i = 0; i < n; i++) {
+    const auto &a = polygon[i], &b = polygon[(i + 1) % n];
+    area += static_cast<long long>(a.first) * b.second - static_cast<long long>(b.first) * a.second;
+  }
+  return (area > 0) - (area < 0);
+}
+
+int polygonOrientation(const vector<pair<int, int>> &coords, const FaceView &face) {
+  __int128 area = 0;
+  size_t n = face.size();
+  for (size_t i = 0; i < n; i++) {
+    const auto &a = coords[face[i]], &b = coords[face[(i + 1) % n]];
+    area += static_cast<long long>(a.first) * b.second - static_cast<long long>(b.first) * a.second;
+  }
+  return (area > 0) - (area < 0);
+}
+
+// ======================================================================================================================= //
+
+void PolygonSoA::assign(const vector<pair<int, int>> &polygon) {
+  size_t n = polygon.size();
+  xs.resize(n + 1);
+  ys.resize(n + 1);
+  for (size_t i = 0; i < n; i++) {
+    xs[i] = polygon[i].first;
+    ys[i] = polygon[i].second;
+  }
+  if (n > 0) {
+    xs[n] = xs[0];
+    ys[n] = ys[0];
+  }
+}
+
+void PolygonSoA::assign(const vector<pair<int, int>> &coords, const FaceView &face) {
+  size_t n = face.size();
+  xs.resize(n + 1);
+  ys.resize(n + 1);
+  for (size_t i = 0; i < n; i++) {
+    xs[i] = coords[face[i]].first;
+    ys[i] = coords[face[i]].second;
+  }
+  if (n > 0) {
+    xs[n] = xs[0];
+    ys[n] = ys[0];
+  }
+}
+
+// ======================================================================================================================= //
+
+// Todas as versões decidem cada aresta (a, b) pelo sinal s de orient2d(a, b, p):
+//  borda:  s == 0 e p dentro do retângulo da aresta
+//  dentro: o raio para a direita cruza se (ay > y) != (by > y) e s tem o sinal de dy
+// (equivale a x < ax + dx·(y - ay)/dy, sem a divisão). As versões vetoriais
+// fazem em int32 as comparações exatas que descartam a maioria das arestas
+// (retângulo e faixa do raio) e avaliam orient2d, com o filtro, só nas lanes
+// que sobram.
+
+// Teste exato de uma aresta; devolve true se p está sobre ela
+template <bool Border, bool Inside>
+static inline bool edgeExact(int x, int y, int ax, int ay, int bx, int by, unsigned &crossings, unsigned &evaluations,
+                             unsigned &fallbacks) {
+  bool inbox = x >= min(ax, bx) && x <= max(ax, bx) && y >= min(ay, by) && y <= max(ay, by);
+  bool cond1 = (ay > y) != (by > y);
+  if (!(Border && inbox) && !(Inside && cond1)) return false;
+  evaluations++;
+  int s = orientFiltered(ax, ay, bx, by, x, y, fallbacks);
+  if (Border && inbox && s == 0) return true;
+  if (Inside && cond1) crossings += (by > ay) ? (s > 0) : (s < 0);
+  return false;
+}
+
+// Arestas [from, n) uma a uma; também usado para o resto das versões vetoriais
+template <bool Border, bool Inside>
+static PointClass scalarTail(int x, int y, const int *xs, const int *ys, size_t from, size_t n, unsigned crossings,
+                             unsigned evaluations, unsigned fallbacks) {
+  bool border = false;
+  for (size_t i = from; i < n && !border; i++) {
+    border = edgeExact<Border, Inside>(x, y, xs[i], ys[i], xs[i + 1], ys[i + 1], crossings, evaluations, fallbacks);
+  }
+  STATS_ADD(STATS_PREDICATES, evaluations);
+  STATS_ADD(STATS_PREDICATE_FALLBACKS, fallbacks);
+  if (border) return POINT_ON_BORDER;
+  return (Inside && (crossings & 1)) ? POINT_INSIDE : POINT_OUTSIDE;
+}
+
+template <bool Border, bool Inside>
+static PointClass classifyScalar(int x, int y, const int *xs, const int *ys, size_t n) {
+  return scalarTail<Border, Inside>(x, y, xs, ys, 0, n, 0, 0, 0);
+}
+
+// ======================================================================================================================= //
+
+#ifdef PREDICATES_X86
+
+// Refaz em escalar as lanes relevantes (bit k = aresta i + k); true se o ponto está sobre uma delas
+template <bool Border, bool Inside>
+static inline bool relevantLanes(int mask, int x, int y, const int *xs, const int *ys, size_t i, unsigned &crossings,
+                                 unsigned &evaluations, unsigned &fallbacks) {
+  while (mask) {
+    size_t k = i + __builtin_ctz(mask);
+    mask &= mask - 1;
+    if (edgeExact<Border, Inside>(x, y, xs[k], ys[k], xs[k + 1], ys[k + 1], crossings, evaluations, fallbacks)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <bool Border, bool Inside>
+__attribute__((target("sse4.1"))) static PointClass classifySSE4(int x, int y, const int *xs, const int *ys,
+                                                                  size_t n) {
+  const __m128i X = _mm_set1_epi32(x), Y = _mm_set1_epi32(y);
+  unsigned crossings = 0, evaluations = 0, fallbacks = 0;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i ax = _mm_loadu_si128(reinterpret_cast<const __m128i *>(xs + i));
+    __m128i bx = _mm_loadu_si128(reinterpret_cast<const __m128i *>(xs + i + 1));
+    __m128i ay = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ys + i));
+    __m128i by = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ys + i + 1));
+
+    // Comparações exatas em int32: a orientação só é avaliada nas arestas que podem conter o ponto ou cruzar o raio
+    __m128i relevant = _mm_setzero_si128();
+    if (Border) {
+      __m128i outside = _mm_or_si128(_mm_or_si128(_mm_cmpgt_epi32(_mm_min_epi32(ax, bx), X),
+                                                  _mm_cmpgt_epi32(X, _mm_max_epi32(ax, bx))),
+                                     _mm_or_si128(_mm_cmpgt_epi32(_mm_min_epi32(ay, by), Y),
+                                                  _mm_cmpgt_epi32(Y, _mm_max_epi32(ay, by))));
+      relevant = _mm_andnot_si128(outside, _mm_set1_epi32(-1));
+    }
+    if (Inside) {
+      relevant = _mm_or_si128(relevant, _mm_xor_si128(_mm_cmpgt_epi32(ay, Y), _mm_cmpgt_epi32(by, Y)));
+    }
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(relevant));
+    if (mask && relevantLanes<Border, Inside>(mask, x, y, xs, ys, i, crossings, evaluations, fallbacks)) {
+      STATS_ADD(STATS_PREDICATES, evaluations);
+      STATS_ADD(STATS_PREDICATE_FALLBACKS, fallbacks);
+      return POINT_ON_BORDER;
+    }
+  }
+  return scalarTail<Border, Inside>(x, y, xs, ys, i, n, crossings, evaluations, fallbacks);
+}
+
+// ======================================================================================================================= //
+
+template <bool Border, bool Inside>
+__attribute__((target("avx2"))) static PointClass classifyAVX2(int x, int y, const int *xs, const int *ys, size_t n) {
+  const __m256i X = _mm256_set1_epi32(x), Y = _mm256_set1_epi32(y);
+  unsigned crossings = 0, evaluations = 0, fallbacks = 0;
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i ax = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(xs + i));
+    __m256i bx = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(xs + i + 1));
+    __m256i ay = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ys + i));
+    __m256i by = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ys + i + 1));
+
+    __m256i relevant = _mm256_setzero_si256();
+    if (Border) {
+      __m256i outside = _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi32(_mm256_min_epi32(ax, bx), X),
+                                                        _mm256_cmpgt_epi32(X, _mm256_max_epi32(ax, bx))),
+                                        _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_min_epi32(ay, by), Y),
+                                                        _mm256_cmpgt_epi32(Y, _mm256_max_epi32(ay, by))));
+      relevant = _mm256_andnot_si256(outside, _mm256_set1_epi32(-1));
+    }
+    if (Inside) {
+      relevant = _mm256_or_si256(relevant, _mm256_xor_si256(_mm256_cmpgt_epi32(ay, Y), _mm256_cmpgt_epi32(by, Y)));
+    }
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(relevant));
+    if (mask && relevantLanes<Border, Inside>(mask, x, y, xs, ys, i, crossings, evaluations, fallbacks)) {
+      STATS_ADD(STATS_PREDICATES, evaluations);
+      STATS_ADD(STATS_PREDICATE_FALLBACKS, fallbacks);
+      return POINT_ON_BORDER;
+    }
+  }
+  return scalarTail<Border, Inside>(x, y, xs, ys, i, n, crossings, evaluations, fallbacks);
+}
+
+#endif // PREDICATES_X86
+
+// ======================================================================================================================= //
+
+typedef PointClass (*Kernel)(int, int, const int *, const int *, size_t);
+
+struct KernelSet {
+  Kernel classify, border, inside;
+};
+
+static const KernelSet KERNELS[] = {
+    {classifyScalar<true, true>, classifyScalar<true, false>, classifyScalar<false, true>},
+#ifdef PREDICATES_X86
+    {classifySSE4<true, true>, classifySSE4<true, false>, classifySSE4<false, true>},
+    {classifyAVX2<true, true>, classifyAVX2<true, false>, classifyAVX2<false, true>},
+#endif
+};
+
+// DCEL_PREDICATES=scalar|sse4.1|avx2 força um nível (para comparar as versões)
+static PredicateLevel initialLevel() {
+  PredicateLevel level = detectPredicateLevel();
+  if (const char *forced = getenv("DCEL_PREDICATES")) {
+    for (PredicateLevel l : {PREDICATES_SCALAR, PREDICATES_SSE4, PREDICATES_AVX2}) {
+      if (strcmp(forced, predicateLevelName(l)) == 0) level = min(l, level);
+    }
+  }
+  return level;
+}
+
+static PredicateLevel currentLevel = initialLevel();
+static const KernelSet *current = &KERNELS[currentLevel];
+
+PredicateLevel detectPredicateLevel() {
+#ifdef PREDICATES_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return PREDICATES_AVX2;
+  if (__builtin_cpu_supports("sse4.1")) return PREDICATES_SSE4;
+#endif
+  return PREDICATES_SCALAR;
+}
+
+PredicateLevel predicateLevel() { return currentLevel; }
+
+PredicateLevel setPredicateLevel(PredicateLevel level) {
+  currentLevel = min(level, detectPredicateLevel());
+  current = &KERNELS[currentLevel];
+  return currentLevel;
+}
+
+const char *predicateLevelName(PredicateLevel level) {
+  switch (level) {
+  case PREDICATES_AVX2:
+    return "avx2";
+  case PREDICATES_SSE4:
+    return "sse4.1";
+  default:
+    return "scalar";
+  }
+}
+
+// ======================================================================================================================= //
+
+PointClass classifyPoint(const pair<int, int> &pt, const PolygonSoA &polygon) {
+  STATS_COUNT(STATS_BORDER_TESTS);
+  STATS_COUNT(STATS_POLYGON_TESTS);
+  return current->classify(pt.first, pt.second, polygon.xs.data(), polygon.ys.data(), polygon.size());
+}
+
+bool pointOnBorder(const pair<int, int> &pt, const PolygonSoA &polygon) {
+  STATS_COUNT(STATS_BORDER_TESTS);
+  return current->border(pt.first, pt.second, polygon.xs.data(), polygon.ys.data(), polygon.size()) ==
+         POINT_ON_BORDER;
+}
+
+bool pointInside(const pair<int, int> &pt, const PolygonSoA &polygon) {
+  STATS_COUNT(STATS_POLYGON_TESTS);
+  return current->inside(pt.first, pt.second, polygon.xs.data(), polygon.ys.data(), polygon.size()) ==
+         POINT_INSIDE;
+}
@@ -0,0 +1,149 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef PREDICATES_HPP
+#define PREDICATES_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mesh.hpp"
+
+using namespace std;
+
+// Predicados geométricos exatos e adaptativos. A orientação é avaliada
+// primeiro em double, com uma cota estática de erro; só quando o filtro não
+// decide o sinal ela é refeita com aritmética exata (__int128 para coordenadas
+// inteiras, expansões de ponto flutuante para coordenadas double). Os casos
+// que caem no cálculo exato são contados (--stats: predicate_fallbacks).
+//
+// Os testes de borda e de interior também existem em lote: um ponto contra
+// todas as arestas de um polígono guardado em SoA (x[] e y[] contíguos):
+// escalar portátil, SSE4.1 (4 arestas por passo) e AVX2 (8 arestas por passo).
+// A melhor versão suportada pela CPU é escolhida na primeira chamada; todas
+// dão o resultado exato.
+
+/**
+ * Sinal da orientação de (a, b, c) para coordenadas inteiras (exato se |coord| < 2^62)
+ * @return +1 anti-horário, -1 horário, 0 colinear
+ */
+int orient2d(long long ax, long long ay, long long bx, long long by, long long cx, long long cy);
+
+/**
+ * Sinal da orientação de (a, b, c) para coordenadas double finitas (exato, sem underflow)
+ * @return +1 anti-horário, -1 horário, 0 colinear
+ */
+int orient2dDouble(double ax, double ay, double bx, double by, double cx, double cy);
+
+/**
+ * Orientação de pontos com coordenadas do tipo Coord; a versão exata é
+ * escolhida em tempo de compilação (inteiros: orient2d, ponto flutuante:
+ * orient2dDouble), sem custo de despacho
+ * @return +1 anti-horário, -1 horário, 0 colinear
+ */
+template <class Coord>
+inline int orient2d(const pair<Coord, Coord> &a, const pair<Coord, Coord> &b, const pair<Coord, Coord> &c) {
+  static_assert(is_arithmetic<Coord>::value, "coordenadas devem ser numéricas");
+  if constexpr (is_floating_point<Coord>::value) {
+    return orient2dDouble(a.first, a.second, b.first, b.second, c.first, c.second);
+  } else {
+    return orient2d(static_cast<long long>(a.first), static_cast<long long>(a.second),
+                    static_cast<long long>(b.first), static_cast<long long>(b.second),
+                    static_cast<long long>(c.first), static_cast<long long>(c.second));
+  }
+}
+
+/**
+ * Sinal exato da área do polígono (soma em __int128)
+ * @return +1 anti-horário, -1 horário, 0 degenerado
+ */
+int polygonOrientation(const vector<pair<int, int>> &polygon);
+
+/**
+ * Sentido de um polígono simples com coordenadas mais largas que 32 bits, onde
+ * a soma das áreas estouraria __int128: orientação exata no vértice extremo
+ * (menor x, depois menor y), que é vértice convexo do polígono
+ * @return +1 anti-horário, -1 horário, 0 degenerado
+ */
+template <class Coord>
+int polygonOrientation(const vector<pair<Coord, Coord>> &polygon) {
+  size_t n = polygon.size();
+  if (n < 3) return 0;
+  size_t k = min_element(polygon.begin(), polygon.end()) - polygon.begin();
+  // Os vizinhos do extremo só são colineares com ele se o polígono voltar sobre si mesmo
+  return orient2d(polygon[(k + n - 1) % n], polygon[k], polygon[(k + 1) % n]);
+}
+
+/**
+ * Mesmo que polygonOrientation, para uma face dada por índices em coords
+ */
+int polygonOrientation(const vector<pair<int, int>> &coords, const FaceView &face);
+
+/**
+ * Ponto no segmento fechado ab (exato)
+ */
+template <class Coord>
+inline bool pointOnSegment(const pair<Coord, Coord> &a, const pair<Coord, Coord> &b, const pair<Coord, Coord> &p) {
+  return orient2d(a, b, p) == 0 && p.first >= min(a.first, b.first) && p.first <= max(a.first, b.first) &&
+         p.second >= min(a.second, b.second) && p.second <= max(a.second, b.second);
+}
+
+enum PredicateLevel { PREDICATES_SCALAR, PREDICATES_SSE4, PREDICATES_AVX2 };
+
+enum PointClass { POINT_OUTSIDE, POINT_INSIDE, POINT_ON_BORDER };
+
+// Polígono em SoA com o primeiro vértice repetido no fim, para que a aresta i
+// seja sempre (i, i+1) sem módulo
+struct PolygonSoA {
+  vector<int> xs, ys;
+
+  void assign(const vector<pair<int, int>> &polygon);
+  void assign(const vector<pair<int, int>> &coords, const FaceView &face);
+  size_t size() const { return xs.empty() ? 0 : xs.size() - 1; }
+};
+
+/**
+ * Melhor nível suportado pela CPU
+ */
+PredicateLevel detectPredicateLevel();
+
+/**
+ * Nível em uso (na primeira chamada, o detectado)
+ */
+PredicateLevel predicateLevel();
+
+/**
+ * Força um nível (limitado ao suportado pela CPU); usado nos testes diferenciais
+ * @return Nível efetivamente selecionado
+ */
+PredicateLevel setPredicateLevel(PredicateLevel level);
+
+const char *predicateLevelName(PredicateLevel level);
+
+/**
+ * Classifica o ponto em relação ao polígono, em uma passada
+ * Equivale a isPointOnPolygonBorder ? borda : (isPointInsidePolygon ? dentro : fora)
+ */
+PointClass classifyPoint(const pair<int, int> &pt, const PolygonSoA &polygon);
+
+/**
+ * Equivalente em lote de isPointOnPolygonBorder
+ */
+bool pointOnBorder(const pair<int, int> &pt, const PolygonSoA &polygon);
+
+/**
+ * Equivalente em lote de isPointInsidePolygon
+ */
+bool pointInside(const pair<int, int> &pt, const PolygonSoA &polygon);
+
+#endif // PREDICATES_HPP
@@ -0,0 +1,131 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "reorder.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+using namespace std;
+
+// ======================================================================================================================= //
+
+uint64_t hilbertKey(uint32_t x, uint32_t y) {
+  // Desce os quadrantes do maior para o menor, girando/refletindo o sub-quadrado
+  // para que a curva de cada nível comece onde a do nível anterior termina
+  uint64_t d = 0;
+  for (uint32_t s = 1u << 31; s > 0; s >>= 1) {
+    uint32_t rx = (x & s) ? 1 : 0;
+    uint32_t ry = (y & s) ? 1 : 0;
+    d += uint64_t(s) * s * ((3 * rx) ^ ry);
+    if (ry == 0) {
+      if (rx == 1) {
+        x = ~x;
+        y = ~y;
+      }
+      swap(x, y);
+    }
+  }
+  return d;
+}
+
+// ======================================================================================================================= //
+
+// Espalha os 32 bits de v nas posições pares de um inteiro de 64 bits
+static uint64_t spreadBits(uint32_t v) {
+  uint64_t b = v;
+  b = (b | (b << 16)) & 0x0000FFFF0000FFFFull;
+  b = (b | (b << 8)) & 0x00FF00FF00FF00FFull;
+  b = (b | (b << 4)) & 0x0F0F0F0F0F0F0F0Full;
+  b = (b | (b << 2)) & 0x3333333333333333ull;
+  b = (b | (b << 1)) & 0x5555555555555555ull;
+  return b;
+}
+
+uint64_t mortonKey(uint32_t x, uint32_t y) { return (spreadBits(y) << 1) | spreadBits(x); }
+
+// ======================================================================================================================= //
+
+bool parseSpaceFillingCurve(const string &name, SpaceFillingCurve &curve) {
+  if (name == "hilbert") {
+    curve = CURVE_HILBERT;
+  } else if (name == "morton") {
+    curve = CURVE_MORTON;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// ======================================================================================================================= //
+
+// Ordena os índices 0..n-1 pela chave; empates ficam na ordem da entrada
+static void sortByKey(vector<pair<uint64_t, uint32_t>> &keys, vector<uint32_t> &order) {
+  sort(keys.begin(), keys.end());
+  order.resize(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) order[i] = keys[i].second;
+}
+
+void spatialOrder(const vector<pair<int, int>> &verticesCoords, const FaceList &faces, SpaceFillingCurve curve,
+                  MeshOrder &order) {
+  auto key = curve == CURVE_HILBERT ? hilbertKey : mortonKey;
+
+  // Coordenadas deslocadas para o canto inferior esquerdo: cabem em 32 bits sem sinal
+  long long minX = INT_MAX, minY = INT_MAX;
+  for (const auto &v : verticesCoords) {
+    minX = min<long long>(minX, v.first);
+    minY = min<long long>(minY, v.second);
+  }
+
+  vector<pair<uint64_t, uint32_t>> keys(verticesCoords.size());
+  for (size_t i = 0; i < verticesCoords.size(); i++) {
+    keys[i] = {key(uint32_t(verticesCoords[i].first - minX), uint32_t(verticesCoords[i].second - minY)), uint32_t(i)};
+  }
+  sortByKey(keys, order.vertexInput);
+
+  // Faces pelo centro do retângulo envolvente
+  keys.resize(faces.size());
+  for (size_t f = 0; f < faces.size(); f++) {
+    if (faces[f].empty()) {
+      keys[f] = {0, uint32_t(f)};
+      continue;
+    }
+    long long loX = LLONG_MAX, loY = LLONG_MAX, hiX = LLONG_MIN, hiY = LLONG_MIN;
+    for (int v : faces[f]) {
+      loX = min<long long>(loX, verticesCoords[v].first);
+      hiX = max<long long>(hiX, verticesCoords[v].first);
+      loY = min<long long>(loY, verticesCoords[v].second);
+      hiY = max<long long>(hiY, verticesCoords[v].second);
+    }
+    keys[f] = {key(uint32_t((loX + hiX) / 2 - minX), uint32_t((loY + hiY) / 2 - minY)), uint32_t(f)};
+  }
+  sortByKey(keys, order.faceInput);
+}
+
+// ======================================================================================================================= //
+
+void reorderMesh(const vector<pair<int, int>> &verticesCoords, const FaceList &faces, const MeshOrder &order,
+                 Mesh &out) {
+  size_t n = verticesCoords.size();
+  vector<int> position(n); // índice na entrada -> posição nova
+  out.vertices.resize(n);
+  for (size_t i = 0; i < n; i++) {
+    position[order.vertexInput[i]] = int(i);
+    out.vertices[i] = verticesCoords[order.vertexInput[i]];
+  }
+
+  out.faces = FaceList();
+  out.faces.reserve(faces.size(), faces.totalIndices());
+  for (uint32_t f : order.faceInput) {
+    for (int v : faces[f]) out.faces.push(position[v]);
+    out.faces.closeFace();
+  }
+}
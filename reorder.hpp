@@ -0,0 +1,78 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef REORDER_HPP
+#define REORDER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mesh.hpp"
+
+using namespace std;
+
+// Reordenação da malha ao longo de uma curva que preenche o plano. Na ordem
+// da entrada, vértices próximos no plano podem estar longe na memória, e as
+// semi-arestas de faces vizinhas (gêmeas) também. Ordenar os vértices pela
+// chave de Hilbert (ou de Morton) das suas coordenadas e as faces pela chave
+// do centro do seu retângulo envolvente aproxima na memória o que é próximo
+// no plano. Como as semi-arestas são criadas face a face, gêmeas e vizinhas
+// ficam próximas também.
+//
+// A reordenação só renumera: cada face mantém o ciclo e o vértice inicial,
+// e MeshOrder guarda a permutação para voltar à numeração da entrada.
+
+enum SpaceFillingCurve { CURVE_HILBERT, CURVE_MORTON };
+
+// Permutações da reordenação: posição nova -> índice na entrada
+struct MeshOrder {
+  vector<uint32_t> vertexInput;
+  vector<uint32_t> faceInput;
+};
+
+/**
+ * Posição de (x, y) na curva de Hilbert de ordem 32 (grade 2^32 x 2^32)
+ */
+uint64_t hilbertKey(uint32_t x, uint32_t y);
+
+/**
+ * Posição de (x, y) na curva de Morton (bits de x e y intercalados)
+ */
+uint64_t mortonKey(uint32_t x, uint32_t y);
+
+/**
+ * Converte o nome da curva ("hilbert" ou "morton")
+ * @return false se o nome não for reconhecido
+ */
+bool parseSpaceFillingCurve(const string &name, SpaceFillingCurve &curve);
+
+/**
+ * Calcula a ordem dos vértices e das faces ao longo da curva
+ * @param verticesCoords Vetor de coordenadas (x,y) dos vértices, na ordem da entrada
+ * @param faces Faces (CSR) na ordem da entrada, com índices válidos
+ * @param curve Curva usada para as chaves
+ * @param order Saída: permutações (posição nova -> índice na entrada)
+ */
+void spatialOrder(const vector<pair<int, int>> &verticesCoords, const FaceList &faces, SpaceFillingCurve curve,
+                  MeshOrder &order);
+
+/**
+ * Renumera a malha segundo order: os vértices e as faces vão para as novas
+ * posições e os índices das faces passam a apontar para os vértices renumerados
+ * @param verticesCoords Vetor de coordenadas (x,y) dos vértices, na ordem da entrada
+ * @param faces Faces (CSR) na ordem da entrada, com índices válidos
+ * @param order Permutações de spatialOrder
+ * @param out Saída: malha reordenada
+ */
+void reorderMesh(const vector<pair<int, int>> &verticesCoords, const FaceList &faces, const MeshOrder &order,
+                 Mesh &out);
+
+#endif // REORDER_HPP
@@ -5,6 +5,7 @@ TEST_DIR="tests/inputs"
 OUTPUT_DIR="tests/outputs"
 VERBOSE=""
 PRINT_STDOUT=false
+CHECK=false
 
 # Verifica as flags passadas
 while [[ $# -gt 0 ]]; do
@@ -17,8 +18,12 @@ while [[ $# -gt 0 ]]; do
       PRINT_STDOUT=true
       shift
       ;;
+    -c)
+      CHECK=true
+      shift
+      ;;
     *)
-      echo "Uso: $0 [-v] [-o]"
+      echo "Uso: $0 [-v] [-o] [-c]"
       exit 1
       ;;
   esac
@@ -30,9 +35,189 @@ if [[ ! -x ./malha ]]; then
   exit 1
 fi
 
+# Com -c, compara as saídas de cada modo com as esperadas, sem sobrescrevê-las,
+# e termina com erro se alguma diferir
+if $CHECK; then
+  FAILURES=0
+  TMP=$(mktemp -d)
+  trap 'rm -rf "$TMP"' EXIT
+
+  # confere nome esperado obtido: compara dois arquivos e conta a falha
+  confere() {
+    if ! cmp -s "$2" "$3"; then
+      echo "FALHA: $1"
+      FAILURES=$((FAILURES + 1))
+    fi
+  }
+
+  # recusa nome arquivo_err comando...: o comando deve falhar sem nada no stdout,
+  # com a mensagem esperada no stderr
+  recusa() {
+    local name="$1" expected_err="$2"
+    shift 2
+    if "$@" > "$TMP/out" 2> "$TMP/err" || [[ -s "$TMP/out" ]]; then
+      echo "FALHA: $name (não foi recusado)"
+      FAILURES=$((FAILURES + 1))
+    else
+      confere "$name (stderr)" "$expected_err" "$TMP/err"
+    fi
+  }
+
+  # Modo padrão: uma malha por processo
+  for test_file in "$TEST_DIR"/*.in; do
+    test_name=$(basename "$test_file" .in)
+    ./malha < "$test_file" > "$TMP/out" 2> /dev/null
+    confere "$test_name" "$OUTPUT_DIR/$test_name.out" "$TMP/out"
+  done
+
+  # DCEL compacta (--soa): a mesma saída da DCEL de ponteiros, válidas e inválidas
+  for test_file in "$TEST_DIR"/*.in; do
+    test_name=$(basename "$test_file" .in)
+    ./malha --soa < "$test_file" > "$TMP/out" 2> /dev/null
+    confere "$test_name (--soa)" "$OUTPUT_DIR/$test_name.out" "$TMP/out"
+  done
+
+  # Reordenação (--reorder): a DCEL é construída ao longo da curva, mas a saída
+  # volta à numeração da entrada e tem de ser a mesma; curva desconhecida é recusada
+  for curve in hilbert morton; do
+    for test_file in "$TEST_DIR"/*.in; do
+      test_name=$(basename "$test_file" .in)
+      ./malha --reorder "$curve" < "$test_file" > "$TMP/out" 2> /dev/null
+      confere "$test_name (--reorder $curve)" "$OUTPUT_DIR/$test_name.out" "$TMP/out"
+    done
+  done
+  recusa "--reorder desconhecida" tests/reorder/curva.err ./malha --reorder peano < "$TEST_DIR/correta1.in"
+
+  # Lote (--batch): todas as entradas num processo, em --out-dir com e sem -j,
+  # e no stdout, cada saída depois de "==> nome <=="; termina com erro se
+  # alguma malha for inválida
+  for threads in 1 4; do
+    mkdir -p "$TMP/batch$threads"
+    if ./malha --batch -j "$threads" --out-dir "$TMP/batch$threads" "$TEST_DIR" 2> /dev/null; then
+      echo "FALHA: --batch -j $threads (terminou sem erro com malhas inválidas)"
+      FAILURES=$((FAILURES + 1))
+    fi
+    for test_file in "$TEST_DIR"/*.in; do
+      test_name=$(basename "$test_file" .in)
+      confere "$test_name (--batch -j $threads)" "$OUTPUT_DIR/$test_name.out" "$TMP/batch$threads/$test_name.out"
+    done
+  done
+  for test_name in correta1 aberta1; do
+    echo "==> $test_name <=="
+    cat "$OUTPUT_DIR/$test_name.out"
+  done > "$TMP/expected"
+  ./malha --batch "$TEST_DIR/correta1.in" "$TEST_DIR/aberta1.in" > "$TMP/out" 2> /dev/null
+  confere "correta1 aberta1 (--batch)" "$TMP/expected" "$TMP/out"
+
+  # Validação paralela (-j N): a mesma saída da execução sequencial, inclusive nas
+  # malhas inválidas (superposta8 tem uma face de área zero, que o sequencial
+  # recusa pela varredura antes de checkInside)
+  for test_file in "$TEST_DIR"/*.in; do
+    test_name=$(basename "$test_file" .in)
+    ./malha < "$test_file" > "$TMP/serial" 2> /dev/null
+    for threads in 2 8; do
+      ./malha -j "$threads" < "$test_file" > "$TMP/out" 2> /dev/null
+      confere "$test_name (-j $threads)" "$TMP/serial" "$TMP/out"
+    done
+
+    # Construção paralela de cada instanciação: BasicDCEL<int32_t, uint32_t> (padrão)
+    # e BasicCompactDCEL<int32_t, uint32_t>, na ordem da entrada e reordenada
+    for layout in --soa "--reorder hilbert"; do
+      ./malha $layout -j 4 < "$test_file" > "$TMP/out" 2> /dev/null
+      confere "$test_name ($layout -j 4)" "$OUTPUT_DIR/$test_name.out" "$TMP/out"
+    done
+  done
+
+  # Ida e volta pelo formato binário: --save-bin e --load-bin reproduzem a saída
+  # das malhas válidas; arquivos truncados ou corrompidos são recusados
+  for test_file in "$TEST_DIR"/*.in; do
+    test_name=$(basename "$test_file" .in)
+    ./malha < "$test_file" > /dev/null 2>&1 || continue
+    ./malha --save-bin "$TMP/$test_name.bin" < "$test_file" > "$TMP/out" 2> /dev/null
+    confere "$test_name (--save-bin)" "$OUTPUT_DIR/$test_name.out" "$TMP/out"
+    ./malha --load-bin "$TMP/$test_name.bin" > "$TMP/out" 2> /dev/null
+    confere "$test_name (--load-bin)" "$OUTPUT_DIR/$test_name.out" "$TMP/out"
+  done
+  for bin_file in tests/binary/*.bin; do
+    if [[ -f "${bin_file%.bin}.err" ]]; then
+      recusa "$bin_file" "${bin_file%.bin}.err" ./malha --load-bin "$bin_file"
+    else
+      # Arquivo de versão anterior (nome_vN.bin): reproduz a saída da entrada de mesmo nome
+      test_name=$(basename "$bin_file" .bin)
+      ./malha --load-bin "$bin_file" > "$TMP/out" 2> /dev/null
+      confere "$bin_file" "$OUTPUT_DIR/${test_name%_v*}.out" "$TMP/out"
+    fi
+  done
+
+  # Fora de memória: sem --skip-geometry toda malha é recusada. Com ela, as malhas
+  # válidas e as topologicamente inválidas saem como no modo padrão e as de mais de
+  # um componente (stream/nome.err) são recusadas; as superpostas não são
+  # verificadas nesse modo. correta6 (gravata: dois triângulos com um vértice em
+  # comum) é conexa e sai como no modo padrão
+  for test_file in "$TEST_DIR"/*.in; do
+    test_name=$(basename "$test_file" .in)
+    expected="$OUTPUT_DIR/$test_name.out"
+    recusa "$test_name (--stream)" tests/stream/recusada.err ./malha --stream < "$test_file"
+
+    read -r first < "$expected"
+    if [[ "$first" == superposta ]]; then
+      continue
+    elif [[ -f "tests/stream/$test_name.err" ]]; then
+      recusa "$test_name (--stream --skip-geometry)" "tests/stream/$test_name.err" \
+        ./malha --stream --skip-geometry < "$test_file"
+    else
+      ./malha --stream --skip-geometry < "$test_file" > "$TMP/out" 2> "$TMP/err"
+      confere "$test_name (--stream --skip-geometry)" "$expected" "$TMP/out"
+      confere "$test_name (--stream --skip-geometry, stderr)" tests/stream/aviso.err "$TMP/err"
+    fi
+  done
+
+  # Localização: locate/nome.pts são consultas sobre inputs/nome.in (pontos em
+  # vértices, em arestas, no interior de faces, em buracos e fora da malha)
+  for points_file in tests/locate/*.pts; do
+    test_name=$(basename "$points_file" .pts)
+    ./malha --locate "$points_file" < "$TEST_DIR/$test_name.in" > "$TMP/out" 2> /dev/null
+    confere "$test_name (--locate)" "tests/locate/$test_name.out" "$TMP/out"
+  done
+
+  # Edição: edit/nome.edit aplicado a edit/nome.in; as recusas vão para o stderr
+  # (edit/nome.err) e a DCEL impressa deve sair como se elas não existissem
+  for edit_file in tests/edit/*.edit; do
+    test_name=$(basename "$edit_file" .edit)
+    ./malha --edit "$edit_file" < "tests/edit/$test_name.in" > "$TMP/out" 2> "$TMP/err"
+    confere "$test_name (--edit)" "tests/edit/$test_name.out" "$TMP/out"
+    confere "$test_name (--edit, stderr)" "tests/edit/$test_name.err" "$TMP/err"
+  done
+
+  # Sobreposição: overlay/nome_a.in sobre overlay/nome_b.in (disjuntas, aninhadas,
+  # com um lado em comum, cruzadas e com buraco); cada face traz os buracos e as
+  # faces de origem
+  for first in tests/overlay/*_a.in; do
+    test_name=$(basename "$first" _a.in)
+    ./malha --overlay "tests/overlay/${test_name}_b.in" < "$first" > "$TMP/out" 2> /dev/null
+    confere "$test_name (--overlay)" "tests/overlay/$test_name.out" "$TMP/out"
+  done
+
+  echo "$FAILURES falha(s)"
+  [[ $FAILURES -eq 0 ]]
+  exit
+fi
+
 # Cria a pasta de saída se necessário
 mkdir -p "$OUTPUT_DIR"
 
+# Sem -v, todas as malhas são processadas num único processo (--batch);
+# com -v, um ./malha por arquivo, para que a depuração de cada malha saia separada
+if [[ -z "$VERBOSE" ]]; then
+  if $PRINT_STDOUT; then
+    ./malha --batch "$TEST_DIR"
+  else
+    ./malha --batch --out-dir "$OUTPUT_DIR" "$TEST_DIR"
+    echo "Saídas escritas em: $OUTPUT_DIR"
+  fi
+  exit 0
+fi
+
 # Loop por todos os arquivos .in na pasta de testes
 for test_file in "$TEST_DIR"/*.in; do
   test_name=$(basename "$test_file" .in)
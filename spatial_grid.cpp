@@ -0,0 +1,101 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "spatial_grid.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+using namespace std;
+
+// ======================================================================================================================= //
+
+PointGrid::PointGrid(const vector<pair<int, int>> &points) : pts(&points) {
+  if (points.empty()) return;
+
+  long long minX = LLONG_MAX, minY = LLONG_MAX, maxX = LLONG_MIN, maxY = LLONG_MIN;
+  for (const auto &p : points) {
+    minX = min<long long>(minX, p.first);
+    maxX = max<long long>(maxX, p.first);
+    minY = min<long long>(minY, p.second);
+    maxY = max<long long>(maxY, p.second);
+  }
+
+  // Aproximadamente sqrt(n) x sqrt(n) células
+  long long side = max(1LL, static_cast<long long>(sqrt(static_cast<double>(points.size()))));
+  originX = minX;
+  originY = minY;
+  cellW = max(1LL, (maxX - minX) / side + 1);
+  cellH = max(1LL, (maxY - minY) / side + 1);
+  cols = (maxX - minX) / cellW + 1;
+  rows = (maxY - minY) / cellH + 1;
+
+  // Contagem por célula e prefixo (counting sort estável, mantém índices crescentes)
+  cellStart.assign(cols * rows + 1, 0);
+  for (const auto &p : points) {
+    cellStart[cellY(p.second) * cols + cellX(p.first) + 1]++;
+  }
+  for (size_t c = 1; c < cellStart.size(); c++) {
+    cellStart[c] += cellStart[c - 1];
+  }
+
+  cellItems.resize(points.size());
+  vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+  for (size_t i = 0; i < points.size(); i++) {
+    const auto &p = points[i];
+    cellItems[fill[cellY(p.second) * cols + cellX(p.first)]++] = i;
+  }
+}
+
+// ======================================================================================================================= //
+
+long long PointGrid::cellX(long long x) const {
+  return min(cols - 1, max(0LL, (x - originX) / cellW));
+}
+
+long long PointGrid::cellY(long long y) const {
+  return min(rows - 1, max(0LL, (y - originY) / cellH));
+}
+
+// ======================================================================================================================= //
+
+void PointGrid::query(const BoundingBox &box, vector<int> &out) const {
+  out.clear();
+  if (cellItems.empty()) return;
+
+  long long x0 = cellX(box.minX), x1 = cellX(box.maxX);
+  long long y0 = cellY(box.minY), y1 = cellY(box.maxY);
+
+  for (long long cy = y0; cy <= y1; cy++) {
+    for (long long cx = x0; cx <= x1; cx++) {
+      long long c = cy * cols + cx;
+      for (int k = cellStart[c]; k < cellStart[c + 1]; k++) {
+        int i = cellItems[k];
+        if (box.contains((*pts)[i])) out.push_back(i);
+      }
+    }
+  }
+  sort(out.begin(), out.end());
+}
+
+// ======================================================================================================================= //
+
+BoundingBox faceBoundingBox(const vector<pair<int, int>> &verticesCoords, const FaceView &face) {
+  BoundingBox box{LLONG_MAX, LLONG_MAX, LLONG_MIN, LLONG_MIN};
+  for (int idx : face) {
+    const auto &p = verticesCoords[idx];
+    box.minX = min<long long>(box.minX, p.first);
+    box.maxX = max<long long>(box.maxX, p.first);
+    box.minY = min<long long>(box.minY, p.second);
+    box.maxY = max<long long>(box.maxY, p.second);
+  }
+  return box;
+}
@@ -0,0 +1,162 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef SPATIAL_GRID_HPP
+#define SPATIAL_GRID_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "mesh.hpp"
+
+using namespace std;
+
+// Retângulo alinhado aos eixos (limites inclusivos)
+struct BoundingBox {
+  long long minX, minY, maxX, maxY;
+
+  bool contains(const pair<int, int> &p) const {
+    return p.first >= minX && p.first <= maxX && p.second >= minY && p.second <= maxY;
+  }
+};
+
+// ---------- Classe PointGrid ----------
+// Grade uniforme sobre um conjunto de pontos, construída uma vez em O(n).
+// Cada ponto cai em exatamente uma célula; as células guardam os índices
+// em formato CSR (offsets + índices), sem alocação por célula.
+class PointGrid {
+public:
+  PointGrid() = default;
+
+  /**
+   * Constrói a grade com aproximadamente um ponto por célula
+   * @param points Coordenadas dos pontos (a grade guarda só os índices)
+   */
+  explicit PointGrid(const vector<pair<int, int>> &points);
+
+  /**
+   * Lista os pontos dentro do retângulo, em ordem crescente de índice
+   * @param box Retângulo de consulta (limites inclusivos)
+   * @param out Vetor de saída (é sobrescrito)
+   */
+  void query(const BoundingBox &box, vector<int> &out) const;
+
+private:
+  long long originX = 0, originY = 0;
+  long long cellW = 1, cellH = 1;
+  long long cols = 0, rows = 0;
+  vector<int> cellStart; // offsets das células em cellItems (cols*rows + 1)
+  vector<int> cellItems; // índices dos pontos agrupados por célula
+  const vector<pair<int, int>> *pts = nullptr;
+
+  long long cellX(long long x) const;
+  long long cellY(long long y) const;
+};
+
+// ---------- Classe BucketGrid ----------
+// Versão dinâmica da grade: cada célula é um balde com os itens cujo
+// retângulo a cobre, e itens podem ser inseridos e removidos a qualquer
+// momento. Os limites são fixados na construção; coordenadas fora deles caem
+// nas células da borda, então tudo continua sendo encontrado.
+template <class T>
+class BucketGrid {
+public:
+  BucketGrid() = default;
+
+  /**
+   * @param bounds Região coberta pela grade
+   * @param expectedItems Número esperado de itens (aproximadamente um por célula)
+   */
+  BucketGrid(const BoundingBox &bounds, size_t expectedItems) {
+    long long side = max(1LL, static_cast<long long>(sqrt(static_cast<double>(max<size_t>(expectedItems, 1)))));
+    originX = bounds.minX;
+    originY = bounds.minY;
+    cellW = max(1LL, (bounds.maxX - bounds.minX) / side + 1);
+    cellH = max(1LL, (bounds.maxY - bounds.minY) / side + 1);
+    cols = (bounds.maxX - bounds.minX) / cellW + 1;
+    rows = (bounds.maxY - bounds.minY) / cellH + 1;
+    cells.assign(cols * rows, {});
+  }
+
+  void insert(const T &item, const BoundingBox &box) {
+    forEachCell(box, [&](size_t c) { cells[c].push_back(item); });
+  }
+
+  /**
+   * Remove o item de todas as células do retângulo (o mesmo usado na inserção)
+   */
+  void erase(const T &item, const BoundingBox &box) {
+    forEachCell(box, [&](size_t c) {
+      vector<T> &cell = cells[c];
+      auto it = find(cell.begin(), cell.end(), item);
+      if (it != cell.end()) {
+        *it = cell.back();
+        cell.pop_back();
+      }
+    });
+  }
+
+  /**
+   * Itens cujas células tocam o retângulo, sem repetição (pode incluir itens
+   * que não o intersectam: o teste exato fica com quem consulta)
+   */
+  void query(const BoundingBox &box, vector<T> &out) const {
+    out.clear();
+    forEachCell(box, [&](size_t c) { out.insert(out.end(), cells[c].begin(), cells[c].end()); });
+    sort(out.begin(), out.end());
+    out.erase(unique(out.begin(), out.end()), out.end());
+  }
+
+  /**
+   * Percorre as células da coluna de x, da linha de y para baixo
+   * @param visit Função (itens da célula, menor y coberto pela linha) que devolve false para parar
+   */
+  template <class Fn>
+  void scanDown(long long x, long long y, Fn &&visit) const {
+    if (cells.empty()) return;
+    long long cx = cellX(x);
+    for (long long cy = cellY(y); cy >= 0; cy--) {
+      long long bottom = cy == 0 ? LLONG_MIN : originY + cy * cellH;
+      if (!visit(cells[cy * cols + cx], bottom)) return;
+    }
+  }
+
+private:
+  long long originX = 0, originY = 0;
+  long long cellW = 1, cellH = 1;
+  long long cols = 0, rows = 0;
+  vector<vector<T>> cells;
+
+  long long cellX(long long x) const { return min(cols - 1, max(0LL, (x - originX) / cellW)); }
+  long long cellY(long long y) const { return min(rows - 1, max(0LL, (y - originY) / cellH)); }
+
+  template <class Fn>
+  void forEachCell(const BoundingBox &box, Fn &&fn) const {
+    if (cells.empty()) return;
+    for (long long cy = cellY(box.minY); cy <= cellY(box.maxY); cy++) {
+      for (long long cx = cellX(box.minX); cx <= cellX(box.maxX); cx++) {
+        fn(static_cast<size_t>(cy * cols + cx));
+      }
+    }
+  }
+};
+
+/**
+ * Calcula o retângulo envolvente de uma face
+ * @param verticesCoords Vetor de coordenadas dos vértices
+ * @param face Índices dos vértices da face
+ * @return Retângulo envolvente
+ */
+BoundingBox faceBoundingBox(const vector<pair<int, int>> &verticesCoords, const FaceView &face);
+
+#endif // SPATIAL_GRID_HPP
@@ -0,0 +1,359 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "spatial_index.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <climits>
+
+using namespace std;
+
+// Consultas por lote: cada uma custa algumas dezenas de nós, blocos menores que os da localização
+static const size_t QUERY_GRAIN = 256;
+
+// ======================================================================================================================= //
+
+// Ordem dos vizinhos: menor distância, depois menor índice
+static bool closer(const Neighbor &a, const Neighbor &b) {
+  return a.dist2 < b.dist2 || (a.dist2 == b.dist2 && a.index < b.index);
+}
+
+// Mantém em heap (máximo no topo) os k mais próximos vistos até agora
+static void offer(vector<Neighbor> &heap, size_t k, const Neighbor &candidate) {
+  if (heap.size() < k) {
+    heap.push_back(candidate);
+    push_heap(heap.begin(), heap.end(), closer);
+  } else if (closer(candidate, heap.front())) {
+    pop_heap(heap.begin(), heap.end(), closer);
+    heap.back() = candidate;
+    push_heap(heap.begin(), heap.end(), closer);
+  }
+}
+
+// Ainda vale visitar algo a essa distância? (empates podem trazer índices menores)
+static bool worthVisiting(const vector<Neighbor> &heap, size_t k, double dist2) {
+  return heap.size() < k || dist2 <= heap.front().dist2;
+}
+
+// Distância ao quadrado do ponto ao retângulo (0 se dentro)
+static double boxDist2(double px, double py, double minX, double minY, double maxX, double maxY) {
+  double dx = px < minX ? minX - px : (px > maxX ? px - maxX : 0);
+  double dy = py < minY ? minY - py : (py > maxY ? py - maxY : 0);
+  return dx * dx + dy * dy;
+}
+
+// Distância ao quadrado do ponto ao segmento ab
+static double segmentDist2(double px, double py, double ax, double ay, double bx, double by) {
+  double dx = bx - ax, dy = by - ay;
+  double len2 = dx * dx + dy * dy;
+  double t = len2 > 0 ? ((px - ax) * dx + (py - ay) * dy) / len2 : 0;
+  t = min(1.0, max(0.0, t));
+  double qx = ax + t * dx - px, qy = ay + t * dy - py;
+  return qx * qx + qy * qy;
+}
+
+// ---------- Classe EdgeBVH ----------
+
+EdgeBVH::EdgeBVH(const CompactDCEL &dcel) {
+  edges.reserve(dcel.numHalfEdges() / 2 + 1);
+  for (CompactDCEL::index_t h = 0; h < dcel.numHalfEdges(); ++h) {
+    CompactDCEL::index_t t = dcel.twin[h];
+    if (t != CompactDCEL::NIL && t < h) continue;
+    CompactDCEL::index_t u = dcel.origin[h], v = dcel.origin[dcel.next[h]];
+    int twinFace = t != CompactDCEL::NIL ? static_cast<int>(dcel.face[t]) : -1;
+    edges.push_back(Edge{dcel.vx[u], dcel.vy[u], dcel.vx[v], dcel.vy[v], static_cast<int>(h),
+                         static_cast<int>(dcel.face[h]), twinFace});
+  }
+  build();
+}
+
+EdgeBVH::EdgeBVH(const DCEL &dcel) {
+  edges.reserve(dcel.halfEdges.size() / 2 + 1);
+  for (const HalfEdge *he : dcel.halfEdges) {
+    if (he->twin && he->twin->id < he->id) continue;
+    const Vertex *u = he->origin, *v = he->next->origin;
+    int twinFace = he->twin ? static_cast<int>(he->twin->incidentFace->id) : -1;
+    edges.push_back(Edge{static_cast<int>(u->x), static_cast<int>(u->y), static_cast<int>(v->x),
+                         static_cast<int>(v->y), static_cast<int>(he->id), static_cast<int>(he->incidentFace->id),
+                         twinFace});
+  }
+  build();
+}
+
+// ======================================================================================================================= //
+
+void EdgeBVH::build() {
+  nodes.clear();
+  nodes.reserve(2 * (edges.size() / LEAF_SIZE + 1));
+  if (!edges.empty()) buildNode(0, edges.size());
+}
+
+int EdgeBVH::buildNode(int lo, int hi) {
+  int id = nodes.size();
+  Node node{INT_MAX, INT_MAX, INT_MIN, INT_MIN, lo, hi - lo};
+
+  // Retângulo das arestas e dos pontos médios (em dobro, para ficar inteiro)
+  long long cMinX = LLONG_MAX, cMinY = LLONG_MAX, cMaxX = LLONG_MIN, cMaxY = LLONG_MIN;
+  for (int i = lo; i < hi; ++i) {
+    const Edge &e = edges[i];
+    node.minX = min({node.minX, e.ax, e.bx});
+    node.minY = min({node.minY, e.ay, e.by});
+    node.maxX = max({node.maxX, e.ax, e.bx});
+    node.maxY = max({node.maxY, e.ay, e.by});
+    long long cx = (long long)e.ax + e.bx, cy = (long long)e.ay + e.by;
+    cMinX = min(cMinX, cx);
+    cMinY = min(cMinY, cy);
+    cMaxX = max(cMaxX, cx);
+    cMaxY = max(cMaxY, cy);
+  }
+  nodes.push_back(node);
+  if (hi - lo <= LEAF_SIZE) return id;
+
+  // Mediana dos pontos médios no eixo mais longo
+  bool byX = cMaxX - cMinX >= cMaxY - cMinY;
+  int mid = lo + (hi - lo) / 2;
+  nth_element(edges.begin() + lo, edges.begin() + mid, edges.begin() + hi, [byX](const Edge &a, const Edge &b) {
+    return byX ? (long long)a.ax + a.bx < (long long)b.ax + b.bx : (long long)a.ay + a.by < (long long)b.ay + b.by;
+  });
+  buildNode(lo, mid);
+  int right = buildNode(mid, hi);
+  nodes[id].first = right;
+  nodes[id].count = 0;
+  return id;
+}
+
+// ======================================================================================================================= //
+
+// Segmento e retângulo se tocam: os retângulos envolventes se sobrepõem e os
+// quatro cantos não ficam todos estritamente do mesmo lado da reta do segmento
+static bool segmentTouchesBox(long long ax, long long ay, long long bx, long long by, const BoundingBox &box) {
+  if (max(ax, bx) < box.minX || min(ax, bx) > box.maxX || max(ay, by) < box.minY || min(ay, by) > box.maxY) {
+    return false;
+  }
+  int s1 = orient2d(ax, ay, bx, by, box.minX, box.minY);
+  int s2 = orient2d(ax, ay, bx, by, box.maxX, box.minY);
+  int s3 = orient2d(ax, ay, bx, by, box.maxX, box.maxY);
+  int s4 = orient2d(ax, ay, bx, by, box.minX, box.maxY);
+  return !((s1 > 0 && s2 > 0 && s3 > 0 && s4 > 0) || (s1 < 0 && s2 < 0 && s3 < 0 && s4 < 0));
+}
+
+template <class Fn>
+void EdgeBVH::forEachTouching(const BoundingBox &box, Fn &&fn) const {
+  if (nodes.empty()) return;
+  vector<int> stack{0};
+  while (!stack.empty()) {
+    int id = stack.back();
+    const Node &node = nodes[id];
+    stack.pop_back();
+    if (node.maxX < box.minX || node.minX > box.maxX || node.maxY < box.minY || node.minY > box.maxY) continue;
+    if (node.count == 0) {
+      stack.push_back(node.first);
+      stack.push_back(id + 1);
+      continue;
+    }
+    for (int i = node.first; i < node.first + node.count; ++i) {
+      const Edge &e = edges[i];
+      if (segmentTouchesBox(e.ax, e.ay, e.bx, e.by, box)) fn(e);
+    }
+  }
+}
+
+void EdgeBVH::window(const BoundingBox &box, vector<int> &out) const {
+  out.clear();
+  forEachTouching(box, [&](const Edge &e) { out.push_back(e.halfEdge); });
+  sort(out.begin(), out.end());
+}
+
+void EdgeBVH::windowFaces(const BoundingBox &box, const PointLocator &locator, vector<int> &faces) const {
+  faces.clear();
+  forEachTouching(box, [&](const Edge &e) {
+    faces.push_back(e.face);
+    if (e.twinFace >= 0) faces.push_back(e.twinFace);
+  });
+
+  // Sem aresta na janela, ela inteira fica numa só região: a de um canto
+  if (faces.empty()) {
+    pair<int, int> corner(static_cast<int>(max<long long>(INT_MIN, min<long long>(INT_MAX, box.minX))),
+                          static_cast<int>(max<long long>(INT_MIN, min<long long>(INT_MAX, box.minY))));
+    int f = locator.locate(corner);
+    if (f >= 0) faces.push_back(f);
+    return;
+  }
+  sort(faces.begin(), faces.end());
+  faces.erase(unique(faces.begin(), faces.end()), faces.end());
+}
+
+// ======================================================================================================================= //
+
+void EdgeBVH::nearest(const pair<int, int> &pt, size_t k, vector<Neighbor> &out) const {
+  out.clear();
+  if (k == 0 || nodes.empty()) return;
+  double px = pt.first, py = pt.second;
+
+  // Melhor primeiro: o nó de retângulo mais próximo sai antes (heap de mínimo)
+  auto fartherNode = [](const pair<double, int> &a, const pair<double, int> &b) { return a.first > b.first; };
+  auto nodeDist2 = [&](int id) {
+    const Node &n = nodes[id];
+    return boxDist2(px, py, n.minX, n.minY, n.maxX, n.maxY);
+  };
+  vector<pair<double, int>> queue{{nodeDist2(0), 0}};
+  while (!queue.empty()) {
+    pop_heap(queue.begin(), queue.end(), fartherNode);
+    auto [dist2, id] = queue.back();
+    queue.pop_back();
+    if (!worthVisiting(out, k, dist2)) break;
+
+    const Node &node = nodes[id];
+    if (node.count == 0) {
+      for (int child : {id + 1, node.first}) {
+        double d = nodeDist2(child);
+        if (!worthVisiting(out, k, d)) continue;
+        queue.emplace_back(d, child);
+        push_heap(queue.begin(), queue.end(), fartherNode);
+      }
+      continue;
+    }
+    for (int i = node.first; i < node.first + node.count; ++i) {
+      const Edge &e = edges[i];
+      offer(out, k, Neighbor{e.halfEdge, segmentDist2(px, py, e.ax, e.ay, e.bx, e.by)});
+    }
+  }
+  sort_heap(out.begin(), out.end(), closer);
+}
+
+// ======================================================================================================================= //
+
+void EdgeBVH::window(const vector<BoundingBox> &boxes, vector<vector<int>> &out, ThreadPool *pool) const {
+  out.resize(boxes.size());
+  parallelFor(pool, 0, boxes.size(), QUERY_GRAIN, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) window(boxes[i], out[i]);
+  });
+}
+
+void EdgeBVH::nearest(const vector<pair<int, int>> &points, size_t k, vector<vector<Neighbor>> &out,
+                      ThreadPool *pool) const {
+  out.resize(points.size());
+  parallelFor(pool, 0, points.size(), QUERY_GRAIN, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) nearest(points[i], k, out[i]);
+  });
+}
+
+// ---------- Classe VertexKdTree ----------
+
+VertexKdTree::VertexKdTree(const vector<pair<int, int>> &coords) {
+  points.resize(coords.size());
+  for (size_t v = 0; v < coords.size(); ++v) {
+    points[v] = Point{coords[v].first, coords[v].second, static_cast<int>(v)};
+  }
+  build(0, points.size(), 0);
+}
+
+VertexKdTree::VertexKdTree(const CompactDCEL &dcel) {
+  points.resize(dcel.numVertices());
+  for (size_t v = 0; v < points.size(); ++v) {
+    points[v] = Point{dcel.vx[v], dcel.vy[v], static_cast<int>(v)};
+  }
+  build(0, points.size(), 0);
+}
+
+VertexKdTree::VertexKdTree(const DCEL &dcel) {
+  points.resize(dcel.vertices.size());
+  for (size_t v = 0; v < points.size(); ++v) {
+    const Vertex *vertex = dcel.vertices[v];
+    points[v] = Point{static_cast<int>(vertex->x), static_cast<int>(vertex->y), static_cast<int>(vertex->id)};
+  }
+  build(0, points.size(), 0);
+}
+
+// ======================================================================================================================= //
+
+void VertexKdTree::build(int lo, int hi, int axis) {
+  if (hi - lo <= 1) return;
+  int mid = lo + (hi - lo) / 2;
+  nth_element(points.begin() + lo, points.begin() + mid, points.begin() + hi, [axis](const Point &a, const Point &b) {
+    return axis == 0 ? a.x < b.x : a.y < b.y;
+  });
+  build(lo, mid, 1 - axis);
+  build(mid + 1, hi, 1 - axis);
+}
+
+// ======================================================================================================================= //
+
+void VertexKdTree::window(const BoundingBox &box, vector<int> &out) const {
+  out.clear();
+  window(box, 0, points.size(), 0, out);
+  sort(out.begin(), out.end());
+}
+
+void VertexKdTree::window(const BoundingBox &box, int lo, int hi, int axis, vector<int> &out) const {
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    const Point &p = points[mid];
+    if (box.contains({p.x, p.y})) out.push_back(p.index);
+
+    // À esquerda só há coordenadas <= a do meio, à direita só >=
+    long long split = axis == 0 ? p.x : p.y;
+    long long boxMin = axis == 0 ? box.minX : box.minY, boxMax = axis == 0 ? box.maxX : box.maxY;
+    bool left = boxMin <= split, right = boxMax >= split;
+    if (left && right) window(box, lo, mid, 1 - axis, out);
+    if (right) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+    axis = 1 - axis;
+  }
+}
+
+// ======================================================================================================================= //
+
+void VertexKdTree::nearest(const pair<int, int> &pt, size_t k, vector<Neighbor> &out) const {
+  out.clear();
+  if (k == 0) return;
+  nearest(pt, k, 0, points.size(), 0, out);
+  sort_heap(out.begin(), out.end(), closer);
+}
+
+void VertexKdTree::nearest(const pair<int, int> &pt, size_t k, int lo, int hi, int axis,
+                           vector<Neighbor> &heap) const {
+  if (lo >= hi) return;
+  int mid = lo + (hi - lo) / 2;
+  const Point &p = points[mid];
+  double dx = double(pt.first) - p.x, dy = double(pt.second) - p.y;
+  offer(heap, k, Neighbor{p.index, dx * dx + dy * dy});
+
+  // Primeiro o lado do ponto; o outro só se a reta de corte estiver ao alcance
+  double diff = axis == 0 ? dx : dy;
+  if (diff < 0) {
+    nearest(pt, k, lo, mid, 1 - axis, heap);
+    if (worthVisiting(heap, k, diff * diff)) nearest(pt, k, mid + 1, hi, 1 - axis, heap);
+  } else {
+    nearest(pt, k, mid + 1, hi, 1 - axis, heap);
+    if (worthVisiting(heap, k, diff * diff)) nearest(pt, k, lo, mid, 1 - axis, heap);
+  }
+}
+
+// ======================================================================================================================= //
+
+void VertexKdTree::window(const vector<BoundingBox> &boxes, vector<vector<int>> &out, ThreadPool *pool) const {
+  out.resize(boxes.size());
+  parallelFor(pool, 0, boxes.size(), QUERY_GRAIN, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) window(boxes[i], out[i]);
+  });
+}
+
+void VertexKdTree::nearest(const vector<pair<int, int>> &queries, size_t k, vector<vector<Neighbor>> &out,
+                           ThreadPool *pool) const {
+  out.resize(queries.size());
+  parallelFor(pool, 0, queries.size(), QUERY_GRAIN, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) nearest(queries[i], k, out[i]);
+  });
+}
@@ -0,0 +1,187 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef SPATIAL_INDEX_HPP
+#define SPATIAL_INDEX_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "dcel.hpp"
+#include "dcel_soa.hpp"
+#include "point_location.hpp"
+#include "spatial_grid.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+
+// Consultas espaciais sobre uma DCEL construída: janela (tudo o que toca um
+// retângulo) e k vizinhos mais próximos de um ponto, para desenho de mapas e
+// "snap". As arestas ficam numa hierarquia de volumes envolventes (BVH) e os
+// vértices numa árvore k-d; as duas são construídas uma vez, em O(n log n),
+// e não acompanham edições posteriores da DCEL. Os resultados são índices da
+// DCEL (base 0): a aresta não direcionada é representada pela sua semi-aresta
+// de menor índice. Os testes de interseção com a janela são exatos
+// (orient2d); as distâncias dos vizinhos são calculadas em double, com
+// empate desfeito pelo menor índice.
+
+// Vizinho encontrado por nearest: índice na DCEL e distância ao quadrado
+struct Neighbor {
+  int index;
+  double dist2;
+};
+
+// ---------- Classe EdgeBVH ----------
+// BVH binária sobre as arestas não direcionadas. Cada nó divide as arestas
+// pela mediana dos pontos médios no eixo mais longo do seu retângulo, até
+// folhas de no máximo LEAF_SIZE arestas. Os nós ficam num vetor em pré-ordem
+// (o filho esquerdo é o nó seguinte) e as arestas de cada folha ficam
+// contíguas, na ordem da construção.
+class EdgeBVH {
+public:
+  EdgeBVH() = default;
+
+  /**
+   * @param dcel DCEL construída (as coordenadas devem caber em int)
+   */
+  explicit EdgeBVH(const CompactDCEL &dcel);
+  explicit EdgeBVH(const DCEL &dcel);
+
+  /**
+   * Arestas que tocam o retângulo (borda inclusive)
+   * @param box Janela de consulta (limites inclusivos)
+   * @param edges Saída: semi-arestas representantes, em ordem crescente (é sobrescrita)
+   */
+  void window(const BoundingBox &box, vector<int> &edges) const;
+
+  /**
+   * Faces que tocam o retângulo: as dos dois lados das arestas que o tocam
+   * (inclusive a face do ciclo externo) e, se nenhuma aresta o toca, a face
+   * que o contém (nenhuma, na região ilimitada)
+   * @param box Janela de consulta (limites inclusivos)
+   * @param locator Localizador de pontos da mesma DCEL
+   * @param faces Saída: índices das faces, em ordem crescente (é sobrescrita)
+   */
+  void windowFaces(const BoundingBox &box, const PointLocator &locator, vector<int> &faces) const;
+
+  /**
+   * As k arestas mais próximas do ponto (distância ponto-segmento)
+   * @param pt Ponto de consulta
+   * @param k Número de vizinhos
+   * @param out Saída: até k vizinhos, do mais próximo ao mais distante (é sobrescrita)
+   */
+  void nearest(const pair<int, int> &pt, size_t k, vector<Neighbor> &out) const;
+
+  /**
+   * Lote de janelas, dividido entre threads
+   * @param boxes Janelas de consulta
+   * @param edges Saída: uma lista de arestas por janela, na mesma ordem
+   * @param pool Pool para dividir o lote entre threads (pode ser nulo)
+   */
+  void window(const vector<BoundingBox> &boxes, vector<vector<int>> &edges, ThreadPool *pool = nullptr) const;
+
+  /**
+   * Lote de consultas de vizinhos, dividido entre threads
+   * @param points Pontos de consulta
+   * @param k Número de vizinhos por ponto
+   * @param out Saída: uma lista de vizinhos por ponto, na mesma ordem
+   * @param pool Pool para dividir o lote entre threads (pode ser nulo)
+   */
+  void nearest(const vector<pair<int, int>> &points, size_t k, vector<vector<Neighbor>> &out,
+               ThreadPool *pool = nullptr) const;
+
+  size_t size() const { return edges.size(); }
+  size_t nodeCount() const { return nodes.size(); }
+
+private:
+  static constexpr int LEAF_SIZE = 4;
+
+  struct Edge {
+    int ax, ay, bx, by;
+    int halfEdge;
+    int face, twinFace; // -1 se não houver
+  };
+
+  struct Node {
+    int minX, minY, maxX, maxY;
+    int first; // folha: primeira aresta; nó interno: índice do filho direito
+    int count; // folha: número de arestas; nó interno: 0
+  };
+
+  vector<Edge> edges;
+  vector<Node> nodes;
+
+  void build();
+  int buildNode(int lo, int hi);
+
+  // Chama fn(aresta) para cada aresta que toca o retângulo (teste exato)
+  template <class Fn>
+  void forEachTouching(const BoundingBox &box, Fn &&fn) const;
+};
+
+// ---------- Classe VertexKdTree ----------
+// Árvore k-d implícita sobre os vértices: o vetor é permutado de modo que o
+// elemento do meio de cada intervalo seja a mediana no eixo do nível (x nos
+// níveis pares, y nos ímpares), com os menores à esquerda e os maiores à
+// direita. Não há nós nem ponteiros, só o vetor de pontos.
+class VertexKdTree {
+public:
+  VertexKdTree() = default;
+
+  /**
+   * @param coords Coordenadas dos vértices (os índices devolvidos são posições aqui)
+   */
+  explicit VertexKdTree(const vector<pair<int, int>> &coords);
+  explicit VertexKdTree(const CompactDCEL &dcel);
+  explicit VertexKdTree(const DCEL &dcel);
+
+  /**
+   * Vértices dentro do retângulo (borda inclusive)
+   * @param box Janela de consulta (limites inclusivos)
+   * @param vertices Saída: índices dos vértices, em ordem crescente (é sobrescrita)
+   */
+  void window(const BoundingBox &box, vector<int> &vertices) const;
+
+  /**
+   * Os k vértices mais próximos do ponto
+   * @param pt Ponto de consulta
+   * @param k Número de vizinhos
+   * @param out Saída: até k vizinhos, do mais próximo ao mais distante (é sobrescrita)
+   */
+  void nearest(const pair<int, int> &pt, size_t k, vector<Neighbor> &out) const;
+
+  /**
+   * Lote de janelas, dividido entre threads
+   */
+  void window(const vector<BoundingBox> &boxes, vector<vector<int>> &vertices, ThreadPool *pool = nullptr) const;
+
+  /**
+   * Lote de consultas de vizinhos, dividido entre threads
+   */
+  void nearest(const vector<pair<int, int>> &queries, size_t k, vector<vector<Neighbor>> &out,
+               ThreadPool *pool = nullptr) const;
+
+  size_t size() const { return points.size(); }
+
+private:
+  struct Point {
+    int x, y;
+    int index;
+  };
+
+  vector<Point> points;
+
+  void build(int lo, int hi, int axis);
+  void window(const BoundingBox &box, int lo, int hi, int axis, vector<int> &out) const;
+  void nearest(const pair<int, int> &pt, size_t k, int lo, int hi, int axis, vector<Neighbor> &heap) const;
+};
+
+#endif // SPATIAL_INDEX_HPP
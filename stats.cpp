@@ -0,0 +1,88 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "stats.hpp"
+
+#include <memory>
+#include <mutex>
+#include <sys/resource.h>
+#include <vector>
+
+using namespace std;
+
+static const char *PHASE_NAMES[STATS_NUM_PHASES] = {"parse",        "validate_edges", "is_overlapping", "face_attributes",
+                                                    "check_inside", "holes",          "build",          "overlay",
+                                                    "output"};
+static const char *COUNTER_NAMES[STATS_NUM_COUNTERS] = {"segment_tests", "point_in_polygon_tests", "border_tests",
+                                                        "grid_candidates", "map_lookups", "predicate_evaluations",
+                                                        "predicate_fallbacks"};
+
+// Blocos de todas as threads que já registraram algo (vivem até o fim do programa)
+static mutex registryMutex;
+static vector<unique_ptr<StatsBlock>> &registry() {
+  static vector<unique_ptr<StatsBlock>> blocks;
+  return blocks;
+}
+
+// ======================================================================================================================= //
+
+StatsBlock &statsLocal() {
+  thread_local StatsBlock *block = nullptr;
+  if (!block) {
+    lock_guard<mutex> lock(registryMutex);
+    registry().push_back(make_unique<StatsBlock>());
+    block = registry().back().get();
+  }
+  return *block;
+}
+
+// ======================================================================================================================= //
+
+void writeStatsReport(ostream &out) {
+  StatsBlock total;
+  size_t threads = 0;
+  {
+    lock_guard<mutex> lock(registryMutex);
+    threads = registry().size();
+    for (const auto &block : registry()) {
+      for (int p = 0; p < STATS_NUM_PHASES; p++) {
+        total.phaseNanos[p] += block->phaseNanos[p];
+        total.phaseCalls[p] += block->phaseCalls[p];
+      }
+      for (int c = 0; c < STATS_NUM_COUNTERS; c++) {
+        total.counters[c] += block->counters[c];
+      }
+    }
+  }
+
+  // ru_maxrss em KiB no Linux
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+
+#ifdef DCEL_STATS
+  const bool enabled = true;
+#else
+  const bool enabled = false;
+#endif
+
+  out << "{\"enabled\": " << (enabled ? "true" : "false") << ", \"threads\": " << threads << ",\n \"phases\": {";
+  for (int p = 0; p < STATS_NUM_PHASES; p++) {
+    out << (p ? ", " : "") << "\"" << PHASE_NAMES[p] << "\": {\"seconds\": " << total.phaseNanos[p] / 1e9
+        << ", \"calls\": " << total.phaseCalls[p] << "}";
+  }
+  out << "},\n \"counters\": {";
+  for (int c = 0; c < STATS_NUM_COUNTERS; c++) {
+    out << (c ? ", " : "") << "\"" << COUNTER_NAMES[c] << "\": " << total.counters[c];
+  }
+  uint64_t evaluations = total.counters[STATS_PREDICATES];
+  double fallbackRate = evaluations ? static_cast<double>(total.counters[STATS_PREDICATE_FALLBACKS]) / evaluations : 0;
+  out << "},\n \"predicate_fallback_rate\": " << fallbackRate;
+  out << ",\n \"peak_rss_kb\": " << usage.ru_maxrss << "}" << endl;
+}
@@ -0,0 +1,100 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+using namespace std;
+
+// Instrumentação das fases (tempo em relógio monotônico + número de chamadas)
+// e contadores de operações dos caminhos críticos. Só existe quando o
+// programa é compilado com -DDCEL_STATS (make STATS=1, o padrão); sem a
+// flag, as macros abaixo não geram código nenhum.
+//
+// Cada thread acumula num bloco próprio (sem atômicos nem contenção); os
+// blocos ficam registrados até o fim do programa e são somados no relatório.
+
+enum StatsPhase {
+  STATS_PARSE,
+  STATS_VALIDATE_EDGES,
+  STATS_IS_OVERLAPPING,
+  STATS_FACE_ATTRIBUTES,
+  STATS_CHECK_INSIDE,
+  STATS_HOLES,
+  STATS_BUILD,
+  STATS_OVERLAY,
+  STATS_OUTPUT,
+  STATS_NUM_PHASES
+};
+
+enum StatsCounter {
+  STATS_SEGMENT_TESTS,       // pares de segmentos testados (varredura e doSegmentsIntersect)
+  STATS_POLYGON_TESTS,       // isPointInsidePolygon
+  STATS_BORDER_TESTS,        // isPointOnPolygonBorder
+  STATS_GRID_CANDIDATES,     // vértices devolvidos pela grade em checkInside
+  STATS_MAP_LOOKUPS,         // consultas/inserções na tabela de arestas (EdgeTable)
+  STATS_PREDICATES,          // avaliações de orientação (orient2d e testes de aresta em lote)
+  STATS_PREDICATE_FALLBACKS, // avaliações que o filtro em double não decidiu (cálculo exato)
+  STATS_NUM_COUNTERS
+};
+
+struct StatsBlock {
+  uint64_t phaseNanos[STATS_NUM_PHASES] = {};
+  uint64_t phaseCalls[STATS_NUM_PHASES] = {};
+  uint64_t counters[STATS_NUM_COUNTERS] = {};
+};
+
+/**
+ * Bloco da thread corrente (criado e registrado no primeiro uso)
+ */
+StatsBlock &statsLocal();
+
+/**
+ * Escreve o relatório em JSON: fases, contadores somados entre as threads e pico de RSS
+ * @param out Destino (o programa usa stderr)
+ */
+void writeStatsReport(ostream &out);
+
+// Mede o escopo em que foi declarado e soma o tempo na fase
+class StatsTimer {
+public:
+  explicit StatsTimer(StatsPhase phase) : phase(phase), start(chrono::steady_clock::now()) {}
+  ~StatsTimer() {
+    StatsBlock &block = statsLocal();
+    block.phaseNanos[phase] +=
+        chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    block.phaseCalls[phase]++;
+  }
+
+  StatsTimer(const StatsTimer &) = delete;
+  StatsTimer &operator=(const StatsTimer &) = delete;
+
+private:
+  StatsPhase phase;
+  chrono::steady_clock::time_point start;
+};
+
+#ifdef DCEL_STATS
+#define STATS_CONCAT_(a, b) a##b
+#define STATS_CONCAT(a, b) STATS_CONCAT_(a, b)
+#define STATS_TIMER(phase) StatsTimer STATS_CONCAT(statsTimer, __LINE__)(phase)
+#define STATS_ADD(counter, n) (statsLocal().counters[counter] += (n))
+#else
+#define STATS_TIMER(phase) ((void)0)
+#define STATS_ADD(counter, n) ((void)0)
+#endif
+
+#define STATS_COUNT(counter) STATS_ADD(counter, 1)
+
+#endif // STATS_HPP
@@ -0,0 +1,270 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "stream_dcel.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "external_sort.hpp"
+
+using namespace std;
+
+static const uint32_t STREAM_NIL = 0xFFFFFFFFu;
+
+// Semi-aresta agrupada pela aresta não direcionada (min,max)
+struct EdgeRecord {
+  uint64_t key;      // (min << 32) | max
+  uint32_t backward; // 1 se a origem é o maior vértice
+  uint32_t face;
+  uint32_t halfEdge;
+};
+
+struct EdgeRecordLess {
+  bool operator()(const EdgeRecord& a, const EdgeRecord& b) const {
+    if (a.key != b.key) return a.key < b.key;
+    if (a.backward != b.backward) return a.backward < b.backward;
+    if (a.face != b.face) return a.face < b.face;
+    return a.halfEdge < b.halfEdge;
+  }
+};
+
+// Par (vértice, semi-aresta com origem nele) ou (semi-aresta, gêmea)
+struct IndexPair {
+  uint32_t first, second;
+};
+
+struct IndexPairLess {
+  bool operator()(const IndexPair& a, const IndexPair& b) const {
+    return a.first != b.first ? a.first < b.first : a.second < b.second;
+  }
+};
+
+using EdgeSorter = ExternalSorter<EdgeRecord, EdgeRecordLess>;
+using PairSorter = ExternalSorter<IndexPair, IndexPairLess>;
+
+// ======================================================================================================================= //
+
+// Agrupa os registros por aresta não direcionada, aplica as regras de ValidateEdges
+// e gera os pares de gêmeas; devolve 1, -1 (aberta) ou -2 (não subdivisão planar)
+static int matchTwins(EdgeSorter& edges, PairSorter& twins) {
+  bool open = false;
+  EdgeRecord rec;
+  bool has = edges.next(rec);
+
+  while (has) {
+    uint64_t key = rec.key;
+    size_t forward = 0, backward = 0;
+    uint32_t forwardEdge = STREAM_NIL, backwardEdge = STREAM_NIL;
+    bool repeatedInFace = false;
+    EdgeRecord prev = rec;
+    bool first = true;
+
+    for (; has && rec.key == key; has = edges.next(rec)) {
+      // Mesma aresta direcionada duas vezes na mesma face
+      if (!first && rec.backward == prev.backward && rec.face == prev.face) {
+        repeatedInFace = true;
+      }
+      if (rec.backward) {
+        backward++;
+        backwardEdge = rec.halfEdge;
+      } else {
+        forward++;
+        forwardEdge = rec.halfEdge;
+      }
+      prev = rec;
+      first = false;
+    }
+
+    bool selfLoop = (key >> 32) == (key & 0xFFFFFFFFu);
+    if (selfLoop) {
+      // Laço (v,v) é a própria inversa: só é válido se aparecer uma única vez
+      if (forward != 1) return -2;
+      continue;
+    }
+    if (repeatedInFace) return -2;
+    if (forward == 0 || backward == 0) {
+      open = true;
+      continue;
+    }
+    if (forward + backward != 2) return -2;
+
+    twins.push({forwardEdge, backwardEdge});
+    twins.push({backwardEdge, forwardEdge});
+  }
+  return open ? -1 : 1;
+}
+
+// ======================================================================================================================= //
+
+bool streamDCEL(InputScanner& in, OutputWriter& out, const StreamOptions& options, string& errorMessage) {
+  // Três ordenações externas dividem o orçamento; as duas primeiras enchem juntas
+  size_t share = options.memoryBudget / 3;
+  EdgeSorter edges(share, options.tmpDir);
+  PairSorter vertexEdges(share, options.tmpDir);
+
+  SpillFile vertexFile(options.tmpDir);
+  SpillFile faceSizeFile(options.tmpDir);
+  SpillFile faceIndexFile(options.tmpDir);
+
+  // 1. Leitura: vértices e faces vão para disco, cada semi-aresta gera seus registros
+  int n = 0, f = 0;
+  in.readInt(n);
+  in.readInt(f);
+  n = max(n, 0);
+  f = max(f, 0);
+
+  for (int i = 0; i < n; ++i) {
+    int xy[2];
+    in.readInt(xy[0]);
+    in.readInt(xy[1]);
+    vertexFile.write(xy, sizeof(xy));
+  }
+
+  uint64_t totalHalfEdges = 0;
+  vector<uint32_t> faceVerts;
+  // Componentes conexos: union-find dos vértices ao longo das arestas das faces
+  // (4 bytes por vértice) e um bit por vértice usado em alguma face
+  vector<uint32_t> parent(n);
+  for (int v = 0; v < n; ++v) parent[v] = v;
+  auto root = [&](uint32_t v) {
+    while (parent[v] != v) v = parent[v] = parent[parent[v]];
+    return v;
+  };
+  vector<bool> used(n, false);
+  for (int i = 0; i < f; ++i) {
+    faceVerts.clear();
+    readFaceLine(in, [&](int v) {
+      if (v < 0 || v >= n) {
+        throw runtime_error("índice de vértice fora do intervalo na face " + to_string(i + 1));
+      }
+      faceVerts.push_back(static_cast<uint32_t>(v));
+      used[v] = true;
+    });
+
+    uint32_t size = faceVerts.size();
+    if (totalHalfEdges + size >= STREAM_NIL) {
+      throw runtime_error("malha grande demais para índices de 32 bits");
+    }
+    uint32_t base = static_cast<uint32_t>(totalHalfEdges);
+    faceSizeFile.put(size);
+    faceIndexFile.write(faceVerts.data(), size * sizeof(uint32_t));
+
+    for (uint32_t k = 0; k < size; k++) {
+      uint64_t v1 = faceVerts[k];
+      uint64_t v2 = faceVerts[(k + 1) % size];
+      uint64_t key = (min(v1, v2) << 32) | max(v1, v2);
+      uint32_t r1 = root(faceVerts[k]), r2 = root(faceVerts[(k + 1) % size]);
+      if (r1 != r2) parent[max(r1, r2)] = min(r1, r2);
+      edges.push({key, v1 > v2 ? 1u : 0u, static_cast<uint32_t>(i), base + k});
+      vertexEdges.push({faceVerts[k], base + k});
+    }
+    totalHalfEdges += size;
+  }
+  vector<uint32_t>().swap(faceVerts);
+
+  // 2. Validação topológica e pareamento das gêmeas
+  PairSorter twins(share, options.tmpDir);
+  edges.finish();
+  int status = matchTwins(edges, twins);
+  if (status == -1) {
+    errorMessage = "aberta";
+    return false;
+  }
+  if (status == -2) {
+    errorMessage = "não subdivisão planar";
+    return false;
+  }
+
+  // Com mais de um componente conexo, um pode ser buraco de outro, e achar a
+  // face que o contém exige a geometria inteira: a malha é recusada em vez de
+  // impressa com cada ciclo externo como uma face, diferente da construção em
+  // memória. Componentes que só se tocam num vértice (gravata) são um só
+  uint64_t components = 0;
+  for (int v = 0; v < n; ++v) {
+    if (used[v] && parent[v] == static_cast<uint32_t>(v)) components++;
+  }
+  vector<bool>().swap(used);
+  vector<uint32_t>().swap(parent);
+  if (components > 1) {
+    throw runtime_error("malha com mais de um componente conexo (possíveis buracos)");
+  }
+  twins.finish();
+  vertexEdges.finish();
+
+  // 3. Saída, seção por seção
+  out.putUInt(static_cast<uint64_t>(n));
+  out.put(' ');
+  out.putUInt(totalHalfEdges / 2);
+  out.put(' ');
+  out.putUInt(static_cast<uint64_t>(f));
+  out.put('\n');
+
+  // Vértices: a primeira semi-aresta (em ordem) com origem no vértice
+  vertexFile.rewind();
+  IndexPair ve;
+  bool hasVe = vertexEdges.next(ve);
+  for (uint32_t v = 0; v < static_cast<uint32_t>(n); v++) {
+    int xy[2];
+    vertexFile.get(xy);
+    uint64_t edge = 0;
+    if (hasVe && ve.first == v) {
+      edge = uint64_t(ve.second) + 1;
+      while (hasVe && ve.first == v) hasVe = vertexEdges.next(ve);
+    }
+    out.putInt(xy[0]);
+    out.put(' ');
+    out.putInt(xy[1]);
+    out.put(' ');
+    out.putUInt(edge);
+    out.put('\n');
+  }
+  vertexFile.release();
+
+  // Faces: primeira semi-aresta do bloco de cada face
+  faceSizeFile.rewind();
+  uint64_t base = 0;
+  for (int i = 0; i < f; i++) {
+    uint32_t size = 0;
+    faceSizeFile.get(size);
+    out.putUInt(size > 0 ? base + 1 : 0);
+    out.put('\n');
+    base += size;
+  }
+
+  // Semi-arestas: origem/face/próxima/anterior vêm do bloco da face, a gêmea da ordenação
+  faceSizeFile.rewind();
+  faceIndexFile.rewind();
+  IndexPair tw;
+  bool hasTwin = twins.next(tw);
+  base = 0;
+  for (int i = 0; i < f; i++) {
+    uint32_t size = 0;
+    faceSizeFile.get(size);
+    for (uint32_t k = 0; k < size; k++) {
+      uint64_t h = base + k;
+      uint32_t origin = 0;
+      faceIndexFile.get(origin);
+
+      uint64_t twin = 0;
+      if (hasTwin && tw.first == h) {
+        twin = uint64_t(tw.second) + 1;
+        hasTwin = twins.next(tw);
+      }
+
+      writeHalfEdgeLine(out, {uint64_t(origin) + 1, twin, uint64_t(i) + 1,
+                              base + (k + 1) % size + 1, base + (k + size - 1) % size + 1});
+    }
+    base += size;
+  }
+  return true;
+}
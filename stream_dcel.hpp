@@ -0,0 +1,52 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef STREAM_DCEL_HPP
+#define STREAM_DCEL_HPP
+
+#include <cstddef>
+#include <string>
+
+#include "mesh_io.hpp"
+#include "output_writer.hpp"
+
+using namespace std;
+
+// Parâmetros da construção fora de memória
+struct StreamOptions {
+  size_t memoryBudget = size_t(256) << 20; // bytes para os buffers de ordenação
+  string tmpDir = "/tmp";                  // onde ficam os arquivos temporários
+};
+
+/**
+ * Constrói e imprime a DCEL sem carregar a malha em memória
+ *
+ * A entrada é lida uma vez; vértices e faces vão para arquivos temporários e
+ * cada semi-aresta gera registros que são ordenados externamente (runs em
+ * disco + intercalação) para: validar a topologia e parear as gêmeas (por
+ * aresta não direcionada), achar a semi-aresta incidente de cada vértice (por
+ * vértice) e reordenar as gêmeas pela numeração das semi-arestas. A saída é
+ * então escrita seção por seção, idêntica à de DCEL::printDCELOutput.
+ * Só as verificações topológicas de checkMesh são feitas (aberta e não
+ * subdivisão planar); as geométricas exigem a malha inteira em memória.
+ * Pelo mesmo motivo não há atribuição de buracos: uma malha com mais de um
+ * componente conexo (union-find dos vértices pelas arestas) é recusada.
+ *
+ * @param in Leitor posicionado no início da malha
+ * @param out Destino da saída
+ * @param options Orçamento de memória e diretório temporário
+ * @param errorMessage Mensagem de erro caso a malha seja inválida
+ * @return true se a malha é válida e a DCEL foi escrita
+ * @throws runtime_error em falha de E/S, índice de vértice fora do intervalo ou
+ *         malha com mais de um componente conexo
+ */
+bool streamDCEL(InputScanner& in, OutputWriter& out, const StreamOptions& options, string& errorMessage);
+
+#endif // STREAM_DCEL_HPP
@@ -0,0 +1,158 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "sweep.hpp"
+#include "dcel.hpp"
+#include "edge_table.hpp"
+#include "stats.hpp"
+
+using namespace std;
+
+// ======================================================================================================================= //
+
+// Ordem vertical entre segmentos que coexistem na linha de varredura
+bool segmentBelow(const SweepSegment &a, const SweepSegment &b, int ia, int ib) {
+  if (ia == ib) return false;
+
+  // Mesma extremidade esquerda: decide pela inclinação
+  if (a.p == b.p) {
+    int o = orientation(a.p, a.q, b.q);
+    if (o != 0) return o == 2; // b.q à esquerda de a => b acima de a
+    return ia < ib;
+  }
+
+  // Compara o segmento que começa depois com a reta do que começou antes
+  if (a.p < b.p) {
+    int o = orientation(a.p, a.q, b.p);
+    if (o == 0) o = orientation(a.p, a.q, b.q);
+    if (o != 0) return o == 2;
+  } else {
+    int o = orientation(b.p, b.q, a.p);
+    if (o == 0) o = orientation(b.p, b.q, a.q);
+    if (o != 0) return o == 1;
+  }
+  return ia < ib;
+}
+
+// ======================================================================================================================= //
+
+// Interseção entre arestas, tolerando apenas o vértice compartilhado por arestas vizinhas
+bool segmentsConflict(const SweepSegment &a, const SweepSegment &b) {
+  STATS_COUNT(STATS_SEGMENT_TESTS);
+  // Mesma aresta (não deve ocorrer após a deduplicação)
+  if ((a.u == b.u && a.v == b.v) || (a.u == b.v && a.v == b.u)) return false;
+
+  // Compartilham um vértice: só há conflito se forem colineares e se sobrepuserem
+  int shared = -1;
+  pair<int, int> ra, rb; // extremidades não compartilhadas
+  if (a.u == b.u) { shared = a.u; ra = a.q; rb = b.q; }
+  else if (a.u == b.v) { shared = a.u; ra = a.q; rb = b.p; }
+  else if (a.v == b.u) { shared = a.v; ra = a.p; rb = b.q; }
+  else if (a.v == b.v) { shared = a.v; ra = a.p; rb = b.p; }
+
+  if (shared != -1) {
+    const pair<int, int> &c = (shared == a.u) ? a.p : a.q;
+    return orientation(c, ra, rb) == 0 && (onSegment(c, ra, rb) || onSegment(c, rb, ra));
+  }
+
+  return doSegmentsIntersect(a.p, a.q, b.p, b.q);
+}
+
+// ======================================================================================================================= //
+
+// Uma entrada por aresta não direcionada, na ordem em que aparece pela primeira vez
+vector<SweepSegment> collectSegments(const vector<pair<int, int>> &verticesCoords, const FaceList &faces) {
+  EdgeTable<size_t> seen(faces.totalIndices() / 2 + 1); // (min,max) -> índice do segmento
+  vector<SweepSegment> segments;
+  segments.reserve(faces.totalIndices() / 2);
+
+  for (size_t f = 0; f < faces.size(); ++f) {
+    const auto &face = faces[f];
+    size_t n = face.size();
+
+    for (size_t i = 0; i < n; ++i) {
+      int v1 = face[i];
+      int v2 = face[(i + 1) % n];
+      if (v1 == v2) continue;
+
+      bool inserted;
+      size_t &index = seen.findOrInsert(EdgeTable<size_t>::key(min(v1, v2), max(v1, v2)), inserted);
+      if (!inserted) {
+        if (segments[index].twinFace == -1) segments[index].twinFace = f;
+        continue;
+      }
+      index = segments.size();
+
+      SweepSegment s;
+      s.from = v1;
+      s.to = v2;
+      s.face = f;
+      s.twinFace = -1;
+      if (verticesCoords[v1] < verticesCoords[v2]) {
+        s.p = verticesCoords[v1]; s.u = v1;
+        s.q = verticesCoords[v2]; s.v = v2;
+      } else {
+        s.p = verticesCoords[v2]; s.u = v2;
+        s.q = verticesCoords[v1]; s.v = v1;
+      }
+      segments.push_back(s);
+    }
+  }
+  return segments;
+}
+
+// ======================================================================================================================= //
+
+// Varredura de Shamos–Hoey: só segmentos vizinhos na estrutura de status são testados
+bool findIntersectingSegments(const vector<SweepSegment> &segments, EdgeIntersection &hit) {
+  // Eventos: (ponto, tipo, segmento); no mesmo ponto, remoções (0) antes de inserções (1)
+  struct Event {
+    pair<int, int> pt;
+    int type;
+    int seg;
+    bool operator<(const Event &o) const {
+      if (pt != o.pt) return pt < o.pt;
+      return type < o.type;
+    }
+  };
+
+  vector<Event> events;
+  events.reserve(2 * segments.size());
+  for (size_t i = 0; i < segments.size(); ++i) {
+    events.push_back({segments[i].p, 1, static_cast<int>(i)});
+    events.push_back({segments[i].q, 0, static_cast<int>(i)});
+  }
+  sort(events.begin(), events.end());
+
+  auto below = [&segments](int a, int b) { return segmentBelow(segments[a], segments[b], a, b); };
+  set<int, decltype(below)> status(below);
+  vector<set<int, decltype(below)>::iterator> where(segments.size());
+
+  auto report = [&](int a, int b) {
+    if (!segmentsConflict(segments[a], segments[b])) return false;
+    hit.first = segments[min(a, b)];
+    hit.second = segments[max(a, b)];
+    return true;
+  };
+
+  for (const auto &e : events) {
+    if (e.type == 1) {
+      auto it = status.insert(e.seg).first;
+      where[e.seg] = it;
+      if (it != status.begin() && report(*prev(it), e.seg)) return true;
+      if (next(it) != status.end() && report(e.seg, *next(it))) return true;
+    } else {
+      auto it = where[e.seg];
+      if (it != status.begin() && next(it) != status.end() && report(*prev(it), *next(it))) return true;
+      status.erase(it);
+    }
+  }
+  return false;
+}
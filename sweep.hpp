@@ -0,0 +1,72 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+
+#include <utility>
+#include <vector>
+
+#include "mesh.hpp"
+
+using namespace std;
+
+// ---------- Segmento da varredura ----------
+// Aresta não direcionada com as extremidades em ordem lexicográfica (p < q)
+struct SweepSegment {
+  pair<int, int> p, q;   // Extremidades esquerda e direita
+  int u, v;              // Índices (base 0) dos vértices em p e q
+  int from, to;          // Vértices no sentido em que a aresta aparece na face
+  int face, twinFace;    // Faces (base 0) que contêm a aresta e sua inversa (-1 se não houver)
+};
+
+// Interseção encontrada pela varredura, no formato usado pelas mensagens de erro
+struct EdgeIntersection {
+  SweepSegment first, second;
+};
+
+/**
+ * Ordem vertical entre dois segmentos ativos na mesma posição da linha de varredura
+ * Não depende da abscissa: compara o segmento que começa depois com a reta do outro
+ * @param a Primeiro segmento
+ * @param b Segundo segmento
+ * @param ia Índice de a, usado para desempate
+ * @param ib Índice de b, usado para desempate
+ * @return true se a está abaixo de b
+ */
+bool segmentBelow(const SweepSegment &a, const SweepSegment &b, int ia, int ib);
+
+/**
+ * Verifica se dois segmentos da malha se intersectam de forma inválida
+ * Segmentos que compartilham um vértice só conflitam se se sobrepõem colinearmente
+ * @param a Primeiro segmento
+ * @param b Segundo segmento
+ * @return true se houver interseção inválida
+ */
+bool segmentsConflict(const SweepSegment &a, const SweepSegment &b);
+
+/**
+ * Extrai as arestas não direcionadas da malha, uma por par de semi-arestas
+ * @param verticesCoords Vetor de coordenadas dos vértices
+ * @param faces Faces da malha (CSR)
+ * @return Segmentos com extremidades ordenadas
+ */
+vector<SweepSegment> collectSegments(const vector<pair<int, int>> &verticesCoords, const FaceList &faces);
+
+/**
+ * Procura um par de arestas que se intersectam usando a varredura de Shamos–Hoey,
+ * em O(n log n) sobre todas as arestas da malha
+ * @param segments Segmentos da malha (ver collectSegments)
+ * @param hit Par de arestas encontrado, se houver
+ * @return true se houver interseção
+ */
+bool findIntersectingSegments(const vector<SweepSegment> &segments, EdgeIntersection &hit);
+
+#endif // SWEEP_HPP
@@ -0,0 +1,153 @@
+/***********************************************************************
+ *
+ * Teste diferencial dos predicados (predicates.hpp):
+ *  - orient2d contra o determinante em __int128, com coordenadas de até
+ *    ±(2^31 - 1) e pontos quase colineares (o filtro em double não decide);
+ *  - orient2dDouble com coordenadas k·2^-20 contra orient2d nos inteiros k;
+ *  - os testes em lote contra isPointOnPolygonBorder e isPointInsidePolygon,
+ *    em cada nível suportado pela CPU (escalar, SSE4.1, AVX2).
+ * Os resultados têm de ser idênticos.
+ *
+ * Uso: ./simd_diff [casos] [semente]
+ *
+ * Polígonos e pontos aleatórios em grades pequenas (muitos casos de
+ * colinearidade, pontos na borda e arestas horizontais), médias e com a faixa
+ * inteira de int; os pontos incluem vértices, pontos sobre as arestas e
+ * vizinhos imediatos delas.
+ *
+ ************************************************************************/
+#include "../dcel.hpp"
+#include "../predicates.hpp"
+
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace std;
+
+static int referenceOrient(long long ax, long long ay, long long bx, long long by, long long cx, long long cy) {
+  __int128 det = static_cast<__int128>(bx - ax) * (cy - ay) - static_cast<__int128>(by - ay) * (cx - ax);
+  return (det > 0) - (det < 0);
+}
+
+// Ponto c sobre a reta ab (ou arredondado para perto dela), às vezes deslocado de 1: colinear ou quase.
+// Todas as coordenadas ficam dentro de ±(2^31 - 1).
+static void nearCollinear(mt19937 &rng, long long &ax, long long &ay, long long &bx, long long &by, long long &cx,
+                          long long &cy) {
+  uniform_int_distribution<int> coord(INT_MIN / 2, INT_MAX / 2);
+  ax = coord(rng), ay = coord(rng);
+  if (rng() % 2) {
+    // b e c em múltiplos inteiros de um passo pequeno: colineares exatos antes do deslocamento
+    uniform_int_distribution<int> step(-1000, 1000), times(-(1 << 20), 1 << 20);
+    long long dx = step(rng), dy = step(rng);
+    long long m = times(rng), k = times(rng);
+    bx = ax + dx * m, by = ay + dy * m;
+    cx = ax + dx * k, cy = ay + dy * k;
+  } else {
+    uniform_real_distribution<double> t(-0.5, 1.5);
+    bx = coord(rng), by = coord(rng);
+    double k = t(rng);
+    cx = llround(ax + k * (bx - ax));
+    cy = llround(ay + k * (by - ay));
+  }
+  if (rng() % 2) {
+    cx += static_cast<int>(rng() % 3) - 1;
+    cy += static_cast<int>(rng() % 3) - 1;
+  }
+}
+
+// orient2d e orient2dDouble contra a referência
+static long checkOrientation(mt19937 &rng, long cases) {
+  long failures = 0, collinear = 0;
+  const double scale = ldexp(1.0, -20);
+  for (long c = 0; c < cases; c++) {
+    long long ax, ay, bx, by, cx, cy;
+    nearCollinear(rng, ax, ay, bx, by, cx, cy);
+    int expected = referenceOrient(ax, ay, bx, by, cx, cy);
+    int got = orient2d(ax, ay, bx, by, cx, cy);
+    int gotDouble = orient2dDouble(ax * scale, ay * scale, bx * scale, by * scale, cx * scale, cy * scale);
+    collinear += expected == 0;
+    if (got != expected || gotDouble != expected) {
+      if (failures < 10) {
+        fprintf(stderr, "orient2d (%lld, %lld) (%lld, %lld) (%lld, %lld): esperado %d, obtido %d/%d\n", ax, ay, bx,
+                by, cx, cy, expected, got, gotDouble);
+      }
+      failures++;
+    }
+  }
+  printf("orient  %ld casos (colineares %ld)\n", cases, collinear);
+  return failures;
+}
+
+int main(int argc, char *argv[]) {
+  long cases = argc > 1 ? atol(argv[1]) : 200000;
+  unsigned long seed = argc > 2 ? strtoul(argv[2], nullptr, 10) : 12345;
+
+  mt19937 rng(seed);
+  long failures = checkOrientation(rng, cases);
+  PredicateLevel best = detectPredicateLevel();
+
+  for (int level = PREDICATES_SCALAR; level <= best; level++) {
+    setPredicateLevel(static_cast<PredicateLevel>(level));
+    long counts[3] = {};
+
+    for (long c = 0; c < cases; c++) {
+      // Coordenadas pequenas em metade dos casos; até 2^14 e até 2^31 - 1 no resto
+      int range = (c % 4 == 0) ? INT_MAX : (c % 4 == 1) ? (1 << 14) : 8;
+      uniform_int_distribution<int> coord(-range, range);
+      uniform_int_distribution<int> sizes(1, 40);
+
+      vector<pair<int, int>> polygon(sizes(rng));
+      for (auto &p : polygon) p = {coord(rng), coord(rng)};
+
+      pair<int, int> pt;
+      int kind = (c / 4) % 4;
+      if (kind == 0) {
+        pt = {coord(rng), coord(rng)};
+      } else if (kind == 1) {
+        pt = polygon[rng() % polygon.size()];
+      } else {
+        // Ponto médio inteiro de uma aresta com deltas pares: sobre a borda (kind 2) ou a um passo dela (kind 3)
+        size_t i = rng() % polygon.size();
+        auto a = polygon[i], b = polygon[(i + 1) % polygon.size()];
+        if ((static_cast<long long>(b.first) - a.first) % 2) b.first += (b.first > 0) ? -1 : 1;
+        if ((static_cast<long long>(b.second) - a.second) % 2) b.second += (b.second > 0) ? -1 : 1;
+        polygon[(i + 1) % polygon.size()] = b;
+        pt = {static_cast<int>((static_cast<long long>(a.first) + b.first) / 2),
+              static_cast<int>((static_cast<long long>(a.second) + b.second) / 2)};
+        if (kind == 3) pt.first += (pt.first > 0) ? -1 : 1;
+      }
+
+      PolygonSoA soa;
+      soa.assign(polygon);
+      bool border = isPointOnPolygonBorder(pt, polygon);
+      bool inside = isPointInsidePolygon(pt, polygon);
+      PointClass expected = border ? POINT_ON_BORDER : (inside ? POINT_INSIDE : POINT_OUTSIDE);
+
+      PointClass got = classifyPoint(pt, soa);
+      bool gotBorder = pointOnBorder(pt, soa);
+      bool gotInside = pointInside(pt, soa);
+      counts[expected]++;
+
+      if (got != expected || gotBorder != border || gotInside != inside) {
+        if (failures < 10) {
+          fprintf(stderr, "[%s] caso %ld: ponto (%d, %d), %zu vértices: esperado %d/%d/%d, obtido %d/%d/%d\n",
+                  predicateLevelName(predicateLevel()), c, pt.first, pt.second, polygon.size(), expected, border,
+                  inside, got, gotBorder, gotInside);
+        }
+        failures++;
+      }
+    }
+    printf("%-7s %ld casos (fora %ld, dentro %ld, borda %ld)\n", predicateLevelName(predicateLevel()), cases,
+           counts[POINT_OUTSIDE], counts[POINT_INSIDE], counts[POINT_ON_BORDER]);
+  }
+
+  if (failures) {
+    printf("%ld divergências\n", failures);
+    return 1;
+  }
+  printf("ok\n");
+  return 0;
+}
@@ -0,0 +1,275 @@
+/***********************************************************************
+ *
+ * Teste diferencial das consultas espaciais (spatial_index.hpp) contra
+ * varreduras lineares:
+ *  - EdgeBVH::window contra o teste exato de cada aresta de DCEL::halfEdges;
+ *  - EdgeBVH::windowFaces contra as faces dos dois lados dessas arestas ou,
+ *    sem nenhuma, contra a menor face anti-horária que contém um canto;
+ *  - EdgeBVH::nearest e VertexKdTree::nearest contra a ordenação de todas
+ *    as arestas e de todos os vértices por distância e índice;
+ *  - VertexKdTree::window contra o teste de cada vértice.
+ * As estruturas construídas a partir da CompactDCEL têm de dar o mesmo.
+ *
+ * Uso: ./spatial_diff [malhas] [semente]
+ *
+ * As malhas são grades pequenas com espaçamento de 1 a 4, algumas células
+ * divididas por uma diagonal e, nas grades de espaçamento 3 ou mais, alguns
+ * quadrados aninhados em células (buracos). Coordenadas inteiras pequenas
+ * dão muitos empates de distância; k vai de 0 até além do número de
+ * arestas ou de vértices, e as janelas incluem pontos, segmentos, janelas
+ * dentro de uma face sem tocar aresta e janelas fora da malha.
+ *
+ ************************************************************************/
+#include "../dcel.hpp"
+#include "../dcel_soa.hpp"
+#include "../point_location.hpp"
+#include "../predicates.hpp"
+#include "../spatial_index.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace std;
+
+// Grade de nx x ny células de lado s a partir de (ox, oy), deslocada de sh por
+// linha; algumas células viram dois triângulos e, sem deslocamento e com s >= 3,
+// algumas recebem um quadrado aninhado
+static void randomGrid(mt19937 &rng, vector<pair<int, int>> &vertices, vector<vector<int>> &faces) {
+  uniform_int_distribution<int> cells(1, 6), spacing(1, 4), origin(-20, 20), pick(0, 5);
+  int nx = cells(rng), ny = cells(rng), s = spacing(rng), ox = origin(rng), oy = origin(rng);
+  int sh = pick(rng) == 0 ? 1 : 0;
+  vertices.clear();
+  faces.clear();
+  for (int j = 0; j <= ny; j++) {
+    for (int i = 0; i <= nx; i++) vertices.push_back({ox + i * s + j * sh, oy + j * s});
+  }
+  auto id = [&](int i, int j) { return j * (nx + 1) + i; };
+
+  for (int j = 0; j < ny; j++) {
+    for (int i = 0; i < nx; i++) {
+      int a = id(i, j), b = id(i + 1, j), c = id(i + 1, j + 1), d = id(i, j + 1);
+      int kind = pick(rng);
+      if (kind == 0) {
+        faces.push_back({a, b, c});
+        faces.push_back({a, c, d});
+      } else if (kind == 1) {
+        faces.push_back({a, b, d});
+        faces.push_back({b, c, d});
+      } else {
+        faces.push_back({a, b, c, d});
+        if (kind == 2 && sh == 0 && s >= 3) {
+          int x = vertices[a].first, y = vertices[a].second, n = vertices.size();
+          vertices.push_back({x + 1, y + 1});
+          vertices.push_back({x + 2, y + 1});
+          vertices.push_back({x + 2, y + 2});
+          vertices.push_back({x + 1, y + 2});
+          faces.push_back({n, n + 1, n + 2, n + 3});
+          faces.push_back({n + 3, n + 2, n + 1, n});
+        }
+      }
+    }
+  }
+
+  // Ciclo externo da grade, em sentido horário
+  vector<int> outer;
+  for (int i = 0; i <= nx; i++) outer.push_back(id(i, 0));
+  for (int j = 1; j <= ny; j++) outer.push_back(id(nx, j));
+  for (int i = nx - 1; i >= 0; i--) outer.push_back(id(i, ny));
+  for (int j = ny - 1; j > 0; j--) outer.push_back(id(0, j));
+  reverse(outer.begin(), outer.end());
+  faces.push_back(outer);
+}
+
+// ======================================================================================================================= //
+
+// Teste exato de aresta contra janela: os retângulos se tocam e os quatro cantos
+// não ficam estritamente do mesmo lado da reta
+static bool touches(const HalfEdge *he, const BoundingBox &box) {
+  long long ax = he->origin->x, ay = he->origin->y, bx = he->next->origin->x, by = he->next->origin->y;
+  if (max(ax, bx) < box.minX || min(ax, bx) > box.maxX || max(ay, by) < box.minY || min(ay, by) > box.maxY) {
+    return false;
+  }
+  int s[4] = {orient2d(ax, ay, bx, by, box.minX, box.minY), orient2d(ax, ay, bx, by, box.maxX, box.minY),
+              orient2d(ax, ay, bx, by, box.maxX, box.maxY), orient2d(ax, ay, bx, by, box.minX, box.maxY)};
+  bool allLeft = true, allRight = true;
+  for (int o : s) {
+    allLeft = allLeft && o > 0;
+    allRight = allRight && o < 0;
+  }
+  return !allLeft && !allRight;
+}
+
+// Menor face anti-horária cujo ciclo externo contém estritamente o ponto (que não
+// fica em nenhuma aresta); -1 na região ilimitada
+static int containingFace(const DCEL &dcel, long long px, long long py) {
+  int best = -1;
+  long long bestArea = LLONG_MAX;
+  for (const Face *f : dcel.faces) {
+    long long area2 = 0;
+    bool inside = false;
+    const HalfEdge *he = f->outerComponent;
+    do {
+      long long ax = he->origin->x, ay = he->origin->y, bx = he->next->origin->x, by = he->next->origin->y;
+      area2 += ax * by - bx * ay;
+      if ((ay > py) != (by > py)) {
+        int o = orient2d(ax, ay, bx, by, px, py);
+        if (by > ay ? o > 0 : o < 0) inside = !inside;
+      }
+      he = he->next;
+    } while (he != f->outerComponent);
+    if (area2 > 0 && inside && area2 < bestArea) {
+      best = static_cast<int>(f->id);
+      bestArea = area2;
+    }
+  }
+  return best;
+}
+
+// Mesma conta de distância que spatial_index.cpp: os empates têm de coincidir bit a bit
+static double segmentDist2(double px, double py, double ax, double ay, double bx, double by) {
+  double dx = bx - ax, dy = by - ay;
+  double len2 = dx * dx + dy * dy;
+  double t = len2 > 0 ? ((px - ax) * dx + (py - ay) * dy) / len2 : 0;
+  t = min(1.0, max(0.0, t));
+  double qx = ax + t * dx - px, qy = ay + t * dy - py;
+  return qx * qx + qy * qy;
+}
+
+// Os k primeiros de todos os candidatos, por distância e depois por índice
+static void firstK(vector<Neighbor> &all, size_t k) {
+  sort(all.begin(), all.end(), [](const Neighbor &a, const Neighbor &b) {
+    return a.dist2 < b.dist2 || (a.dist2 == b.dist2 && a.index < b.index);
+  });
+  all.resize(min(k, all.size()));
+}
+
+static bool sameNeighbors(const vector<Neighbor> &a, const vector<Neighbor> &b) {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].index != b[i].index || a[i].dist2 != b[i].dist2) return false;
+  }
+  return true;
+}
+
+// ======================================================================================================================= //
+
+int main(int argc, char *argv[]) {
+  long meshes = argc > 1 ? atol(argv[1]) : 300;
+  unsigned long seed = argc > 2 ? strtoul(argv[2], nullptr, 10) : 12345;
+  const int QUERIES = 60;
+
+  mt19937 rng(seed);
+  long failures = 0, windows = 0, emptyWindows = 0, neighbors = 0, ties = 0, holes = 0;
+  auto fail = [&](const char *what, long m, int q) {
+    if (failures < 10) fprintf(stderr, "%s: malha %ld, consulta %d\n", what, m, q);
+    failures++;
+  };
+
+  vector<pair<int, int>> coords;
+  vector<vector<int>> cycles;
+  for (long m = 0; m < meshes; m++) {
+    randomGrid(rng, coords, cycles);
+    FaceList faceList(cycles);
+    DCEL dcel;
+    dcel.buildFromMesh(coords, faceList);
+    CompactDCEL compact;
+    compact.buildFromMesh(coords, faceList);
+    for (const Face *f : dcel.faces) holes += f->innerCount;
+
+    EdgeBVH bvh(dcel), compactBvh(compact);
+    VertexKdTree kd(dcel), compactKd(compact);
+    PointLocator locator(dcel);
+
+    int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+    for (const auto &c : coords) {
+      minX = min(minX, c.first), maxX = max(maxX, c.first);
+      minY = min(minY, c.second), maxY = max(maxY, c.second);
+    }
+    uniform_int_distribution<int> qx(minX - 3, maxX + 3), qy(minY - 3, maxY + 3), small(0, 2);
+    size_t numEdges = bvh.size(), numVertices = dcel.vertices.size();
+    size_t ks[] = {0, 1, 2, 3, 8, numEdges, numEdges + 5, numVertices, numVertices + 5};
+
+    for (int q = 0; q < QUERIES; q++) {
+      // Janelas: um terço com lado de 0 a 2 (pontos, segmentos, dentro de uma face)
+      long long x1 = qx(rng), y1 = qy(rng), x2 = qx(rng), y2 = qy(rng);
+      if (q % 3 == 0) x2 = x1 + small(rng), y2 = y1 + small(rng);
+      BoundingBox box{min(x1, x2), min(y1, y2), max(x1, x2), max(y1, y2)};
+
+      vector<int> expectedEdges, expectedFaces, expectedVertices, got;
+      for (const HalfEdge *he : dcel.halfEdges) {
+        if (he->twin && he->twin->id < he->id) continue;
+        if (!touches(he, box)) continue;
+        expectedEdges.push_back(static_cast<int>(he->id));
+        expectedFaces.push_back(static_cast<int>(he->incidentFace->id));
+        if (he->twin) expectedFaces.push_back(static_cast<int>(he->twin->incidentFace->id));
+      }
+      sort(expectedFaces.begin(), expectedFaces.end());
+      expectedFaces.erase(unique(expectedFaces.begin(), expectedFaces.end()), expectedFaces.end());
+      if (expectedEdges.empty()) {
+        emptyWindows++;
+        int f = containingFace(dcel, box.minX, box.minY);
+        if (f >= 0) expectedFaces.push_back(f);
+      }
+      for (const Vertex *v : dcel.vertices) {
+        if (v->x >= box.minX && v->x <= box.maxX && v->y >= box.minY && v->y <= box.maxY) {
+          expectedVertices.push_back(static_cast<int>(v->id));
+        }
+      }
+      windows++;
+
+      bvh.window(box, got);
+      if (got != expectedEdges) fail("EdgeBVH::window", m, q);
+      compactBvh.window(box, got);
+      if (got != expectedEdges) fail("EdgeBVH::window (CompactDCEL)", m, q);
+      bvh.windowFaces(box, locator, got);
+      if (got != expectedFaces) fail("EdgeBVH::windowFaces", m, q);
+      kd.window(box, got);
+      if (got != expectedVertices) fail("VertexKdTree::window", m, q);
+      compactKd.window(box, got);
+      if (got != expectedVertices) fail("VertexKdTree::window (CompactDCEL)", m, q);
+
+      // Vizinhos: todas as arestas e todos os vértices, ordenados
+      pair<int, int> pt(qx(rng), qy(rng));
+      vector<Neighbor> allEdges, allVertices;
+      for (const HalfEdge *he : dcel.halfEdges) {
+        if (he->twin && he->twin->id < he->id) continue;
+        allEdges.push_back({static_cast<int>(he->id), segmentDist2(pt.first, pt.second, he->origin->x, he->origin->y,
+                                                                   he->next->origin->x, he->next->origin->y)});
+      }
+      for (const Vertex *v : dcel.vertices) {
+        double dx = pt.first - v->x, dy = pt.second - v->y;
+        allVertices.push_back({static_cast<int>(v->id), dx * dx + dy * dy});
+      }
+
+      for (size_t k : ks) {
+        vector<Neighbor> expected = allEdges, found;
+        firstK(expected, k);
+        for (size_t i = 1; i < expected.size(); i++) ties += expected[i].dist2 == expected[i - 1].dist2;
+        bvh.nearest(pt, k, found);
+        if (!sameNeighbors(found, expected)) fail("EdgeBVH::nearest", m, q);
+        compactBvh.nearest(pt, k, found);
+        if (!sameNeighbors(found, expected)) fail("EdgeBVH::nearest (CompactDCEL)", m, q);
+
+        expected = allVertices;
+        firstK(expected, k);
+        kd.nearest(pt, k, found);
+        if (!sameNeighbors(found, expected)) fail("VertexKdTree::nearest", m, q);
+        compactKd.nearest(pt, k, found);
+        if (!sameNeighbors(found, expected)) fail("VertexKdTree::nearest (CompactDCEL)", m, q);
+        neighbors++;
+      }
+    }
+  }
+
+  printf("janelas %ld (sem aresta %ld), vizinhos %ld (empates %ld), %ld malhas (buracos %ld)\n", windows,
+         emptyWindows, neighbors, ties, meshes, holes);
+  if (failures) {
+    printf("%ld divergências\n", failures);
+    return 1;
+  }
+  printf("ok\n");
+  return 0;
+}
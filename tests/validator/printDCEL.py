@@ -85,7 +85,8 @@ if __name__ == "__main__":
             line = f.readline()
             while line.strip() == '':
                 line = f.readline()  # Pular linhas vazias
-            e = int(line)
+            # Componente externo, seguido dos componentes internos (buracos), se houver
+            e = int(line.split()[0])
             fList.append(Face(i, e))
 
         # Ler semi-arestas
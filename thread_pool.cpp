@@ -0,0 +1,163 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+// Índice do worker corrente (-1 fora do pool)
+static thread_local int currentWorker = -1;
+
+// ======================================================================================================================= //
+
+ThreadPool::ThreadPool(unsigned threads) {
+  threads = max(1u, threads);
+  for (unsigned i = 0; i < threads; i++) {
+    queues.push_back(make_unique<Queue>());
+  }
+  for (unsigned i = 0; i < threads; i++) {
+    workers.emplace_back(&ThreadPool::run, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  // Uma exceção ainda não relançada é descartada: o destrutor não lança
+  {
+    unique_lock<mutex> lock(sleepMutex);
+    allDone.wait(lock, [this] { return pending.load() == 0; });
+  }
+  {
+    lock_guard<mutex> lock(sleepMutex);
+    stopping = true;
+  }
+  wakeUp.notify_all();
+  for (auto& t : workers) {
+    t.join();
+  }
+}
+
+// ======================================================================================================================= //
+
+int ThreadPool::workerIndex() {
+  return currentWorker;
+}
+
+// ======================================================================================================================= //
+
+void ThreadPool::submit(function<void()> task) {
+  // Dentro de um worker a tarefa fica local; de fora, distribui em rodízio
+  unsigned target = currentWorker >= 0 ? static_cast<unsigned>(currentWorker)
+                                       : nextQueue.fetch_add(1) % size();
+  pending.fetch_add(1);
+  {
+    lock_guard<mutex> lock(queues[target]->m);
+    queues[target]->tasks.push_back(move(task));
+    queued.fetch_add(1);
+  }
+  {
+    // Sincroniza com workers prestes a dormir para não perder a notificação
+    lock_guard<mutex> lock(sleepMutex);
+  }
+  wakeUp.notify_one();
+}
+
+// ======================================================================================================================= //
+
+void ThreadPool::wait() {
+  {
+    unique_lock<mutex> lock(sleepMutex);
+    allDone.wait(lock, [this] { return pending.load() == 0; });
+  }
+  exception_ptr error;
+  {
+    lock_guard<mutex> lock(errorMutex);
+    swap(error, firstError);
+  }
+  if (error) rethrow_exception(error);
+}
+
+// ======================================================================================================================= //
+
+bool ThreadPool::tryPop(unsigned self, function<void()>& task) {
+  // Própria fila: pega a tarefa mais recente
+  {
+    Queue& q = *queues[self];
+    lock_guard<mutex> lock(q.m);
+    if (!q.tasks.empty()) {
+      task = move(q.tasks.back());
+      q.tasks.pop_back();
+      queued.fetch_sub(1);
+      return true;
+    }
+  }
+
+  // Roubo: pega a tarefa mais antiga de outra fila
+  for (unsigned k = 1; k < size(); k++) {
+    Queue& q = *queues[(self + k) % size()];
+    lock_guard<mutex> lock(q.m);
+    if (!q.tasks.empty()) {
+      task = move(q.tasks.front());
+      q.tasks.pop_front();
+      queued.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+// ======================================================================================================================= //
+
+void ThreadPool::run(unsigned self) {
+  currentWorker = static_cast<int>(self);
+
+  while (true) {
+    function<void()> task;
+    if (tryPop(self, task)) {
+      try {
+        task();
+      } catch (...) {
+        lock_guard<mutex> lock(errorMutex);
+        if (!firstError) firstError = current_exception();
+      }
+      if (pending.fetch_sub(1) == 1) {
+        lock_guard<mutex> lock(sleepMutex);
+        allDone.notify_all();
+      }
+      continue;
+    }
+
+    unique_lock<mutex> lock(sleepMutex);
+    if (stopping) return;
+    // Dorme até haver tarefa na fila de alguém
+    wakeUp.wait(lock, [this] { return stopping || queued.load() > 0; });
+    if (stopping) return;
+  }
+}
+
+// ======================================================================================================================= //
+
+void parallelFor(ThreadPool* pool, size_t begin, size_t end, size_t grain,
+                 const function<void(size_t, size_t)>& body) {
+  if (begin >= end) return;
+  grain = max<size_t>(1, grain);
+
+  if (!pool || end - begin <= grain) {
+    body(begin, end);
+    return;
+  }
+
+  for (size_t lo = begin; lo < end; lo += grain) {
+    size_t hi = min(end, lo + grain);
+    pool->submit([&body, lo, hi] { body(lo, hi); });
+  }
+  pool->wait();
+}
@@ -0,0 +1,106 @@
+/***********************************************************************
+ *
+ * Autor: Richard Fernando Heise Ferreira
+ * Matrícula: 201900121214
+ * Data: 03/2025
+ * Instituição: Universidade Federal do Paraná
+ * Curso: Mestrado em Segurança da Computação - PPG-Inf
+ * Motivo: Trabalho 2 da disciplina de Geometria Computacional
+ *
+ ************************************************************************/
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// ---------- Classe ThreadPool ----------
+// Pool de threads com roubo de trabalho: cada worker tem sua própria fila,
+// consome do fim dela (LIFO) e, quando vazia, rouba do início das filas dos
+// outros (FIFO). Tarefas submetidas de fora são distribuídas em rodízio.
+// Uma exceção que escapa de uma tarefa não derruba o worker: a primeira é
+// guardada e relançada por wait().
+class ThreadPool {
+public:
+  /**
+   * Cria o pool
+   * @param threads Número de workers (no mínimo 1)
+   */
+  explicit ThreadPool(unsigned threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * Enfileira uma tarefa; de dentro de um worker, vai para a fila dele
+   * @param task Tarefa a executar
+   */
+  void submit(function<void()> task);
+
+  /**
+   * Bloqueia até que todas as tarefas submetidas tenham terminado e relança a
+   * primeira exceção que escapou de uma delas desde o último wait()
+   * Não deve ser chamada de dentro de uma tarefa do próprio pool
+   */
+  void wait();
+
+  /**
+   * Número de workers do pool
+   */
+  unsigned size() const { return static_cast<unsigned>(queues.size()); }
+
+  /**
+   * Índice do worker que executa a chamada
+   * @return Índice em [0, size()) ou -1 fora do pool
+   */
+  static int workerIndex();
+
+private:
+  struct Queue {
+    mutex m;
+    deque<function<void()>> tasks;
+  };
+
+  vector<unique_ptr<Queue>> queues;
+  vector<thread> workers;
+
+  mutex sleepMutex;
+  condition_variable wakeUp;
+  condition_variable allDone;
+  atomic<size_t> pending{0}; // submetidas e ainda não concluídas
+  atomic<size_t> queued{0};  // ainda nas filas, à espera de um worker
+  atomic<unsigned> nextQueue{0};
+  bool stopping = false;
+
+  mutex errorMutex;
+  exception_ptr firstError; // primeira exceção de uma tarefa, até o próximo wait()
+
+  void run(unsigned self);
+  bool tryPop(unsigned self, function<void()>& task);
+};
+
+/**
+ * Divide [begin, end) em blocos e executa body(lo, hi) em paralelo no pool
+ * Sem pool (ou com um único bloco) executa na própria thread; como espera
+ * pelo pool, não deve ser chamada de dentro de uma tarefa dele. Uma exceção
+ * de body é relançada aqui depois que todos os blocos terminam
+ * @param pool Pool de threads (pode ser nulo)
+ * @param begin Início do intervalo
+ * @param end Fim do intervalo (exclusivo)
+ * @param grain Tamanho mínimo de cada bloco
+ * @param body Função aplicada a cada bloco
+ */
+void parallelFor(ThreadPool* pool, size_t begin, size_t end, size_t grain,
+                 const function<void(size_t, size_t)>& body);
+
+#endif // THREAD_POOL_HPP